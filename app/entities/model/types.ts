@@ -91,6 +91,8 @@ export interface ModelAnalysis {
   supportRequired: boolean;
   estimatedVolume: number; // cm³
   surfaceArea: number; // cm²
+  height?: number; // mm, 메시 분석의 Z 높이 (없으면 부피로 추정)
+  watertight?: boolean; // 열린 변/비다양체 변 없음
   fileFormat?: string;
 }
 
@@ -24,6 +24,10 @@ export default function handleRequest(
   // eslint-disable-next-line @typescript-eslint/no-unused-vars
   loadContext: AppLoadContext
 ) {
+  // SharedArrayBuffer 사용 (WASM 슬라이서 워커, vite.config.ts 와 같은 헤더)
+  responseHeaders.set("Cross-Origin-Opener-Policy", "same-origin");
+  responseHeaders.set("Cross-Origin-Embedder-Policy", "credentialless");
+
   return isbot(request.headers.get("user-agent") || "")
     ? handleBotRequest(
         request,
@@ -1,14 +1,42 @@
 import { PrintSettings } from "~/entities/settings/types";
-import { ModelAnalysis } from "~/entities/model/types";
+import { Model3D, ModelAnalysis } from "~/entities/model/types";
 import { useEstimationStore } from "~/shared/lib/store";
+import {
+  canAnalyzeMesh,
+  getWASMSlicer,
+  MeshAnalysis,
+} from "~/shared/lib/wasm-slicer";
 import { amsManager } from "~/features/ams/AMSManager";
 import bambuLabSettings from "~/shared/config/bambulab-settings.json";
 
+// C++ 메시 분석 (mm 단위) -> 견적용 모델 분석 (cm 단위)
+// 복잡도는 삼각형 수로, 이미 분석한 값이 있으면 복잡도/서포트 판단은 그대로 둔다.
+export const modelAnalysisFromMesh = (
+  mesh: MeshAnalysis,
+  previous?: ModelAnalysis | null,
+  fileFormat?: string
+): ModelAnalysis => ({
+  complexity:
+    previous?.complexity ??
+    (mesh.triangles < 50_000
+      ? "low"
+      : mesh.triangles < 500_000
+      ? "medium"
+      : "high"),
+  supportRequired: previous?.supportRequired ?? false,
+  estimatedVolume: Math.abs(mesh.volume) / 1000,
+  surfaceArea: mesh.area / 100,
+  height: mesh.maxZ - mesh.minZ,
+  watertight: mesh.watertight,
+  fileFormat: fileFormat ?? previous?.fileFormat,
+});
+
 export const useEstimation = () => {
   const {
     currentModel,
     modelAnalysis,
     printSettings,
+    setModelAnalysis,
     setEstimation,
     setSlicing,
     setError,
@@ -66,18 +94,34 @@ export const useEstimation = () => {
     };
   };
 
+  // WASM 코어로 모델 메시를 분석해 스토어에 반영 (부피/넓이/높이를 JS 에서 다시 계산하지 않는다)
+  // STL / 3MF 만 분석하고, 다른 형식은 null (기존처럼 분석 결과가 있어야 견적을 낸다).
+  // worker 에 로드된 메시가 이 모델로 바뀐다 (WASMSlicer.analyzeModel 참고).
+  const analyzeModel = async (model: Model3D): Promise<ModelAnalysis | null> => {
+    if (!canAnalyzeMesh(model.file.name)) return null;
+    const mesh = await getWASMSlicer().analyzeModel(model.file);
+    const analysis = modelAnalysisFromMesh(mesh, modelAnalysis, model.type);
+    setModelAnalysis(analysis);
+    return analysis;
+  };
+
   // 향상된 견적 계산 (AMS 및 Bambu Lab 설정 적용)
+  // modelHeight (mm) 는 메시 분석 결과, 없으면 부피로 추정한다
   const calculateEstimationFromSettings = (
     settings: PrintSettings,
     modelVolume: number,
-    selectedFilament: any
+    selectedFilament: any,
+    modelHeight?: number
   ) => {
     const speedProfile = Object.values(
       bambuLabSettings.bambuLabProfiles.speedModes
     ).find((mode) => mode.printSpeed === settings.printSpeed);
 
     // 레이어 높이와 속도에 따른 정밀한 시간 계산
-    const estimatedHeight = Math.max(modelVolume / 100, 50); // 추정 높이 (mm)
+    const estimatedHeight =
+      modelHeight && modelHeight > 0
+        ? modelHeight
+        : Math.max(modelVolume / 100, 50); // 추정 높이 (mm)
     const layerCount = Math.ceil(estimatedHeight / settings.layerHeight);
 
     // Bambu Lab 가속도 설정 반영
@@ -133,7 +177,10 @@ export const useEstimation = () => {
   };
 
   const calculateEstimation = async (settings: PrintSettings) => {
-    if (!currentModel || !modelAnalysis) {
+    if (
+      !currentModel ||
+      (!modelAnalysis && !canAnalyzeMesh(currentModel.file.name))
+    ) {
       setError("모델 분석이 필요합니다.");
       return;
     }
@@ -142,13 +189,19 @@ export const useEstimation = () => {
     setError(null);
 
     try {
+      // 분석 결과가 없으면 WASM 코어로 메시를 분석한다 (STL / 3MF 만, 위에서 확인)
+      const analysis = modelAnalysis ?? (await analyzeModel(currentModel));
+      if (!analysis) {
+        throw new Error("모델 분석이 필요합니다.");
+      }
+
       // 슬라이싱 시뮬레이션 (복잡도에 따른 시간 조정)
       const complexityMultiplier =
         {
           low: 1,
           medium: 1.5,
           high: 2,
-        }[modelAnalysis.complexity] || 1;
+        }[analysis.complexity] || 1;
 
       const delay = 2000 + Math.random() * 2000 * complexityMultiplier;
       await new Promise((resolve) => setTimeout(resolve, delay));
@@ -156,17 +209,18 @@ export const useEstimation = () => {
       // AMS에서 최적 필라멘트 선택
       const selectedFilament = selectOptimalFilament(
         currentModel.classification || "functional",
-        modelAnalysis.complexity
+        analysis.complexity
       );
 
-      // 모델 분석 데이터에서 부피 추정
-      const estimatedVolume = modelAnalysis.estimatedVolume;
+      // 모델 분석 데이터의 부피/높이
+      const estimatedVolume = analysis.estimatedVolume;
 
       // 향상된 견적 계산
       const result = calculateEstimationFromSettings(
         settings,
         estimatedVolume,
-        selectedFilament
+        selectedFilament,
+        analysis.height
       );
 
       const estimation = {
@@ -259,6 +313,7 @@ export const useEstimation = () => {
 
   return {
     generateSuggestedSettings,
+    analyzeModel,
     calculateEstimation,
     formatPrintTime,
     formatFilamentUsage,
@@ -0,0 +1,113 @@
+// 슬라이스 결과 캐시 저장소 (WASM 슬라이서의 저장소 훅)
+//
+// 키는 워커의 C++ 코어가 만든 "메시 해시 + 설정 해시" (wasm/src/slice_cache.h).
+// 같은 모델을 같은 설정으로 다시 자르면 slice() 없이 저장된 G-code 를 돌려준다.
+
+export interface SliceCacheEntry {
+  gcode: string;
+  layerInfoJson: string;
+}
+
+export interface SliceCacheStorage {
+  get(key: string): Promise<SliceCacheEntry | null>;
+  put(key: string, entry: SliceCacheEntry): Promise<void>;
+}
+
+// 탭이 열려 있는 동안만 유지 (최근 사용 순으로 maxEntries 개)
+export class MemorySliceCacheStorage implements SliceCacheStorage {
+  private entries = new Map<string, SliceCacheEntry>();
+
+  constructor(private maxEntries = 8) {}
+
+  async get(key: string): Promise<SliceCacheEntry | null> {
+    const entry = this.entries.get(key);
+    if (!entry) {
+      return null;
+    }
+    // Map 은 삽입 순서를 유지하므로 다시 넣어 최근 사용으로 옮긴다
+    this.entries.delete(key);
+    this.entries.set(key, entry);
+    return entry;
+  }
+
+  async put(key: string, entry: SliceCacheEntry): Promise<void> {
+    this.entries.delete(key);
+    this.entries.set(key, entry);
+    while (this.entries.size > this.maxEntries) {
+      const oldest = this.entries.keys().next().value as string;
+      this.entries.delete(oldest);
+    }
+  }
+}
+
+// 재방문에도 유지되는 저장소 (오래된 항목부터 maxEntries 개를 넘으면 지운다)
+export class IndexedDBSliceCacheStorage implements SliceCacheStorage {
+  private db: Promise<IDBDatabase> | null = null;
+
+  constructor(
+    private dbName = "slice-cache",
+    private maxEntries = 32
+  ) {}
+
+  private open(): Promise<IDBDatabase> {
+    if (!this.db) {
+      this.db = new Promise((resolve, reject) => {
+        const request = indexedDB.open(this.dbName, 1);
+        request.onupgradeneeded = () => {
+          const store = request.result.createObjectStore("entries");
+          store.createIndex("storedAt", "storedAt");
+        };
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+      });
+    }
+    return this.db;
+  }
+
+  async get(key: string): Promise<SliceCacheEntry | null> {
+    const db = await this.open();
+    return new Promise((resolve, reject) => {
+      const request = db
+        .transaction("entries", "readonly")
+        .objectStore("entries")
+        .get(key);
+      request.onsuccess = () => {
+        const record = request.result;
+        resolve(
+          record
+            ? { gcode: record.gcode, layerInfoJson: record.layerInfoJson }
+            : null
+        );
+      };
+      request.onerror = () => reject(request.error);
+    });
+  }
+
+  async put(key: string, entry: SliceCacheEntry): Promise<void> {
+    const db = await this.open();
+    return new Promise((resolve, reject) => {
+      const transaction = db.transaction("entries", "readwrite");
+      const store = transaction.objectStore("entries");
+      store.put({ ...entry, storedAt: Date.now() }, key);
+
+      // 개수 제한: 가장 오래된 항목부터 삭제
+      const count = store.count();
+      count.onsuccess = () => {
+        let excess = count.result - this.maxEntries;
+        if (excess <= 0) {
+          return;
+        }
+        store.index("storedAt").openKeyCursor().onsuccess = (event) => {
+          const cursor = (event.target as IDBRequest<IDBCursor | null>).result;
+          if (cursor && excess-- > 0) {
+            store.delete(cursor.primaryKey);
+            cursor.continue();
+          }
+        };
+      };
+
+      transaction.oncomplete = () => resolve();
+      transaction.onerror = () => reject(transaction.error);
+    });
+  }
+}
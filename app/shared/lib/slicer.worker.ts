@@ -0,0 +1,333 @@
+// WASM 슬라이서 Web Worker
+// 슬라이싱은 전부 여기서 실행하고, 메인 스레드(wasm-slicer.ts)에는 결과 버퍼만 전송한다.
+
+import type {
+  SlicerModuleVariant,
+  SlicerToolpaths,
+  SlicerWorkerRequest,
+  SlicerWorkerResponse,
+} from "./wasm-slicer";
+import { loadCompiledModule } from "./wasm-module-cache";
+
+interface WorkerScope {
+  postMessage(message: SlicerWorkerResponse, transfer?: Transferable[]): void;
+  onmessage: ((event: MessageEvent<SlicerWorkerRequest>) => void) | null;
+}
+
+const scope = self as unknown as WorkerScope;
+
+let module: any = null;
+let slicer: any = null;
+let loadedVariant: SlicerModuleVariant | null = null;
+let moduleCached = false;
+let footprints: any = null; // 객체별 발자국 캐시 (FootprintCache)
+
+// JS 글루 import 와 .wasm 스트리밍 컴파일(브라우저 코드 캐시)을 동시에 시작하고,
+// Emscripten 의 instantiateWasm 훅으로 미리 컴파일한 Module 을 넘긴다.
+async function instantiate(variant: SlicerModuleVariant): Promise<any> {
+  const compiled = loadCompiledModule(`/${variant}.wasm`);
+  const { default: createSlicerModule } = await import(
+    /* @vite-ignore */ `/${variant}.js`
+  );
+
+  return new Promise((resolve, reject) => {
+    createSlicerModule({
+      instantiateWasm(
+        imports: WebAssembly.Imports,
+        receiveInstance: (
+          instance: WebAssembly.Instance,
+          module: WebAssembly.Module
+        ) => void
+      ) {
+        compiled
+          .then(async ({ module: wasmModule, cached }) => {
+            moduleCached = cached;
+            const instance = await WebAssembly.instantiate(wasmModule, imports);
+            // pthread 빌드는 이 Module 을 작업자 스레드에도 넘긴다
+            receiveInstance(instance, wasmModule);
+          })
+          .catch(reject);
+        return {};
+      },
+    }).then(resolve, reject);
+  });
+}
+
+async function loadModule(variant: SlicerModuleVariant): Promise<SlicerModuleVariant> {
+  if (module) {
+    return loadedVariant!;
+  }
+
+  try {
+    module = await instantiate(variant);
+    loadedVariant = variant;
+  } catch (error) {
+    // pthread 빌드가 없거나 로드할 수 없으면 단일 스레드 빌드로
+    if (variant !== "slicer-mt") {
+      throw error;
+    }
+    console.warn("⚠️ slicer-mt 로드 실패, 단일 스레드 빌드 사용:", error);
+    return loadModule("slicer");
+  }
+
+  slicer = new module.SimpleSlicer();
+  return loadedVariant;
+}
+
+// 공유/전송받은 STL/3MF 바이트를 wasm 힙으로 한 번 복사해 파싱 (파싱 후 바로 해제)
+function loadMesh(bytes: SharedArrayBuffer | ArrayBuffer): boolean {
+  const size = bytes.byteLength;
+  const address = module._malloc(Math.max(size, 1));
+  if (!address) {
+    throw new Error("WASM 힙에 메시를 올릴 수 없습니다.");
+  }
+  try {
+    module.HEAPU8.set(new Uint8Array(bytes), address);
+    if (slicer.loadMeshFromHeap(address, size)) {
+      return true;
+    }
+  } finally {
+    module._free(address);
+  }
+
+  // zip(3MF) 인데 실패했으면 테스트 큐브로 대체하지 않고 이유를 알린다
+  const head = new Uint8Array(bytes, 0, Math.min(size, 4));
+  if (head[0] === 0x50 && head[1] === 0x4b && head[2] === 3 && head[3] === 4) {
+    throw new Error(`3MF 파싱 실패: ${slicer.getLoadError()}`);
+  }
+
+  // STL 이 아닌 입력(테스트 호출)은 기존처럼 테스트 큐브로 대체
+  return slicer.parseSTL("");
+}
+
+// 힙 뷰는 다음 slice() 에서 덮어쓰이므로 전송용 버퍼로 한 번만 복사한다
+function copyToolpaths(): SlicerToolpaths {
+  const views = slicer.getToolpathViews();
+  const toFloat64 = (view: ArrayLike<number | bigint>) =>
+    view instanceof Float64Array
+      ? view.slice()
+      : Float64Array.from(view as ArrayLike<number>, Number);
+  return {
+    layerHeights: views.layerHeights.slice(),
+    layerContourStart: toFloat64(views.layerContourStart),
+    layerInfillStart: toFloat64(views.layerInfillStart),
+    contourPoints: views.contourPoints.slice(),
+    contourOffsets: toFloat64(views.contourOffsets),
+    infillPoints: views.infillPoints.slice(),
+    infillOffsets: toFloat64(views.infillOffsets),
+  };
+}
+
+function toolpathBuffers(toolpaths: SlicerToolpaths): Transferable[] {
+  return Object.values(toolpaths).map((array) => array.buffer);
+}
+
+async function handle(request: SlicerWorkerRequest): Promise<void> {
+  const { id } = request;
+
+  switch (request.type) {
+    case "init": {
+      const startTime = performance.now();
+      const variant = await loadModule(request.variant);
+      scope.postMessage({
+        id,
+        type: "result",
+        result: {
+          variant,
+          cached: moduleCached,
+          startupMs: performance.now() - startTime,
+        },
+      });
+      return;
+    }
+
+    case "loadMesh": {
+      const loaded = loadMesh(request.bytes);
+      scope.postMessage({ id, type: "result", result: loaded });
+      return;
+    }
+
+    case "loadTestMesh": {
+      const { options } = request;
+      const loaded = slicer.loadTestMesh(
+        options.shape,
+        options.triangles ?? 100000,
+        options.islands ?? 1,
+        options.complexity ?? 1,
+        options.seed ?? 1
+      );
+      scope.postMessage({ id, type: "result", result: loaded });
+      return;
+    }
+
+    case "slice": {
+      slicer.setLayerHeight(request.settings.layerHeight);
+      slicer.setInfillDensity(request.settings.infillDensity);
+      const sliceError: string = slicer.checkSlice();
+      if (sliceError) {
+        throw new Error(`슬라이스 실패: ${sliceError}`);
+      }
+
+      // slice() + G-code 를 청크 단위로 바로 메인 스레드에 넘긴다
+      slicer.writeGCodeChunks((view: Uint8Array) => {
+        const chunk = view.slice();
+        scope.postMessage({ id, type: "gcodeChunk", chunk: chunk.buffer }, [
+          chunk.buffer,
+        ]);
+      }, request.chunkBytes);
+
+      const layerInfoJson: string = slicer.formatLayerInfo();
+      const toolpaths = copyToolpaths();
+      scope.postMessage(
+        {
+          id,
+          type: "result",
+          result: { layerInfoJson, toolpaths, stats: slicer.getStats() },
+        },
+        toolpathBuffers(toolpaths)
+      );
+      return;
+    }
+
+    case "exportGCode3MF": {
+      slicer.setLayerHeight(request.settings.layerHeight);
+      slicer.setInfillDensity(request.settings.infillDensity);
+
+      // zip 청크를 만들어지는 대로 메인 스레드에 넘긴다
+      const error: string = slicer.writeGCode3MFChunks(
+        new Uint8Array(request.thumbnailPng ?? new ArrayBuffer(0)),
+        new Uint8Array(request.smallThumbnailPng ?? new ArrayBuffer(0)),
+        request.projectSettings ?? "",
+        (view: Uint8Array) => {
+          const chunk = view.slice();
+          scope.postMessage({ id, type: "gcodeChunk", chunk: chunk.buffer }, [
+            chunk.buffer,
+          ]);
+        },
+        request.chunkBytes
+      );
+      if (error) {
+        throw new Error(`.gcode.3mf 생성 실패: ${error}`);
+      }
+      scope.postMessage({ id, type: "result", result: slicer.getStats() });
+      return;
+    }
+
+    case "exportBGCode": {
+      slicer.setLayerHeight(request.settings.layerHeight);
+      slicer.setInfillDensity(request.settings.infillDensity);
+
+      // 인코딩된 블록을 만들어지는 대로 메인 스레드에 넘긴다
+      const error: string = slicer.writeBGCodeChunks(
+        new Uint8Array(request.thumbnailPng ?? new ArrayBuffer(0)),
+        request.printerModel ?? "",
+        request.keepComments ?? false,
+        (view: Uint8Array) => {
+          const chunk = view.slice();
+          scope.postMessage({ id, type: "gcodeChunk", chunk: chunk.buffer }, [
+            chunk.buffer,
+          ]);
+        },
+        request.chunkBytes
+      );
+      if (error) {
+        throw new Error(`.bgcode 생성 실패: ${error}`);
+      }
+      scope.postMessage({ id, type: "result", result: slicer.getStats() });
+      return;
+    }
+
+    case "arrange": {
+      const placements = module.arrangeFootprints(
+        request.points,
+        request.offsets,
+        request.settings
+      );
+      scope.postMessage({ id, type: "result", result: placements });
+      return;
+    }
+
+    case "analyzeMesh":
+      scope.postMessage({ id, type: "result", result: slicer.analyzeMesh() });
+      return;
+
+    case "orient":
+      scope.postMessage({
+        id,
+        type: "result",
+        result: slicer.findOrientations(request.options),
+      });
+      return;
+
+    case "raycast":
+    case "closestPoints": {
+      const hits: Float64Array =
+        request.type === "raycast"
+          ? slicer.raycast(request.queries, request.maxDistance)
+          : slicer.closestPoints(request.queries, request.maxDistance);
+      scope.postMessage({ id, type: "result", result: hits }, [hits.buffer]);
+      return;
+    }
+
+    case "footprint": {
+      footprints ??= new module.FootprintCache();
+      if (request.geometry) {
+        footprints.setMesh(
+          request.objectId,
+          request.geometry.positions,
+          request.geometry.indices ?? new Uint32Array(0)
+        );
+      }
+      scope.postMessage({
+        id,
+        type: "result",
+        result: footprints.getFootprint(request.objectId, request.matrix),
+      });
+      return;
+    }
+
+    case "releaseFootprint":
+      footprints?.remove(request.objectId);
+      scope.postMessage({ id, type: "result", result: null });
+      return;
+
+    case "sliceCacheKey":
+      slicer.setLayerHeight(request.settings.layerHeight);
+      slicer.setInfillDensity(request.settings.infillDensity);
+      scope.postMessage({ id, type: "result", result: slicer.getSliceCacheKey() });
+      return;
+
+    case "getStats":
+      scope.postMessage({ id, type: "result", result: slicer?.getStats() ?? null });
+      return;
+
+    case "getTraceJson":
+      scope.postMessage({
+        id,
+        type: "result",
+        result: slicer ? slicer.getTraceJson() : '{"traceEvents":[]}',
+      });
+      return;
+
+    case "clearTrace":
+      slicer?.clearTrace();
+      scope.postMessage({ id, type: "result", result: null });
+      return;
+  }
+}
+
+// 요청은 도착 순서대로 하나씩 처리한다 (init 이 끝나기 전에 온 요청 포함)
+let queue: Promise<void> = Promise.resolve();
+
+scope.onmessage = (event) => {
+  const request = event.data;
+  queue = queue.then(() =>
+    handle(request).catch((error) => {
+      scope.postMessage({
+        id: request.id,
+        type: "error",
+        message: error instanceof Error ? error.message : String(error),
+      });
+    })
+  );
+};
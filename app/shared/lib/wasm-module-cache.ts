@@ -0,0 +1,47 @@
+// .wasm 스트리밍 컴파일 + 브라우저 컴파일 코드 캐시
+//
+// WebAssembly.Module 을 IndexedDB 에 직접 저장하지 않는다. Chrome 과 Firefox 는 Module 의
+// 구조화 복제를 거부해 (DataCloneError) 그 캐시는 항상 빗나간다. 대신 compileStreaming 으로
+// 컴파일하면 브라우저가 컴파일된 코드를 .wasm 의 HTTP 캐시 항목 옆에 저장해 재방문 때 재사용한다.
+// 그러려면 응답이 application/wasm 이고 HTTP 캐시에 저장될 수 있어야 한다 (vite.config.ts 의
+// wasmCacheHeaders). 새 빌드를 배포하면 ETag 재검증으로 HTTP 캐시와 코드 캐시가 함께 바뀐다.
+
+export interface CompiledModule {
+  module: WebAssembly.Module;
+  cached: boolean;
+}
+
+// 스트리밍 컴파일 (서버가 application/wasm 으로 주지 않으면 바이트로 받아 컴파일, 코드 캐시 없음)
+async function compileResponse(response: Response): Promise<WebAssembly.Module> {
+  if (
+    typeof WebAssembly.compileStreaming === "function" &&
+    response.headers.get("Content-Type")?.startsWith("application/wasm")
+  ) {
+    return WebAssembly.compileStreaming(response);
+  }
+  return WebAssembly.compile(await response.arrayBuffer());
+}
+
+// 응답을 HTTP 캐시에서 받았는지 (본문보다 적게 전송됨: 캐시 적중 또는 304 재검증).
+// 이때 브라우저 코드 캐시가 있으면 컴파일을 건너뛴다. Resource Timing 이 없으면 false.
+function servedFromHttpCache(url: string): boolean {
+  if (typeof performance === "undefined" || !performance.getEntriesByName) {
+    return false;
+  }
+  const entries = performance.getEntriesByName(
+    new URL(url, self.location.href).href,
+    "resource"
+  ) as PerformanceResourceTiming[];
+  const entry = entries[entries.length - 1];
+  return !!entry && entry.encodedBodySize > 0 && entry.transferSize < entry.encodedBodySize;
+}
+
+export async function loadCompiledModule(url: string): Promise<CompiledModule> {
+  const response = await fetch(url);
+  if (!response.ok) {
+    throw new Error(`${url}: HTTP ${response.status}`);
+  }
+
+  const module = await compileResponse(response);
+  return { module, cached: servedFromHttpCache(url) };
+}
@@ -1,5 +1,10 @@
 // WASM 슬라이서 TypeScript 래퍼
 
+import {
+  MemorySliceCacheStorage,
+  type SliceCacheStorage,
+} from "./slice-cache";
+
 export interface SlicerSettings {
   layerHeight: number;
   infillDensity: number;
@@ -11,6 +16,21 @@ export interface SlicingResult {
   boundingBox: number[];
   totalLayers: number;
   processingTime: number;
+  toolpaths?: SlicerToolpaths; // 슬라이스 캐시에서 꺼낸 결과에는 없음
+  cached?: boolean;
+}
+
+// 시각화용 툴패스 (worker 에서 전송받은 typed array, 복사 없이 그대로 사용)
+// 점은 [x0, y0, x1, y1, ...], 오프셋은 폴리라인 시작 점 번호 (마지막에 끝 번호 하나 더)
+// 레이어 i 의 윤곽선은 layerContourStart[i] 번 폴리라인부터 다음 레이어 시작 전까지
+export interface SlicerToolpaths {
+  layerHeights: Float64Array;
+  layerContourStart: Float64Array;
+  layerInfillStart: Float64Array;
+  contourPoints: Float64Array;
+  contourOffsets: Float64Array;
+  infillPoints: Float64Array;
+  infillOffsets: Float64Array;
 }
 
 export interface LayerInfo {
@@ -25,75 +45,393 @@ export interface LayerInfo {
   }>;
 }
 
-declare global {
-  interface Window {
-    SimpleSlicer: any;
-    Vector3: any;
-  }
+// 슬라이서 실행 통계 (wasm/src/slicer_stats.h 의 SlicerStats)
+export interface SlicerStats {
+  trianglesParsed: number;
+  vertices: number;
+  meshBytes: number;
+  layers: number;
+  contourSegments: number;
+  infillSegments: number;
+  intersectionsTested: number;
+  intersectionsHit: number;
+  allocations: number;
+  arenaPeakBytes: number;
+  heapUsedBytes: number;
+  heapPeakBytes: number;
+  heapLimitBytes: number;
+  gcodeBytes: number;
+  cacheHit: number;
+  parseMs: number;
+  bboxMs: number;
+  sliceMs: number;
+  intersectMs: number;
+  contourMs: number;
+  infillMs: number;
+  gcodeMs: number;
+  layerInfoMs: number;
+  hashMs: number;
 }
 
-export class WASMSlicer {
-  private module: any = null;
-  private slicer: any = null;
-  private isInitialized = false;
+// 절차적 테스트 메시 (wasm/src/mesh_generator.h)
+export type TestMeshShape = "sphere" | "torus" | "menger" | "vase" | "gyroid";
+
+export interface TestMeshOptions {
+  shape: TestMeshShape;
+  triangles?: number;
+  islands?: number;
+  complexity?: number;
+  seed?: number;
+}
+
+// WASM 모듈 빌드 변형
+// - slicer: 기본 (힙 최대 128MB)
+// - slicer-mt: pthread 병렬 슬라이스 (crossOriginIsolated 페이지에서만)
+// - slicer-large: 힙 최대 4GB
+// - slicer-mem64: memory64 (4GB 초과, 브라우저 지원 필요)
+export type SlicerModuleVariant =
+  | "slicer"
+  | "slicer-mt"
+  | "slicer-large"
+  | "slicer-mem64";
+
+// 메인 스레드 ↔ slicer.worker.ts 메시지
+export type SlicerWorkerCommand =
+  | { type: "init"; variant: SlicerModuleVariant }
+  | { type: "loadMesh"; bytes: SharedArrayBuffer | ArrayBuffer }
+  | { type: "loadTestMesh"; options: TestMeshOptions }
+  | { type: "slice"; settings: SlicerSettings; chunkBytes: number }
+  | { type: "getStats" }
+  | { type: "getTraceJson" }
+  | { type: "clearTrace" }
+  | { type: "sliceCacheKey"; settings: SlicerSettings }
+  | {
+      type: "exportGCode3MF";
+      settings: SlicerSettings;
+      thumbnailPng?: ArrayBuffer;
+      smallThumbnailPng?: ArrayBuffer;
+      projectSettings?: string;
+      chunkBytes: number;
+    }
+  | {
+      type: "exportBGCode";
+      settings: SlicerSettings;
+      thumbnailPng?: ArrayBuffer;
+      printerModel?: string;
+      keepComments?: boolean;
+      chunkBytes: number;
+    }
+  | {
+      type: "arrange";
+      points: Float64Array;
+      offsets: Float64Array;
+      settings: ArrangeSettings;
+    }
+  | { type: "analyzeMesh" }
+  | { type: "orient"; options: OrientOptions }
+  | {
+      type: "raycast" | "closestPoints";
+      queries: Float64Array;
+      maxDistance: number;
+    }
+  | {
+      type: "footprint";
+      objectId: string;
+      matrix: number[];
+      geometry?: FootprintGeometry;
+    }
+  | { type: "releaseFootprint"; objectId: string };
+
+export type SlicerWorkerRequest = { id: number } & SlicerWorkerCommand;
+
+export type SlicerWorkerResponse = { id: number } & (
+  | { type: "result"; result: any }
+  | { type: "gcodeChunk"; chunk: ArrayBuffer }
+  | { type: "error"; message: string }
+);
+
+// 모듈 시작 정보 (cached: .wasm 을 HTTP 캐시에서 받아 브라우저 코드 캐시로 컴파일을 건너뛸 수 있음)
+export interface SlicerStartupInfo {
+  variant: SlicerModuleVariant;
+  cached: boolean;
+  startupMs: number;
+}
 
-  constructor() {
-    this.loadModule();
+// .gcode.3mf 에 함께 넣을 플레이트 자료 (모두 선택)
+export interface GCode3MFAssets {
+  thumbnail?: Blob | ArrayBuffer; // PNG, Metadata/plate_1.png
+  smallThumbnail?: Blob | ArrayBuffer; // PNG, Metadata/plate_1_small.png
+  projectSettings?: string; // Metadata/project_settings.config (없으면 슬라이서 설정으로)
+}
+
+// .bgcode 출력 옵션 (모두 선택)
+export interface BGCodeAssets {
+  thumbnail?: Blob | ArrayBuffer; // PNG 썸네일 블록
+  printerModel?: string; // 프린터 메타데이터 printer_model
+  keepComments?: boolean; // true 면 주석 유지 (MeatPackComments), 기본은 주석 삭제
+}
+
+// 자동 배치 설정 (플레이트 중심이 원점)
+export interface ArrangeSettings {
+  plateWidth: number;
+  plateHeight: number;
+  spacing: number; // 부품 사이 최소 간격
+  rotations: number; // 후보 회전 수 (360 / rotations 간격, 1 = 회전 안 함)
+  alignToCenter: boolean;
+}
+
+// 부품 원점 기준으로 rotation (라디안, Z 축 반시계) 만큼 돌린 뒤 (x, y) 로 옮긴다
+export interface ArrangePlacement {
+  placed: boolean; // false 면 플레이트에 들어가지 않음
+  x: number;
+  y: number;
+  rotation: number;
+}
+
+// 메시 분석 결과 (C++ MeshAnalysis, mm 단위)
+export interface MeshAnalysis {
+  triangles: number;
+  vertices: number;
+  volume: number; // mm³, 부호 있음 (바깥을 향한 반시계 감기면 양수)
+  area: number; // mm²
+  centroidX: number; // 부피 중심 (부피가 0 이면 표면 중심)
+  centroidY: number;
+  centroidZ: number;
+  minX: number;
+  minY: number;
+  minZ: number;
+  maxX: number;
+  maxY: number;
+  maxZ: number;
+  openEdges: number; // 삼각형 하나에만 속한 변
+  nonManifoldEdges: number; // 삼각형 셋 이상이 공유하는 변
+  degenerateTriangles: number;
+  watertight: boolean;
+}
+
+// 자동 방향 찾기 옵션 (점수는 낮을수록 좋음)
+export interface OrientOptions {
+  samples: number; // 구면 후보 수 (축 6 개와 넓은 평면 법선은 항상 포함)
+  topCount: number; // 돌려줄 후보 수
+  overhangAngle: number; // 수직에서 이 각도(도)보다 누운 아래 방향 면은 서포트 필요
+  contactTolerance: number; // 바닥에서 이 높이(mm) 안의 아래 방향 면은 바닥 접촉
+  minContactArea: number; // 접촉 넓이(mm^2)가 이보다 작으면 설 수 없는 자세로 보고 감점
+  supportWeight: number;
+  overhangWeight: number;
+  contactWeight: number;
+  heightWeight: number;
+  stabilityWeight: number; // 접촉 부족 비율에 곱하는 벌점
+}
+
+export const DEFAULT_ORIENT_OPTIONS: OrientOptions = {
+  samples: 256,
+  topCount: 5,
+  overhangAngle: 45,
+  contactTolerance: 0.2,
+  minContactArea: 1,
+  supportWeight: 2,
+  overhangWeight: 1,
+  contactWeight: 1,
+  heightWeight: 0.25,
+  stabilityWeight: 10,
+};
+
+// 방향 후보: 모델 좌표의 down 방향을 바닥 (-Z) 으로 보내는 회전 (쿼터니언 qx, qy, qz, qw)
+export interface OrientCandidate {
+  downX: number;
+  downY: number;
+  downZ: number;
+  qx: number;
+  qy: number;
+  qz: number;
+  qw: number;
+  score: number;
+  overhangArea: number; // mm^2
+  supportVolume: number; // mm^3 (추정)
+  contactArea: number; // mm^2
+  height: number; // mm
+}
+
+// 메시 BVH 질의 결과 (광선: 원점에서 맞은 점까지 거리, 최근접점: 질의점에서의 거리)
+export interface MeshHit {
+  distance: number;
+  triangle: number; // 메시 삼각형 번호
+  point: [number, number, number];
+  normal: [number, number, number]; // 면 법선 (감은 방향 기준)
+}
+
+// 워커 결과 버퍼의 질의 하나당 double 수 ([거리, 삼각형, x, y, z, nx, ny, nz])
+const MESH_HIT_STRIDE = 8;
+
+function unpackMeshHits(hits: Float64Array): (MeshHit | null)[] {
+  const result: (MeshHit | null)[] = [];
+  for (let i = 0; i + MESH_HIT_STRIDE <= hits.length; i += MESH_HIT_STRIDE) {
+    result.push(
+      hits[i + 1] < 0
+        ? null
+        : {
+            distance: hits[i],
+            triangle: hits[i + 1],
+            point: [hits[i + 2], hits[i + 3], hits[i + 4]],
+            normal: [hits[i + 5], hits[i + 6], hits[i + 7]],
+          }
+    );
   }
+  return result;
+}
 
-  private async loadModule(): Promise<void> {
-    try {
-      console.log("🔄 WASM 모듈 로딩 중...");
+// 발자국 계산용 메시 (three.js BufferGeometry 의 position / index)
+export interface FootprintGeometry {
+  positions: Float32Array; // xyz 반복
+  indices?: Uint32Array; // 없으면 정점 세 개씩 삼각형
+}
 
-      // WASM 모듈 동적 로드
-      const response = await fetch("/slicer.js");
-      const script = await response.text();
+// 변환 후 XY 발자국 (다각형은 [x0, y0, x1, y1, ...], 반시계)
+export interface MeshFootprint {
+  hull: Float64Array; // 볼록 껍질
+  outlines: Float64Array[]; // 섬별 바깥 윤곽 (구멍 채움, 단순화), 넓이 큰 순
+  area: number; // 윤곽 넓이 합
+  minX: number;
+  minY: number;
+  maxX: number;
+  maxY: number;
+}
 
-      // 스크립트 실행
-      const scriptElement = document.createElement("script");
-      scriptElement.textContent = script;
-      document.head.appendChild(scriptElement);
+interface WorkerSliceResult {
+  layerInfoJson: string;
+  toolpaths: SlicerToolpaths;
+  stats: SlicerStats;
+}
 
-      // 모듈 초기화 대기
-      await this.waitForModule();
+interface PendingRequest {
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+  onChunk?: (chunk: ArrayBuffer) => void;
+}
 
-      this.isInitialized = true;
-      console.log("✅ WASM 모듈 로딩 완료");
-    } catch (error) {
-      console.error("❌ WASM 모듈 로딩 실패:", error);
-      throw new Error("WASM 모듈을 로드할 수 없습니다.");
+// G-code 청크 크기 (청크마다 메인 스레드에서 조금씩 디코딩해 프레임을 막지 않는다)
+const GCODE_CHUNK_BYTES = 256 * 1024;
+
+// SharedArrayBuffer 를 쓸 수 있으면 pthread 빌드 사용
+function defaultVariant(): SlicerModuleVariant {
+  return typeof crossOriginIsolated !== "undefined" && crossOriginIsolated
+    ? "slicer-mt"
+    : "slicer";
+}
+
+// 메인 스레드 프록시: 모듈 로드와 슬라이싱은 전부 Web Worker 에서 실행한다
+// WASM 코어가 직접 읽는 메시 형식 (STL, 3MF). 분석/방향 찾기 전에 확인한다.
+export const canAnalyzeMesh = (fileName: string): boolean =>
+  /\.(stl|3mf)$/i.test(fileName);
+
+export class WASMSlicer {
+  private worker: Worker | null = null;
+  private ready: Promise<void> | null = null;
+  private isInitialized = false;
+  private variant: SlicerModuleVariant;
+  private startupInfo: SlicerStartupInfo | null = null;
+  private nextRequestId = 1;
+  private pending = new Map<number, PendingRequest>();
+  private sliceCache: SliceCacheStorage | null = new MemorySliceCacheStorage();
+
+  constructor(variant: SlicerModuleVariant = defaultVariant()) {
+    this.variant = variant;
+
+    // 첫 슬라이스 전에 워커 시작과 모듈 컴파일을 미리 해 둔다 (SSR 에서는 건너뜀)
+    if (typeof Worker !== "undefined") {
+      this.initialize().catch(() => {});
     }
   }
 
-  private waitForModule(): Promise<void> {
-    return new Promise((resolve, reject) => {
-      const checkModule = () => {
-        if (window.SimpleSlicer) {
-          resolve();
-        } else {
-          setTimeout(checkModule, 100);
-        }
-      };
-      checkModule();
+  private request<T>(
+    message: SlicerWorkerCommand,
+    transfer: Transferable[] = [],
+    onChunk?: (chunk: ArrayBuffer) => void
+  ): Promise<T> {
+    const worker = this.worker;
+    if (!worker) {
+      return Promise.reject(new Error("WASM 워커가 시작되지 않았습니다."));
+    }
 
-      // 타임아웃 설정
-      setTimeout(() => {
-        reject(new Error("WASM 모듈 로딩 타임아웃"));
-      }, 10000);
+    const id = this.nextRequestId++;
+    return new Promise<T>((resolve, reject) => {
+      this.pending.set(id, { resolve, reject, onChunk });
+      worker.postMessage({ ...message, id }, transfer);
     });
   }
 
+  private handleMessage(response: SlicerWorkerResponse): void {
+    const pending = this.pending.get(response.id);
+    if (!pending) {
+      return;
+    }
+
+    switch (response.type) {
+      case "gcodeChunk":
+        pending.onChunk?.(response.chunk);
+        return;
+      case "result":
+        this.pending.delete(response.id);
+        pending.resolve(response.result);
+        return;
+      case "error":
+        this.pending.delete(response.id);
+        pending.reject(new Error(response.message));
+        return;
+    }
+  }
+
+  private failAll(error: Error): void {
+    for (const pending of this.pending.values()) {
+      pending.reject(error);
+    }
+    this.pending.clear();
+  }
+
   async initialize(): Promise<void> {
-    if (!this.isInitialized) {
-      await this.loadModule();
+    if (!this.ready) {
+      this.ready = this.startWorker();
     }
+    return this.ready;
+  }
+
+  // 모듈이 준비되면 resolve (실패하면 reject, 다시 부르면 재시도)
+  whenReady(): Promise<void> {
+    return this.initialize();
+  }
 
+  private async startWorker(): Promise<void> {
     try {
-      this.slicer = new window.SimpleSlicer();
-      console.log("✅ WASM 슬라이서 초기화 완료");
+      console.log("🔄 WASM 워커 시작 중...");
+
+      this.worker = new Worker(new URL("./slicer.worker.ts", import.meta.url), {
+        type: "module",
+      });
+      this.worker.onmessage = (event: MessageEvent<SlicerWorkerResponse>) =>
+        this.handleMessage(event.data);
+      this.worker.onerror = (event) => {
+        console.error("❌ WASM 워커 오류:", event.message);
+        this.failAll(new Error(event.message || "WASM 워커 오류"));
+      };
+
+      const info = await this.request<SlicerStartupInfo>({
+        type: "init",
+        variant: this.variant,
+      });
+      this.variant = info.variant;
+      this.startupInfo = info;
+      this.isInitialized = true;
+      console.log(
+        `✅ WASM 슬라이서 초기화 완료 (${info.variant}, ${info.startupMs.toFixed(1)}ms${
+          info.cached ? ", HTTP 캐시" : ""
+        })`
+      );
     } catch (error) {
-      console.error("❌ WASM 슬라이서 초기화 실패:", error);
-      throw error;
+      console.error("❌ WASM 모듈 로딩 실패:", error);
+      this.worker?.terminate();
+      this.worker = null;
+      this.ready = null;
+      throw new Error("WASM 모듈을 로드할 수 없습니다.");
     }
   }
 
@@ -101,70 +439,291 @@ export class WASMSlicer {
     file: File,
     settings: SlicerSettings
   ): Promise<SlicingResult> {
-    if (!this.slicer) {
-      await this.initialize();
-    }
+    await this.initialize();
 
     const startTime = performance.now();
 
     try {
       console.log("🔪 WASM 슬라이싱 시작...");
 
-      // 설정 적용
-      this.slicer.setLayerHeight(settings.layerHeight);
-      this.slicer.setInfillDensity(settings.infillDensity);
+      await this.loadFile(file);
+      return this.sliceLoadedMesh(settings, startTime);
+    } catch (error) {
+      console.error("❌ WASM 슬라이싱 실패:", error);
+      throw error;
+    }
+  }
+
+  // 파일을 워커 메시로 읽는다
+  private async loadFile(file: File): Promise<void> {
+    // 파일 바이트를 한 번만 넘긴다: 격리된 페이지면 SharedArrayBuffer, 아니면 ArrayBuffer 전송
+    const fileData = await file.arrayBuffer();
+    let bytes: SharedArrayBuffer | ArrayBuffer = fileData;
+    let transfer: Transferable[] = [fileData];
+    if (typeof crossOriginIsolated !== "undefined" && crossOriginIsolated) {
+      const shared = new SharedArrayBuffer(fileData.byteLength);
+      new Uint8Array(shared).set(new Uint8Array(fileData));
+      bytes = shared;
+      transfer = [];
+    }
+
+    // STL 파싱 (STL 이 아닌 입력은 테스트 큐브로 대체)
+    const parseSuccess = await this.request<boolean>(
+      { type: "loadMesh", bytes },
+      transfer
+    );
+    if (!parseSuccess) {
+      throw new Error("STL 파일 파싱 실패");
+    }
+  }
+
+  // 파일을 읽어 부피/넓이/무게중심/바운딩 박스/메시 결함 수를 한 번에 계산 (슬라이스 안 함)
+  // STL / 3MF 만 넘긴다 (canAnalyzeMesh). 다른 형식은 STL 로 읽혀 테스트 큐브로 대체된다.
+  // worker 에 로드된 메시를 이 파일로 바꾼다: sliceModel 은 매번 자기 파일을 다시 로드하므로 영향이 없지만,
+  // 이후 analyzeLoadedMesh / findOrientations / raycast / closestPoints 는 이 파일의 메시를 대상으로 한다.
+  async analyzeModel(file: File): Promise<MeshAnalysis> {
+    await this.initialize();
+    await this.loadFile(file);
+    return this.analyzeLoadedMesh();
+  }
+
+  // 마지막으로 로드한 메시 분석
+  async analyzeLoadedMesh(): Promise<MeshAnalysis> {
+    await this.initialize();
+    return this.request<MeshAnalysis>({ type: "analyzeMesh" });
+  }
+
+  // 절차적 테스트 메시 슬라이싱 (같은 시드면 항상 같은 결과)
+  async sliceTestMesh(
+    options: TestMeshOptions,
+    settings: SlicerSettings
+  ): Promise<SlicingResult> {
+    await this.initialize();
+
+    const startTime = performance.now();
 
-      // 파일 데이터 읽기 (간단한 테스트용)
-      const fileData = await this.readFileAsText(file);
+    const loaded = await this.request<boolean>({
+      type: "loadTestMesh",
+      options,
+    });
+    if (!loaded) {
+      throw new Error(`알 수 없는 테스트 메시: ${options.shape}`);
+    }
 
-      // STL 파싱 (현재는 테스트 큐브 생성)
-      const parseSuccess = this.slicer.parseSTL(fileData);
-      if (!parseSuccess) {
-        throw new Error("STL 파일 파싱 실패");
+    return this.sliceLoadedMesh(settings, startTime);
+  }
+
+  private async sliceLoadedMesh(
+    settings: SlicerSettings,
+    startTime: number
+  ): Promise<SlicingResult> {
+    // 같은 메시 + 설정이면 저장된 결과를 그대로 쓴다 (slice() 생략)
+    const cache = this.sliceCache;
+    const cacheKey = cache
+      ? await this.request<string>({ type: "sliceCacheKey", settings })
+      : null;
+    if (cache && cacheKey) {
+      const entry = await cache.get(cacheKey).catch(() => null);
+      if (entry) {
+        const layerInfo: LayerInfo = JSON.parse(entry.layerInfoJson);
+        const processingTime = performance.now() - startTime;
+        console.log("✅ WASM 슬라이스 캐시 적중:", {
+          processingTime: `${processingTime.toFixed(2)}ms`,
+          key: cacheKey,
+        });
+        return {
+          gcode: entry.gcode,
+          layerInfo,
+          boundingBox: layerInfo.boundingBox,
+          totalLayers: layerInfo.totalLayers,
+          processingTime,
+          cached: true,
+        };
       }
+    }
 
-      // 바운딩 박스 가져오기
-      const boundingBox = this.slicer.getBoundingBox();
+    // G-code 는 도착하는 청크마다 이어서 디코딩
+    const decoder = new TextDecoder();
+    const parts: string[] = [];
+    const result = await this.request<WorkerSliceResult>(
+      { type: "slice", settings, chunkBytes: GCODE_CHUNK_BYTES },
+      [],
+      (chunk) => parts.push(decoder.decode(chunk, { stream: true }))
+    );
+    parts.push(decoder.decode());
+    const gcode = parts.join("");
+
+    const layerInfo: LayerInfo = JSON.parse(result.layerInfoJson);
+    const processingTime = performance.now() - startTime;
+
+    if (cache && cacheKey) {
+      cache
+        .put(cacheKey, { gcode, layerInfoJson: result.layerInfoJson })
+        .catch((error) => console.warn("⚠️ 슬라이스 캐시 저장 실패:", error));
+    }
 
-      // 레이어 정보 가져오기
-      const layerInfoJson = this.slicer.getLayerInfo();
-      const layerInfo: LayerInfo = JSON.parse(layerInfoJson);
+    console.log("✅ WASM 슬라이싱 완료:", {
+      processingTime: `${processingTime.toFixed(2)}ms`,
+      totalLayers: layerInfo.totalLayers,
+      gcodeLength: gcode.length,
+    });
 
-      // G-code 생성
-      const gcode = this.slicer.generateGCode();
+    return {
+      gcode,
+      layerInfo,
+      boundingBox: layerInfo.boundingBox,
+      totalLayers: layerInfo.totalLayers,
+      processingTime,
+      toolpaths: result.toolpaths,
+    };
+  }
 
-      const processingTime = performance.now() - startTime;
+  // 마지막으로 로드한 메시를 잘라 Bambu 프린터용 .gcode.3mf 로 내보낸다.
+  // 워커가 G-code 를 만들면서 바로 zip 으로 압축해 청크로 보내므로 G-code 문자열은 어디에도 만들어지지 않는다.
+  async exportGCode3MF(
+    settings: SlicerSettings,
+    assets: GCode3MFAssets = {}
+  ): Promise<Blob> {
+    await this.initialize();
+
+    const toBuffer = async (png?: Blob | ArrayBuffer) =>
+      png instanceof Blob ? png.arrayBuffer() : png;
+    const [thumbnailPng, smallThumbnailPng] = await Promise.all([
+      toBuffer(assets.thumbnail),
+      toBuffer(assets.smallThumbnail),
+    ]);
+
+    const chunks: ArrayBuffer[] = [];
+    await this.request<SlicerStats>(
+      {
+        type: "exportGCode3MF",
+        settings,
+        thumbnailPng,
+        smallThumbnailPng,
+        projectSettings: assets.projectSettings,
+        chunkBytes: GCODE_CHUNK_BYTES,
+      },
+      [],
+      (chunk) => chunks.push(chunk)
+    );
+    return new Blob(chunks, { type: "model/3mf" });
+  }
 
-      console.log("✅ WASM 슬라이싱 완료:", {
-        processingTime: `${processingTime.toFixed(2)}ms`,
-        totalLayers: layerInfo.totalLayers,
-        gcodeLength: gcode.length,
-      });
+  // 마지막으로 로드한 메시를 잘라 바이너리 G-code (.bgcode) 로 내보낸다.
+  // 워커가 G-code 를 64KB 블록마다 MeatPack + heatshrink 로 압축해 청크로 보낸다 (텍스트 G-code 의 약 30%).
+  async exportBGCode(
+    settings: SlicerSettings,
+    assets: BGCodeAssets = {}
+  ): Promise<Blob> {
+    await this.initialize();
+
+    const thumbnailPng =
+      assets.thumbnail instanceof Blob
+        ? await assets.thumbnail.arrayBuffer()
+        : assets.thumbnail;
+
+    const chunks: ArrayBuffer[] = [];
+    await this.request<SlicerStats>(
+      {
+        type: "exportBGCode",
+        settings,
+        thumbnailPng,
+        printerModel: assets.printerModel,
+        keepComments: assets.keepComments,
+        chunkBytes: GCODE_CHUNK_BYTES,
+      },
+      [],
+      (chunk) => chunks.push(chunk)
+    );
+    return new Blob(chunks, { type: "application/octet-stream" });
+  }
 
-      return {
-        gcode,
-        layerInfo,
-        boundingBox,
-        totalLayers: layerInfo.totalLayers,
-        processingTime,
-      };
-    } catch (error) {
-      console.error("❌ WASM 슬라이싱 실패:", error);
-      throw error;
+  // 발자국 (부품별 [x0, y0, x1, y1, ...], 모델 원점 기준) 으로 플레이트 자동 배치.
+  // 워커가 볼록 껍질의 no-fit polygon 으로 아래-왼쪽부터 채우며, 후보 회전은 pthread 빌드에서 병렬로 평가한다.
+  async arrangeFootprints(
+    footprints: Float64Array[],
+    settings: ArrangeSettings
+  ): Promise<ArrangePlacement[]> {
+    await this.initialize();
+
+    const offsets = new Float64Array(footprints.length + 1);
+    for (let i = 0; i < footprints.length; i++) {
+      offsets[i + 1] = offsets[i] + Math.floor(footprints[i].length / 2);
     }
+    const points = new Float64Array(offsets[footprints.length] * 2);
+    footprints.forEach((footprint, i) => {
+      points.set(footprint.subarray(0, (offsets[i + 1] - offsets[i]) * 2), offsets[i] * 2);
+    });
+
+    return this.request<ArrangePlacement[]>(
+      { type: "arrange", points, offsets, settings },
+      [points.buffer, offsets.buffer]
+    );
+  }
+
+  // 마지막으로 로드한 메시 (loadMesh / loadTestMesh) 의 자동 방향 후보, 점수 낮은 순.
+  // 후보 방향마다 삼각형 블록을 pthread 빌드에서 병렬로 평가한다.
+  async findOrientations(
+    options: Partial<OrientOptions> = {}
+  ): Promise<OrientCandidate[]> {
+    await this.initialize();
+    return this.request<OrientCandidate[]>({
+      type: "orient",
+      options: { ...DEFAULT_ORIENT_OPTIONS, ...options },
+    });
+  }
+
+  // 마지막으로 로드한 메시에 광선 일괄 질의 (rays: [ox, oy, oz, dx, dy, dz] 반복, 메시 좌표).
+  // 워커가 처음 질의할 때 BVH 를 만들어 두고 메시가 바뀔 때까지 재사용한다. maxDistance <= 0 이면 제한 없음.
+  // rays / points 버퍼는 워커로 넘어가므로 호출 뒤에는 쓸 수 없다.
+  async raycast(rays: Float64Array, maxDistance = 0): Promise<(MeshHit | null)[]> {
+    await this.initialize();
+    const hits = await this.request<Float64Array>(
+      { type: "raycast", queries: rays, maxDistance },
+      [rays.buffer]
+    );
+    return unpackMeshHits(hits);
+  }
+
+  // 마지막으로 로드한 메시에서 각 점 ([x, y, z] 반복) 에 가장 가까운 표면 점 (측정 스냅, 벽 두께)
+  async closestPoints(
+    points: Float64Array,
+    maxDistance = 0
+  ): Promise<(MeshHit | null)[]> {
+    await this.initialize();
+    const hits = await this.request<Float64Array>(
+      { type: "closestPoints", queries: points, maxDistance },
+      [points.buffer]
+    );
+    return unpackMeshHits(hits);
   }
 
-  private async readFileAsText(file: File): Promise<string> {
-    return new Promise((resolve, reject) => {
-      const reader = new FileReader();
-      reader.onload = () => resolve(reader.result as string);
-      reader.onerror = reject;
-      reader.readAsText(file);
+  // 객체 발자국 (볼록 껍질 + 윤곽). matrix 는 Matrix4.elements.
+  // 워커가 객체별로 메시를 보관하고 행렬이 바뀔 때만 다시 계산하므로 geometry 는 처음 (또는 모양이 바뀌었을 때) 만 보낸다.
+  // 워커에 메시가 없는 id 면 null (geometry 와 함께 다시 요청).
+  async getFootprint(
+    objectId: string,
+    matrix: ArrayLike<number>,
+    geometry?: FootprintGeometry
+  ): Promise<MeshFootprint | null> {
+    await this.initialize();
+    return this.request<MeshFootprint | null>({
+      type: "footprint",
+      objectId,
+      matrix: Array.from(matrix),
+      geometry,
     });
   }
 
-  // 간단한 테스트 함수
-  async testSlicing(): Promise<SlicingResult> {
+  // 워커에 보관한 객체 메시 해제 (모델을 지웠을 때)
+  async releaseFootprint(objectId: string): Promise<void> {
+    if (this.isInitialized) {
+      await this.request<null>({ type: "releaseFootprint", objectId });
+    }
+  }
+
+  // 간단한 테스트 함수 (옵션을 주면 절차적 테스트 메시로 슬라이싱)
+  async testSlicing(options?: TestMeshOptions): Promise<SlicingResult> {
     console.log("🧪 WASM 슬라이서 테스트 시작...");
 
     const settings: SlicerSettings = {
@@ -172,6 +731,10 @@ export class WASMSlicer {
       infillDensity: 20,
     };
 
+    if (options) {
+      return await this.sliceTestMesh(options, settings);
+    }
+
     // 가상의 파일 객체 생성
     const testFile = new File(["test"], "test.stl", {
       type: "application/octet-stream",
@@ -180,31 +743,80 @@ export class WASMSlicer {
     return await this.sliceModel(testFile, settings);
   }
 
-  // 메모리 사용량 확인
-  getMemoryUsage(): { used: number; total: number } {
-    if (!this.module) {
-      return { used: 0, total: 0 };
+  // 마지막 실행의 카운터/단계 시간/힙 사용량
+  async getStats(): Promise<SlicerStats | null> {
+    if (!this.isInitialized) {
+      return null;
+    }
+    return this.request<SlicerStats | null>({ type: "getStats" });
+  }
+
+  // 메모리 사용량 확인 (used: malloc 사용량, peak: 지금까지 최대, total: 힙 성장 한도)
+  async getMemoryUsage(): Promise<{ used: number; peak: number; total: number }> {
+    const stats = await this.getStats();
+    if (!stats) {
+      return { used: 0, peak: 0, total: 0 };
     }
 
-    // Emscripten 메모리 정보 (실제 구현에서는 모듈에서 가져옴)
     return {
-      used: 0, // 실제 메모리 사용량
-      total: 128 * 1024 * 1024, // 128MB 제한
+      used: stats.heapUsedBytes,
+      peak: stats.heapPeakBytes,
+      total: stats.heapLimitBytes,
     };
   }
 
+  // 단계/레이어별 Chrome 트레이스 JSON (Perfetto 에서 열기, SLICER_TRACE 빌드에서만 내용이 있음)
+  async getTraceJson(): Promise<string> {
+    if (!this.isInitialized) {
+      return '{"traceEvents":[]}';
+    }
+    return this.request<string>({ type: "getTraceJson" });
+  }
+
+  async clearTrace(): Promise<void> {
+    if (this.isInitialized) {
+      await this.request<null>({ type: "clearTrace" });
+    }
+  }
+
+  // 슬라이스 결과 캐시 저장소 교체 (예: new IndexedDBSliceCacheStorage(), null 이면 끔)
+  setSliceCache(storage: SliceCacheStorage | null): void {
+    this.sliceCache = storage;
+  }
+
+  // 실제로 로드된 모듈 변형 (slicer-mt 를 못 쓰면 slicer)
+  getVariant(): SlicerModuleVariant {
+    return this.variant;
+  }
+
+  // 모듈 시작 시간/캐시 적중 여부 (초기화 전에는 null)
+  getStartupInfo(): SlicerStartupInfo | null {
+    return this.startupInfo;
+  }
+
   // 모듈 상태 확인
   isReady(): boolean {
-    return this.isInitialized && this.slicer !== null;
+    return this.isInitialized;
+  }
+
+  // 워커 종료 (진행 중인 요청은 실패 처리)
+  terminate(): void {
+    this.worker?.terminate();
+    this.worker = null;
+    this.ready = null;
+    this.isInitialized = false;
+    this.failAll(new Error("WASM 워커가 종료되었습니다."));
   }
 }
 
 // 싱글톤 인스턴스
 let wasmSlicerInstance: WASMSlicer | null = null;
 
-export function getWASMSlicer(): WASMSlicer {
+export function getWASMSlicer(
+  variant: SlicerModuleVariant = defaultVariant()
+): WASMSlicer {
   if (!wasmSlicerInstance) {
-    wasmSlicerInstance = new WASMSlicer();
+    wasmSlicerInstance = new WASMSlicer(variant);
   }
   return wasmSlicerInstance;
 }
@@ -5,6 +5,7 @@ import {
   Vector3,
   ArrangementOptions,
 } from "~/shared/types/plate";
+import { getWASMSlicer } from "~/shared/lib/wasm-slicer";
 import { ModelHelper } from "./ModelHelper";
 
 export class AutoArrangementHelper {
@@ -43,6 +44,78 @@ export class AutoArrangementHelper {
     }
   }
 
+  /**
+   * 모델들을 자동으로 배치합니다 (packed 는 WASM 배치 엔진)
+   * 메시 발자국의 no-fit polygon 으로 빈틈을 채우고 회전 후보도 시도합니다.
+   * 워커를 쓸 수 없으면 바운딩 박스 배치로 대체합니다.
+   */
+  async arrangeModelsAsync(
+    models: PlateModel[],
+    plateSettings: PlateSettings,
+    options: ArrangementOptions
+  ): Promise<PlateModel[]> {
+    const validModels = models.filter((model) => model.mesh);
+
+    if (validModels.length === 0 || options.arrangement !== "packed") {
+      return this.arrangeModels(models, plateSettings, options);
+    }
+
+    try {
+      const footprints = await Promise.all(
+        validModels.map((model) => this.relativeHull(model.mesh!))
+      );
+      const placements = await getWASMSlicer().arrangeFootprints(
+        footprints,
+        {
+          plateWidth: plateSettings.size.width,
+          plateHeight: plateSettings.size.height,
+          spacing: options.spacing,
+          rotations: 4,
+          alignToCenter: options.alignToCenter,
+        }
+      );
+
+      return validModels.map((model, i) => {
+        const placement = placements[i];
+        // 배치할 수 없으면 원래 위치 유지
+        if (!placement?.placed) {
+          return model;
+        }
+
+        return {
+          ...model,
+          transform: {
+            ...model.transform,
+            position: { x: placement.x, y: placement.y, z: 0 },
+            rotation: {
+              ...model.transform.rotation,
+              z: model.transform.rotation.z + placement.rotation,
+            },
+          },
+        };
+      });
+    } catch (error) {
+      console.warn("⚠️ WASM 자동 배치 실패, 바운딩 박스 배치 사용:", error);
+      return this.arrangeInPacked(validModels, plateSettings, options);
+    }
+  }
+
+  /**
+   * 발자국의 볼록 껍질을 모델 원점 기준 XY 로 (배치 엔진 입력)
+   */
+  private async relativeHull(mesh: THREE.Mesh): Promise<Float64Array> {
+    const { hull } = await ModelHelper.calculateFootprint(mesh);
+    const origin = new THREE.Vector3().setFromMatrixPosition(mesh.matrixWorld);
+    const relative = new Float64Array(hull.length);
+
+    for (let i = 0; i < hull.length; i += 2) {
+      relative[i] = hull[i] - origin.x;
+      relative[i + 1] = hull[i + 1] - origin.y;
+    }
+
+    return relative;
+  }
+
   /**
    * Grid 방식으로 모델들을 배치합니다
    */
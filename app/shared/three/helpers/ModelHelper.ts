@@ -2,9 +2,20 @@ import * as THREE from "three";
 import { STLLoader } from "three-stdlib";
 import { GLTFLoader } from "three-stdlib";
 import { Transform } from "~/shared/types/plate";
+import { getWASMSlicer, MeshFootprint } from "~/shared/lib/wasm-slicer";
+
+interface CachedFootprint {
+  geometry: THREE.BufferGeometry;
+  matrix: number[];
+  footprint: Promise<MeshFootprint>;
+}
 
 export class ModelHelper {
   private static instance: ModelHelper;
+  // 메시별 발자국 (지오메트리나 matrixWorld 가 바뀌면 다시 계산)
+  private static footprints = new WeakMap<THREE.Mesh, CachedFootprint>();
+  // 워커에 보낸 지오메트리 (변형만 바뀌면 행렬만 보낸다)
+  private static sentGeometries = new WeakMap<THREE.Mesh, THREE.BufferGeometry>();
   private stlLoader: STLLoader;
   private gltfLoader: GLTFLoader;
   private loadingManager: THREE.LoadingManager;
@@ -231,6 +242,113 @@ export class ModelHelper {
     return box;
   }
 
+  /**
+   * 모델 XY 발자국 계산 (볼록 껍질 + 섬별 윤곽, 월드 좌표)
+   * 바운딩 박스 대신 배치/충돌/간격 계산에 씁니다. 변형이 바뀔 때만 다시 계산합니다.
+   */
+  static calculateFootprint(mesh: THREE.Mesh): Promise<MeshFootprint> {
+    mesh.updateMatrixWorld(true);
+    const matrix = mesh.matrixWorld.elements.slice();
+    const cached = this.footprints.get(mesh);
+    if (
+      cached &&
+      cached.geometry === mesh.geometry &&
+      cached.matrix.every((value, i) => value === matrix[i])
+    ) {
+      return cached.footprint;
+    }
+
+    const footprint = this.requestFootprint(mesh, matrix).catch((error) => {
+      console.warn("⚠️ WASM 발자국 계산 실패, 바운딩 박스 사용:", error);
+      return this.boxFootprint(mesh);
+    });
+    this.footprints.set(mesh, { geometry: mesh.geometry, matrix, footprint });
+    return footprint;
+  }
+
+  private static async requestFootprint(
+    mesh: THREE.Mesh,
+    matrix: number[]
+  ): Promise<MeshFootprint> {
+    const slicer = getWASMSlicer();
+    const geometry = mesh.geometry;
+
+    let footprint =
+      this.sentGeometries.get(mesh) === geometry
+        ? await slicer.getFootprint(mesh.uuid, matrix)
+        : null;
+
+    // 처음이거나 워커가 메시를 잃었으면 (재시작) 지오메트리와 함께 보낸다
+    if (!footprint) {
+      const position = geometry.getAttribute("position");
+      const positions =
+        position instanceof THREE.BufferAttribute &&
+        position.array instanceof Float32Array &&
+        position.itemSize === 3
+          ? position.array
+          : Float32Array.from({ length: position.count * 3 }, (_, i) =>
+              position.getComponent(Math.floor(i / 3), i % 3)
+            );
+      const index = geometry.getIndex();
+
+      footprint = await slicer.getFootprint(mesh.uuid, matrix, {
+        positions,
+        indices: index ? Uint32Array.from(index.array) : undefined,
+      });
+      if (this.sentGeometries.get(mesh) !== geometry) {
+        this.sentGeometries.set(mesh, geometry);
+        // 지오메트리를 정리하면 워커 힙의 사본도 해제한다
+        geometry.addEventListener("dispose", () => {
+          if (this.sentGeometries.get(mesh) === geometry) {
+            this.releaseFootprint(mesh);
+          }
+        });
+      }
+    }
+
+    if (!footprint) {
+      throw new Error("발자국을 계산할 수 없습니다.");
+    }
+    return footprint;
+  }
+
+  /**
+   * 워커에 보관한 발자국용 메시 사본 해제 (모델을 지우거나 지오메트리를 정리할 때)
+   */
+  static releaseFootprint(mesh: THREE.Mesh): void {
+    this.footprints.delete(mesh);
+    if (!this.sentGeometries.delete(mesh)) return;
+    getWASMSlicer()
+      .releaseFootprint(mesh.uuid)
+      .catch((error) => console.warn("⚠️ 발자국 메시 해제 실패:", error));
+  }
+
+  /**
+   * 바운딩 박스 사각형 발자국 (WASM 을 쓸 수 없을 때)
+   */
+  private static boxFootprint(mesh: THREE.Mesh): MeshFootprint {
+    const { min, max } = this.calculateBoundingBox(mesh);
+    const rectangle = Float64Array.of(
+      min.x,
+      min.y,
+      max.x,
+      min.y,
+      max.x,
+      max.y,
+      min.x,
+      max.y
+    );
+    return {
+      hull: rectangle,
+      outlines: [rectangle],
+      area: (max.x - min.x) * (max.y - min.y),
+      minX: min.x,
+      minY: min.y,
+      maxX: max.x,
+      maxY: max.y,
+    };
+  }
+
   /**
    * 두 모델 간 충돌 검사
    */
@@ -269,6 +387,8 @@ export class ModelHelper {
    * 모델 정리
    */
   static disposeMesh(mesh: THREE.Mesh): void {
+    this.releaseFootprint(mesh);
+
     if (mesh.geometry) {
       mesh.geometry.dispose();
     }
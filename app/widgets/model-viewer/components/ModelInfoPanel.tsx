@@ -5,10 +5,12 @@ import {
   formatDate,
 } from "~/shared/lib/3mf-parser";
 import { ColorPalette } from "./ColorPalette";
+import type { MeshAnalysis } from "~/shared/lib/wasm-slicer";
 
 interface ModelInfoPanelProps {
   metadata: ThreeMFMetadata | null;
   currentFiles: File[];
+  analysis?: MeshAnalysis | null; // WASM 코어 메시 분석 (없으면 형상 항목 생략)
   isVisible: boolean;
   onClose: () => void;
 }
@@ -16,6 +18,7 @@ interface ModelInfoPanelProps {
 export const ModelInfoPanel: React.FC<ModelInfoPanelProps> = ({
   metadata,
   currentFiles,
+  analysis,
   isVisible,
   onClose,
 }) => {
@@ -97,7 +100,11 @@ export const ModelInfoPanel: React.FC<ModelInfoPanelProps> = ({
       {/* 컨텐츠 */}
       <div className="flex-1 overflow-y-auto p-4">
         {activeTab === "info" && (
-          <GeneralInfo metadata={metadata} currentFiles={currentFiles} />
+          <GeneralInfo
+            metadata={metadata}
+            currentFiles={currentFiles}
+            analysis={analysis}
+          />
         )}
         {activeTab === "objects" && <ObjectsInfo metadata={metadata} />}
         {activeTab === "materials" && <MaterialsInfo metadata={metadata} />}
@@ -111,7 +118,8 @@ export const ModelInfoPanel: React.FC<ModelInfoPanelProps> = ({
 const GeneralInfo: React.FC<{
   metadata: ThreeMFMetadata | null;
   currentFiles: File[];
-}> = ({ metadata, currentFiles }) => {
+  analysis?: MeshAnalysis | null;
+}> = ({ metadata, currentFiles, analysis }) => {
   const totalSize = currentFiles.reduce((total, file) => total + file.size, 0);
 
   return (
@@ -153,6 +161,9 @@ const GeneralInfo: React.FC<{
         )}
       </div>
 
+      {/* 형상 (메시 분석) */}
+      {analysis && <GeometryInfo analysis={analysis} />}
+
       {/* 파일 목록 */}
       <div className="mt-6">
         <h4 className="text-sm font-medium text-gray-300 mb-2">Files</h4>
@@ -174,6 +185,67 @@ const GeneralInfo: React.FC<{
   );
 };
 
+// 메시 분석 결과 (부피/넓이/크기/메시 결함)
+const GeometryInfo: React.FC<{ analysis: MeshAnalysis }> = ({ analysis }) => {
+  const size = [
+    analysis.maxX - analysis.minX,
+    analysis.maxY - analysis.minY,
+    analysis.maxZ - analysis.minZ,
+  ];
+
+  return (
+    <div className="mt-6">
+      <h4 className="text-sm font-medium text-gray-300 mb-2">Geometry</h4>
+      <div className="space-y-3">
+        <InfoItem
+          label="Size"
+          value={`${size.map((v) => v.toFixed(1)).join(" × ")} mm`}
+        />
+        <InfoItem
+          label="Volume"
+          value={`${(Math.abs(analysis.volume) / 1000).toFixed(2)} cm³`}
+        />
+        <InfoItem
+          label="Surface Area"
+          value={`${(analysis.area / 100).toFixed(2)} cm²`}
+        />
+        <InfoItem
+          label="Centroid"
+          value={[analysis.centroidX, analysis.centroidY, analysis.centroidZ]
+            .map((v) => v.toFixed(1))
+            .join(", ")}
+        />
+        <InfoItem
+          label="Triangles"
+          value={analysis.triangles.toLocaleString()}
+        />
+        <InfoItem
+          label="Watertight"
+          value={analysis.watertight ? "Yes" : "No"}
+        />
+        {analysis.openEdges > 0 && (
+          <InfoItem
+            label="Open Edges"
+            value={analysis.openEdges.toLocaleString()}
+          />
+        )}
+        {analysis.nonManifoldEdges > 0 && (
+          <InfoItem
+            label="Non-manifold Edges"
+            value={analysis.nonManifoldEdges.toLocaleString()}
+          />
+        )}
+        {analysis.degenerateTriangles > 0 && (
+          <InfoItem
+            label="Degenerate Triangles"
+            value={analysis.degenerateTriangles.toLocaleString()}
+          />
+        )}
+      </div>
+    </div>
+  );
+};
+
 // 객체 정보 탭
 const ObjectsInfo: React.FC<{ metadata: ThreeMFMetadata | null }> = ({
   metadata,
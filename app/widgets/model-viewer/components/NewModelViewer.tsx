@@ -7,6 +7,11 @@ import {
   SlicerSettings,
   SlicingResult,
 } from "~/shared/lib/js-slicer";
+import {
+  canAnalyzeMesh,
+  getWASMSlicer,
+  MeshAnalysis,
+} from "~/shared/lib/wasm-slicer";
 
 // 임시 팔레트 (실제 색상 배열로 대체 가능)
 const DEFAULT_PALETTE = [
@@ -40,6 +45,7 @@ export const NewModelViewer = () => {
     null
   );
   const [isSlicing, setIsSlicing] = useState(false);
+  const [meshAnalysis, setMeshAnalysis] = useState<MeshAnalysis | null>(null);
   const [slicingError, setSlicingError] = useState<string | null>(null);
   const [slicerSettings, setSlicerSettings] = useState<SlicerSettings>({
     layerHeight: 0.2,
@@ -149,6 +155,24 @@ export const NewModelViewer = () => {
     [loadModel]
   );
 
+  // 모델 정보 패널의 형상 항목: STL / 3MF 를 WASM 코어로 한 번 분석한다
+  useEffect(() => {
+    const file = currentFiles?.[0];
+    setMeshAnalysis(null);
+    if (!file || !canAnalyzeMesh(file.name)) return;
+
+    let cancelled = false;
+    getWASMSlicer()
+      .analyzeModel(file)
+      .then((analysis) => {
+        if (!cancelled) setMeshAnalysis(analysis);
+      })
+      .catch((err) => console.warn("메시 분석 실패:", err));
+    return () => {
+      cancelled = true;
+    };
+  }, [currentFiles]);
+
   const triggerFileSelect = () => {
     fileInputRef.current?.click();
   };
@@ -367,6 +391,7 @@ export const NewModelViewer = () => {
             <ModelInfoPanel
               metadata={modelMetadata}
               currentFiles={currentFiles}
+              analysis={meshAnalysis}
               isVisible={showModelInfo}
               onClose={() => setShowModelInfo(false)}
             />
@@ -1,5 +1,5 @@
 import { vitePlugin as remix } from "@remix-run/dev";
-import { defineConfig } from "vite";
+import { defineConfig, type Connect, type Plugin } from "vite";
 import tsconfigPaths from "vite-tsconfig-paths";
 
 declare module "@remix-run/node" {
@@ -8,7 +8,41 @@ declare module "@remix-run/node" {
   }
 }
 
+// SharedArrayBuffer / pthread WASM 슬라이서(slicer-mt)용 교차 출처 격리
+// credentialless: 외부 폰트 등 CORP 헤더가 없는 리소스도 계속 로드된다
+const crossOriginIsolationHeaders = {
+  "Cross-Origin-Opener-Policy": "same-origin",
+  "Cross-Origin-Embedder-Policy": "credentialless",
+};
+
+// 슬라이서 .wasm: compileStreaming 에 필요한 MIME 과 HTTP 캐시에 저장될 수 있는 헤더.
+// 브라우저는 컴파일된 코드를 이 캐시 항목에 붙여 두므로, 파일 이름이 고정된 .wasm 은
+// 저장하되 매번 ETag 로 재검증한다 (새 빌드면 다시 받아 다시 컴파일).
+const wasmCacheHeaders: Connect.NextHandleFunction = (req, res, next) => {
+  if (req.url?.split("?")[0].endsWith(".wasm")) {
+    res.setHeader("Content-Type", "application/wasm");
+    res.setHeader("Cache-Control", "public, no-cache");
+  }
+  next();
+};
+
+const wasmCachePlugin: Plugin = {
+  name: "wasm-cache-headers",
+  configureServer(server) {
+    server.middlewares.use(wasmCacheHeaders);
+  },
+  configurePreviewServer(server) {
+    server.middlewares.use(wasmCacheHeaders);
+  },
+};
+
 export default defineConfig({
+  server: {
+    headers: crossOriginIsolationHeaders,
+  },
+  preview: {
+    headers: crossOriginIsolationHeaders,
+  },
   plugins: [
     remix({
       future: {
@@ -20,5 +54,6 @@ export default defineConfig({
       },
     }),
     tsconfigPaths(),
+    wasmCachePlugin,
   ],
 });
@@ -0,0 +1,761 @@
+// 슬라이싱 파이프라인 단계별 벤치마크 (Google Benchmark)
+//
+//   slicer-bench --benchmark_format=json > results.json
+//   slicer-bench --benchmark_filter='slice/gyroid'
+//
+// 메시는 mesh_generator 로 절차적으로 생성한다 (고정 시드). 기본 크기는 10k ~ 1M 삼각형이며,
+// 환경 변수 SLICER_BENCH_MAX_TRIANGLES=10000000 으로 10M 까지 늘릴 수 있다.
+
+#include "arrange.h"
+#include "bgcode_writer.h"
+#include "bvh.h"
+#include "deflate.h"
+#include "footprint.h"
+#include "gcode_3mf_writer.h"
+#include "gcode_writer.h"
+#include "layer_store.h"
+#include "mesh.h"
+#include "mesh_analysis.h"
+#include "mesh_generator.h"
+#include "orient.h"
+#include "simple_slicer.h"
+#include "slice_kernels.h"
+#include "spatial_grid.h"
+#include "stl_reader.h"
+#include "thread_pool.h"
+#include "threemf_reader.h"
+
+#include <benchmark/benchmark.h>
+#ifdef SLICER_BENCH_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double kLayerHeight = 0.2;
+const double kInfillDensity = 20.0;
+
+// 벤치마크 입력 시나리오 (각각 다른 핫패스의 최악 경우를 겨냥)
+struct Scenario {
+    const char* name;
+    TestMeshShape shape;
+    uint32_t islands;
+};
+
+const Scenario kScenarios[] = {
+    {"sphere", TestMeshShape::Sphere, 1},     // 기준선
+    {"torus", TestMeshShape::Torus, 1},       // 구멍 뚫린 단면
+    {"menger", TestMeshShape::Menger, 1},     // 수평면 + 구멍 많은 레이어
+    {"vase", TestMeshShape::Vase, 1},         // 길고 구불구불한 얇은 벽
+    {"gyroid", TestMeshShape::Gyroid, 1},     // 짧은 교차 구간이 많은 격자
+    {"islands", TestMeshShape::Sphere, 64},   // 레이어당 섬 64개
+};
+
+// 출력 바이트 수만 세는 스트림 (G-code 포맷팅 비용만 측정)
+class CountingStreamBuf : public std::streambuf {
+public:
+    size_t count = 0;
+
+protected:
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof()) count++;
+        return c;
+    }
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        count += static_cast<size_t>(n);
+        return n;
+    }
+};
+
+void appendFloatLE(std::vector<unsigned char>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<unsigned char>(bits >> (i * 8)));
+}
+
+std::vector<unsigned char> toBinarySTL(const Mesh& mesh) {
+    std::vector<unsigned char> out(80, 0);
+    uint32_t count = static_cast<uint32_t>(mesh.triangleCount());
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<unsigned char>(count >> (i * 8)));
+    out.reserve(84 + size_t(count) * 50);
+    for (size_t t = 0; t < mesh.triangleCount(); t++) {
+        Triangle tri = mesh.triangle(t);
+        for (int i = 0; i < 3; i++) appendFloatLE(out, 0.0f);
+        for (const Vector3* v : {&tri.v1, &tri.v2, &tri.v3}) {
+            appendFloatLE(out, static_cast<float>(v->x));
+            appendFloatLE(out, static_cast<float>(v->y));
+            appendFloatLE(out, static_cast<float>(v->z));
+        }
+        out.push_back(0);
+        out.push_back(0);
+    }
+    return out;
+}
+
+void appendLE(std::vector<unsigned char>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+}
+
+// 파트 하나를 deflate 로 담은 최소 zip (로컬 헤더 + 중앙 디렉터리 + EOCD)
+std::vector<unsigned char> zipSingleEntry(const std::string& name, const std::string& content) {
+    std::vector<unsigned char> compressed = deflateRaw(content.data(), content.size());
+    uint32_t crc = computeCrc32(reinterpret_cast<const unsigned char*>(content.data()), content.size());
+
+    std::vector<unsigned char> zip;
+    auto header = [&](uint32_t signature, bool central) {
+        appendLE(zip, signature, 4);
+        if (central) appendLE(zip, 20, 2);
+        appendLE(zip, 20, 2);                  // 필요한 버전
+        appendLE(zip, 0, 2);                   // 플래그
+        appendLE(zip, 8, 2);                   // deflate
+        appendLE(zip, 0, 4);                   // 시간/날짜
+        appendLE(zip, crc, 4);
+        appendLE(zip, compressed.size(), 4);
+        appendLE(zip, content.size(), 4);
+        appendLE(zip, name.size(), 2);
+        appendLE(zip, 0, 2);                   // 확장 필드
+        if (central) {
+            appendLE(zip, 0, 2 + 2 + 2 + 4);   // 주석, 디스크, 내부/외부 속성
+            appendLE(zip, 0, 4);               // 로컬 헤더 위치
+        }
+        zip.insert(zip.end(), name.begin(), name.end());
+    };
+    header(0x04034b50, false);
+    zip.insert(zip.end(), compressed.begin(), compressed.end());
+    size_t directoryOffset = zip.size();
+    header(0x02014b50, true);
+    size_t directorySize = zip.size() - directoryOffset;
+    appendLE(zip, 0x06054b50, 4);
+    appendLE(zip, 0, 4);
+    appendLE(zip, 1, 2);
+    appendLE(zip, 1, 2);
+    appendLE(zip, directorySize, 4);
+    appendLE(zip, directoryOffset, 4);
+    appendLE(zip, 0, 2);
+    return zip;
+}
+
+// 객체 하나 + 빌드 항목 하나인 3MF (.rels 가 없으면 3D/3dmodel.model 을 읽는다)
+std::vector<unsigned char> toThreeMF(const Mesh& mesh, size_t& modelBytes) {
+    std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<model unit=\"millimeter\" xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+                      " <resources>\n  <object id=\"1\" type=\"model\">\n   <mesh>\n    <vertices>\n";
+    char line[160];
+    for (size_t v = 0; v < mesh.vertexCount(); v++) {
+        Vector3 p = mesh.vertex(v);
+        std::snprintf(line, sizeof(line), "     <vertex x=\"%.9g\" y=\"%.9g\" z=\"%.9g\" />\n", p.x, p.y, p.z);
+        xml += line;
+    }
+    xml += "    </vertices>\n    <triangles>\n";
+    const MeshIndex* indices = mesh.indexData();
+    for (size_t t = 0; t < mesh.triangleCount(); t++) {
+        std::snprintf(line, sizeof(line), "     <triangle v1=\"%llu\" v2=\"%llu\" v3=\"%llu\" />\n",
+                      static_cast<unsigned long long>(indices[t * 3]),
+                      static_cast<unsigned long long>(indices[t * 3 + 1]),
+                      static_cast<unsigned long long>(indices[t * 3 + 2]));
+        xml += line;
+    }
+    xml += "    </triangles>\n   </mesh>\n  </object>\n </resources>\n"
+           " <build>\n  <item objectid=\"1\" />\n </build>\n</model>\n";
+    modelBytes = xml.size();
+    return zipSingleEntry("3D/3dmodel.model", xml);
+}
+
+// 모양/크기별로 한 번만 만들고 모든 벤치마크가 공유하는 입력
+struct Fixture {
+    Mesh mesh;
+    std::vector<unsigned char> stl;
+    std::vector<double> bbox;
+    std::vector<double> heights;
+
+    // 레이어별 교차점 (CSR: intersectionStart[i] .. intersectionStart[i + 1])
+    std::vector<Vector3> intersections;
+    std::vector<size_t> intersectionStart;
+
+    LayerStore layers;
+};
+
+const Fixture& fixture(const Scenario* scenario, size_t triangles) {
+    static std::map<std::pair<const Scenario*, size_t>, std::unique_ptr<Fixture>> cache;
+    auto key = std::make_pair(scenario, triangles);
+    auto found = cache.find(key);
+    if (found != cache.end()) return *found->second;
+
+    std::unique_ptr<Fixture> f(new Fixture());
+    TestMeshOptions options;
+    options.shape = scenario->shape;
+    options.islands = scenario->islands;
+    options.triangles = triangles;
+    generateTestMesh(f->mesh, options);
+
+    // 파싱 벤치마크와 같은 float32 좌표를 쓰도록 STL 을 거쳐 다시 읽는다
+    f->stl = toBinarySTL(f->mesh);
+    loadSTL(f->stl.data(), f->stl.size(), f->mesh);
+    f->bbox = computeBoundingBox(f->mesh);
+
+    for (double z = f->bbox[2]; z <= f->bbox[5]; z += kLayerHeight) {
+        f->heights.push_back(z);
+        f->intersectionStart.push_back(f->intersections.size());
+        intersectLayer(f->mesh, z, f->intersections);
+
+        f->layers.beginLayer(z);
+        size_t begin = f->intersectionStart.back();
+        if (f->intersections.size() > begin) {
+            std::vector<Vector3> layer(f->intersections.begin() + begin, f->intersections.end());
+            buildContours(layer, f->layers.contours());
+            generateInfill(f->layers.infill(), f->bbox, kInfillDensity);
+        }
+    }
+    f->intersectionStart.push_back(f->intersections.size());
+
+    const Fixture& result = *f;
+    cache.emplace(key, std::move(f));
+    return result;
+}
+
+void setTriangleCounters(benchmark::State& state, const Fixture& f) {
+    state.counters["triangles"] = static_cast<double>(f.mesh.triangleCount());
+    state.counters["layers"] = static_cast<double>(f.heights.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * f.mesh.triangleCount()));
+}
+
+// STL 바이트 -> 병합된 인덱스 메시
+void benchParse(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    Mesh mesh;
+    for (auto _ : state) {
+        bool ok = loadSTL(f.stl.data(), f.stl.size(), mesh);
+        benchmark::DoNotOptimize(ok);
+    }
+    setTriangleCounters(state, f);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * f.stl.size()));
+}
+
+// 3MF 패키지 -> 인덱스 메시 (zip 해제 + XML 풀 파서). 처리량은 풀린 모델 XML 바이트 기준.
+void benchParse3MF(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    static std::map<const Fixture*, std::pair<std::vector<unsigned char>, size_t>> packages;
+    auto& package = packages[&f];
+    if (package.first.empty()) package.first = toThreeMF(f.mesh, package.second);
+
+    Mesh mesh;
+    for (auto _ : state) {
+        bool ok = load3MF(package.first.data(), package.first.size(), mesh);
+        benchmark::DoNotOptimize(ok);
+    }
+    setTriangleCounters(state, f);
+    state.counters["archiveBytes"] = static_cast<double>(package.first.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * package.second));
+}
+
+void benchBoundingBox(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    for (auto _ : state) {
+        std::vector<double> bbox = computeBoundingBox(f.mesh);
+        benchmark::DoNotOptimize(bbox.data());
+    }
+    setTriangleCounters(state, f);
+}
+
+// 레이어 높이별 삼각형-평면 교차
+void benchIntersect(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    std::vector<Vector3> points;
+    for (auto _ : state) {
+        for (double z : f.heights) {
+            points.clear();
+            intersectLayer(f.mesh, z, points);
+            benchmark::DoNotOptimize(points.data());
+        }
+    }
+    setTriangleCounters(state, f);
+    state.counters["intersections"] = static_cast<double>(f.intersections.size());
+}
+
+// 교차점 -> 윤곽선 폴리라인
+void benchContour(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    PolylineBuffer contours;
+    for (auto _ : state) {
+        contours.clear();
+        for (size_t i = 0; i + 1 < f.intersectionStart.size(); i++) {
+            size_t begin = f.intersectionStart[i], end = f.intersectionStart[i + 1];
+            if (begin == end) continue;
+            for (size_t p = begin; p < end; p++) {
+                contours.addPoint(f.intersections[p].x, f.intersections[p].y);
+            }
+            contours.endPolyline();
+        }
+        benchmark::DoNotOptimize(contours.pointCount());
+    }
+    state.counters["points"] = static_cast<double>(f.intersections.size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * f.intersections.size()));
+}
+
+void benchInfill(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    PolylineBuffer infill;
+    for (auto _ : state) {
+        infill.clear();
+        for (size_t i = 0; i < f.heights.size(); i++) {
+            generateInfill(infill, f.bbox, kInfillDensity);
+        }
+        benchmark::DoNotOptimize(infill.pointCount());
+    }
+    state.counters["layers"] = static_cast<double>(f.heights.size());
+}
+
+// 전체 slice() (교차 + 윤곽선 + 인필, 아레나 포함)
+void benchSlice(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    SimpleSlicer slicer;
+    slicer.setLayerHeight(kLayerHeight);
+    slicer.setInfillDensity(kInfillDensity);
+    slicer.loadSTL(f.stl.data(), f.stl.size());
+    for (auto _ : state) {
+        const LayerStore& layers = slicer.slice();
+        benchmark::DoNotOptimize(layers.layerCount());
+    }
+    setTriangleCounters(state, f);
+}
+
+// 미리 자른 레이어 -> G-code 텍스트
+void benchGCode(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    size_t bytes = 0;
+    for (auto _ : state) {
+        CountingStreamBuf sink;
+        std::ostream out(&sink);
+        GCodeWriter writer(out, kLayerHeight, kInfillDensity);
+        writer.begin();
+        for (size_t i = 0; i < f.layers.layerCount(); i++) {
+            writer.writeLayer(i, f.layers.layer(i));
+        }
+        writer.end();
+        bytes = sink.count;
+    }
+    state.counters["gcodeBytes"] = static_cast<double>(bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+// 미리 자른 레이어 -> .gcode.3mf (G-code 를 deflate + MD5 하며 패키지로). 처리량은 G-code 바이트 기준.
+void benchGCode3MF(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    SlicerSettings settings;
+    settings.layerHeight = kLayerHeight;
+    settings.infillDensity = kInfillDensity;
+    size_t gcodeBytes = 0, packageBytes = 0;
+    for (auto _ : state) {
+        CountingStreamBuf sink;
+        std::ostream out(&sink);
+        bool ok = writeGCode3MF(out, GCode3MFPlate(), settings, [&](std::ostream& gcode) {
+            GCodeWriter writer(gcode, kLayerHeight, kInfillDensity);
+            writer.begin();
+            for (size_t i = 0; i < f.layers.layerCount(); i++) {
+                writer.writeLayer(i, f.layers.layer(i));
+            }
+            writer.end();
+            gcodeBytes = static_cast<size_t>(gcode.tellp());
+        });
+        benchmark::DoNotOptimize(ok);
+        packageBytes = sink.count;
+    }
+    state.counters["gcodeBytes"] = static_cast<double>(gcodeBytes);
+    state.counters["packageBytes"] = static_cast<double>(packageBytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * gcodeBytes));
+}
+
+// 미리 자른 레이어 -> .bgcode (MeatPack + heatshrink 12/4 블록). 처리량은 G-code 바이트 기준.
+void benchBGCode(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    SlicerSettings settings;
+    settings.layerHeight = kLayerHeight;
+    settings.infillDensity = kInfillDensity;
+    size_t gcodeBytes = 0, binaryBytes = 0;
+    for (auto _ : state) {
+        CountingStreamBuf sink;
+        std::ostream out(&sink);
+        bool ok = writeBGCode(out, BGCodePlate(), settings, [&](std::ostream& gcode) {
+            GCodeWriter writer(gcode, kLayerHeight, kInfillDensity);
+            writer.begin();
+            for (size_t i = 0; i < f.layers.layerCount(); i++) {
+                writer.writeLayer(i, f.layers.layer(i));
+            }
+            writer.end();
+            gcodeBytes = static_cast<size_t>(gcode.tellp());
+        });
+        benchmark::DoNotOptimize(ok);
+        binaryBytes = sink.count;
+    }
+    state.counters["gcodeBytes"] = static_cast<double>(gcodeBytes);
+    state.counters["bgcodeBytes"] = static_cast<double>(binaryBytes);
+    state.counters["ratio"] = static_cast<double>(binaryBytes) / std::max<size_t>(1, gcodeBytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * gcodeBytes));
+}
+
+// 압축 벤치마크 입력: 미리 자른 레이어의 G-code 텍스트와 그 raw deflate 스트림 (픽스처마다 한 번)
+struct CompressionInput {
+    std::string gcode;
+    std::vector<unsigned char> compressed;
+};
+
+const CompressionInput& compressionInput(const Fixture& f) {
+    static std::map<const Fixture*, CompressionInput> inputs;
+    CompressionInput& input = inputs[&f];
+    if (input.gcode.empty()) {
+        std::ostringstream out;
+        GCodeWriter writer(out, kLayerHeight, kInfillDensity);
+        writer.begin();
+        for (size_t i = 0; i < f.layers.layerCount(); i++) {
+            writer.writeLayer(i, f.layers.layer(i));
+        }
+        writer.end();
+        input.gcode = out.str();
+        input.compressed = deflateRaw(input.gcode.data(), input.gcode.size());
+    }
+    return input;
+}
+
+void setCompressionCounters(benchmark::State& state, const CompressionInput& input, size_t compressedBytes) {
+    state.counters["gcodeBytes"] = static_cast<double>(input.gcode.size());
+    state.counters["ratio"] = static_cast<double>(compressedBytes) / std::max<size_t>(1, input.gcode.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.gcode.size()));
+}
+
+// G-code -> raw deflate (수준 6, 공용 풀에서 128KB 청크 병렬). 처리량은 압축 전 바이트 기준.
+void benchDeflate(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const CompressionInput& input = compressionInput(fixture(scenario, triangles));
+    size_t compressedBytes = 0;
+    for (auto _ : state) {
+        std::vector<unsigned char> compressed =
+            deflateRaw(input.gcode.data(), input.gcode.size(), kDeflateDefaultLevel, &ThreadPool::shared());
+        compressedBytes = compressed.size();
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    setCompressionCounters(state, input, compressedBytes);
+    state.counters["threads"] = static_cast<double>(ThreadPool::shared().size());
+}
+
+// raw deflate -> G-code (크기를 아는 zip 엔트리처럼 정확한 버퍼에 푼다)
+void benchInflate(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const CompressionInput& input = compressionInput(fixture(scenario, triangles));
+    std::vector<unsigned char> out(input.gcode.size());
+    for (auto _ : state) {
+        bool ok = inflateRaw(input.compressed.data(), input.compressed.size(), out.data(), out.size());
+        benchmark::DoNotOptimize(ok);
+    }
+    setCompressionCounters(state, input, input.compressed.size());
+}
+
+#ifdef SLICER_BENCH_ZLIB
+// 비교 기준: 단일 스레드 zlib 수준 6 (raw deflate)
+void benchDeflateZlib(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const CompressionInput& input = compressionInput(fixture(scenario, triangles));
+    std::vector<unsigned char> compressed(compressBound(static_cast<uLong>(input.gcode.size())));
+    size_t compressedBytes = 0;
+    for (auto _ : state) {
+        z_stream stream = {};
+        deflateInit2(&stream, 6, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.gcode.data()));
+        stream.avail_in = static_cast<uInt>(input.gcode.size());
+        stream.next_out = compressed.data();
+        stream.avail_out = static_cast<uInt>(compressed.size());
+        deflate(&stream, Z_FINISH);
+        compressedBytes = stream.total_out;
+        deflateEnd(&stream);
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    setCompressionCounters(state, input, compressedBytes);
+}
+
+void benchInflateZlib(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const CompressionInput& input = compressionInput(fixture(scenario, triangles));
+    std::vector<unsigned char> out(input.gcode.size());
+    for (auto _ : state) {
+        z_stream stream = {};
+        inflateInit2(&stream, -MAX_WBITS);
+        stream.next_in = const_cast<Bytef*>(input.compressed.data());
+        stream.avail_in = static_cast<uInt>(input.compressed.size());
+        stream.next_out = out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        int status = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        benchmark::DoNotOptimize(status);
+    }
+    setCompressionCounters(state, input, input.compressed.size());
+}
+#endif
+
+// 레이어 정보 JSON (getLayerInfo 의 포맷팅 부분)
+void benchLayerInfoJson(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    SimpleSlicer slicer;
+    slicer.setLayerHeight(kLayerHeight);
+    slicer.loadSTL(f.stl.data(), f.stl.size());
+    slicer.slice();
+    for (auto _ : state) {
+        std::string json = slicer.formatLayerInfo();
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.counters["layers"] = static_cast<double>(f.heights.size());
+}
+
+// 레이어별 격자 구축 + 피킹 질의 (적중률/후보 수 보고)
+void benchGridQuery(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    const size_t queriesPerLayer = 256;
+    const double radius = 1.0;
+
+    std::vector<SegmentGrid> grids(f.layers.layerCount());
+    for (size_t i = 0; i < grids.size(); i++) grids[i].build(f.layers.layer(i));
+
+    // 질의 위치는 바운딩 박스 안에서 고정 시드로 뽑는다
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> px(f.bbox[0], f.bbox[3]);
+    std::uniform_real_distribution<double> py(f.bbox[1], f.bbox[4]);
+    std::vector<double> xs(queriesPerLayer), ys(queriesPerLayer);
+    for (size_t q = 0; q < queriesPerLayer; q++) {
+        xs[q] = px(rng);
+        ys[q] = py(rng);
+    }
+
+    for (auto& grid : grids) grid.resetStats();
+    uint64_t picked = 0;
+    for (auto _ : state) {
+        for (auto& grid : grids) {
+            for (size_t q = 0; q < queriesPerLayer; q++) {
+                if (grid.nearestSegment(xs[q], ys[q], radius) >= 0) picked++;
+            }
+        }
+    }
+
+    GridQueryStats total;
+    for (const auto& grid : grids) {
+        const GridQueryStats& s = grid.stats();
+        total.queries += s.queries;
+        total.cellsVisited += s.cellsVisited;
+        total.candidatesTested += s.candidatesTested;
+        total.hits += s.hits;
+    }
+    double queries = std::max<double>(1.0, static_cast<double>(total.queries));
+    // hitRate: 셀에서 꺼낸 후보 중 실제로 질의 영역에 걸친 비율 (격자 정밀도)
+    // pickRate: 반경 안에서 선분을 찾은 질의 비율
+    state.counters["hitRate"] = total.hits / std::max<double>(1.0, static_cast<double>(total.candidatesTested));
+    state.counters["pickRate"] = picked / queries;
+    state.counters["cellsPerQuery"] = total.cellsVisited / queries;
+    state.counters["candidatesPerQuery"] = total.candidatesTested / queries;
+    state.counters["queryTime"] = benchmark::Counter(
+        static_cast<double>(total.queries), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.SetItemsProcessed(static_cast<int64_t>(total.queries));
+}
+
+void benchGridBuild(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    SegmentGrid grid;
+    size_t segments = 0;
+    for (auto _ : state) {
+        segments = 0;
+        for (size_t i = 0; i < f.layers.layerCount(); i++) {
+            grid.build(f.layers.layer(i));
+            segments += grid.segmentCount();
+        }
+    }
+    state.counters["segments"] = static_cast<double>(segments);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * segments));
+}
+
+// 메시 -> XY 발자국 (Z 축 30도 회전 투영, 볼록 껍질 + 256 칸 격자 윤곽, 공용 풀)
+void benchFootprint(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    const double c = std::cos(0.5236), s = std::sin(0.5236);
+    const double matrix[16] = {c, s, 0, 0, -s, c, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    Footprint footprint;
+    for (auto _ : state) {
+        bool ok = computeFootprint(f.mesh, matrix, footprint, FootprintOptions(), &ThreadPool::shared());
+        benchmark::DoNotOptimize(ok);
+    }
+    setTriangleCounters(state, f);
+    state.counters["hullVertices"] = static_cast<double>(footprint.hull.size());
+    state.counters["outlines"] = static_cast<double>(footprint.outlines.size());
+    state.counters["threads"] = static_cast<double>(ThreadPool::shared().size());
+}
+
+// 메시 분석: 부피/넓이/무게중심/바운딩 박스 + 열린 변/비다양체 변/퇴화 삼각형 (공용 풀)
+void benchAnalyze(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    MeshAnalysis analysis;
+    for (auto _ : state) {
+        analysis = analyzeMesh(f.mesh, &ThreadPool::shared());
+        benchmark::DoNotOptimize(analysis.volume);
+    }
+    setTriangleCounters(state, f);
+    state.counters["openEdges"] = analysis.openEdges;
+    state.counters["nonManifoldEdges"] = analysis.nonManifoldEdges;
+    state.counters["threads"] = static_cast<double>(ThreadPool::shared().size());
+}
+
+// 메시 BVH 구축 (16 칸 binned SAH, 큰 노드는 공용 풀에서 병렬 binning)
+void benchBvhBuild(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    MeshBvh bvh;
+    for (auto _ : state) {
+        bool ok = bvh.build(f.mesh, &ThreadPool::shared());
+        benchmark::DoNotOptimize(ok);
+    }
+    setTriangleCounters(state, f);
+    state.counters["nodes"] = static_cast<double>(bvh.nodeCount());
+    state.counters["depth"] = static_cast<double>(bvh.depth());
+    state.counters["bvhBytes"] = static_cast<double>(bvh.memoryBytes());
+}
+
+// BVH 일괄 광선 질의: 바운딩 박스 안팎의 임의 원점/방향 광선 64K 개 (공용 풀)
+void benchRaycast(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    MeshBvh bvh;
+    bvh.build(f.mesh, &ThreadPool::shared());
+
+    const size_t rayCount = 65536;
+    std::vector<double> rays(rayCount * 6);
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (size_t i = 0; i < rayCount; i++) {
+        for (int a = 0; a < 3; a++) {
+            double center = (f.bbox[a] + f.bbox[a + 3]) * 0.5, half = (f.bbox[a + 3] - f.bbox[a]) * 0.75;
+            rays[i * 6 + a] = center + unit(random) * half;
+            rays[i * 6 + 3 + a] = unit(random);
+        }
+    }
+    std::vector<double> hits(rayCount * kBvhHitStride);
+    for (auto _ : state) {
+        bvh.raycastBatch(rays.data(), rayCount, 0.0, hits.data(), &ThreadPool::shared());
+        benchmark::DoNotOptimize(hits.data());
+    }
+    size_t hitCount = 0;
+    for (size_t i = 0; i < rayCount; i++) hitCount += hits[i * kBvhHitStride + 1] >= 0.0;
+    setTriangleCounters(state, f);
+    state.counters["hitRate"] = static_cast<double>(hitCount) / rayCount;
+    state.counters["raysPerSecond"] = benchmark::Counter(static_cast<double>(rayCount * state.iterations()),
+                                                         benchmark::Counter::kIsRate);
+}
+
+// 자동 방향 찾기: 구면 후보 256 개 + 축 + 평면 법선을 삼각형 블록 단위로 평가 (기본 옵션, 공용 풀)
+void benchOrient(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    std::vector<OrientCandidate> candidates;
+    for (auto _ : state) {
+        candidates = findOrientations(f.mesh, OrientOptions(), &ThreadPool::shared());
+        benchmark::DoNotOptimize(candidates.data());
+    }
+    setTriangleCounters(state, f);
+    state.counters["bestScore"] = candidates.empty() ? 0.0 : candidates[0].score;
+    state.counters["threads"] = static_cast<double>(ThreadPool::shared().size());
+}
+
+// 자동 배치: 픽스처 메시 발자국 (XY 볼록 껍질) 의 크기/비율을 바꾼 부품 200 개를 350 x 350 플레이트에 (공용 풀)
+void benchArrange(benchmark::State& state, const Scenario* scenario, size_t triangles) {
+    const Fixture& f = fixture(scenario, triangles);
+    std::vector<ArrangePoint> points(f.mesh.vertexCount());
+    for (size_t i = 0; i < points.size(); i++) points[i] = {double(f.mesh.xData()[i]), double(f.mesh.yData()[i])};
+    ArrangePolygon hull = convexHull(std::move(points));
+    double width = std::max(f.bbox[3] - f.bbox[0], 1e-9), depth = std::max(f.bbox[4] - f.bbox[1], 1e-9);
+
+    const size_t partCount = 200;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> size(8.0, 28.0);
+    std::vector<ArrangePolygon> parts(partCount);
+    for (ArrangePolygon& part : parts) {
+        double sx = size(rng) / width, sy = size(rng) / depth;
+        for (const ArrangePoint& p : hull) part.push_back({p.x * sx, p.y * sy});
+    }
+
+    ArrangeSettings settings;
+    settings.plateWidth = 350.0;
+    settings.plateHeight = 350.0;
+    size_t placed = 0;
+    for (auto _ : state) {
+        std::vector<ArrangeResult> results = arrangeParts(parts, settings, &ThreadPool::shared());
+        placed = static_cast<size_t>(
+            std::count_if(results.begin(), results.end(), [](const ArrangeResult& r) { return r.placed; }));
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["parts"] = static_cast<double>(partCount);
+    state.counters["placed"] = static_cast<double>(placed);
+    state.counters["threads"] = static_cast<double>(ThreadPool::shared().size());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * partCount));
+}
+
+using BenchFunction = void (*)(benchmark::State&, const Scenario*, size_t);
+
+struct Stage {
+    const char* name;
+    BenchFunction run;
+};
+
+const Stage kStages[] = {
+    {"parse", benchParse},
+    {"parse_3mf", benchParse3MF},
+    {"bbox", benchBoundingBox},
+    {"intersect", benchIntersect},
+    {"contour", benchContour},
+    {"infill", benchInfill},
+    {"slice", benchSlice},
+    {"gcode", benchGCode},
+    {"gcode_3mf", benchGCode3MF},
+    {"bgcode", benchBGCode},
+    {"deflate", benchDeflate},
+    {"inflate", benchInflate},
+#ifdef SLICER_BENCH_ZLIB
+    {"deflate_zlib", benchDeflateZlib},
+    {"inflate_zlib", benchInflateZlib},
+#endif
+    {"json", benchLayerInfoJson},
+    {"grid_build", benchGridBuild},
+    {"grid_query", benchGridQuery},
+    {"footprint", benchFootprint},
+    {"orient", benchOrient},
+    {"analyze", benchAnalyze},
+    {"bvh", benchBvhBuild},
+    {"raycast", benchRaycast},
+    {"arrange", benchArrange},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t maxTriangles = 1000000;
+    if (const char* env = std::getenv("SLICER_BENCH_MAX_TRIANGLES")) {
+        maxTriangles = std::strtoull(env, nullptr, 10);
+    }
+
+    for (const Stage& stage : kStages) {
+        for (const Scenario& scenario : kScenarios) {
+            for (size_t triangles = 10000; triangles <= maxTriangles; triangles *= 10) {
+                std::string name = std::string(stage.name) + "/" + scenario.name + "/" +
+                                   std::to_string(triangles);
+                benchmark::RegisterBenchmark(name.c_str(), stage.run, &scenario, triangles)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
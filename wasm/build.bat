@@ -20,9 +20,13 @@ REM 빌드 디렉토리 생성
 if not exist "build" mkdir build
 cd build
 
-REM CMake 설정
+REM CMake 설정 (SLICER_TRACE 가 설정되어 있으면 Chrome 트레이스 기록 포함)
 echo 📦 CMake 설정 중...
-emcmake cmake ..
+if defined SLICER_TRACE (
+    emcmake cmake .. -DSLICER_TRACE=ON
+) else (
+    emcmake cmake ..
+)
 
 REM 빌드 실행
 echo 🔨 WASM 모듈 빌드 중...
@@ -44,6 +48,14 @@ if exist "slicer.js" if exist "slicer.wasm" (
     echo 📋 public 디렉토리로 복사 중...
     copy slicer.js ..\..\public\
     copy slicer.wasm ..\..\public\
+
+    REM pthread / 대용량 힙 변형 (있을 때만)
+    for %%V in (slicer-mt slicer-large slicer-mem64) do (
+        if exist "%%V.js" if exist "%%V.wasm" (
+            copy %%V.js ..\..\public\
+            copy %%V.wasm ..\..\public\
+        )
+    )
     
     echo 🎉 WASM Slicer가 성공적으로 빌드되었습니다!
 ) else (
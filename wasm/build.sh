@@ -20,9 +20,9 @@ fi
 mkdir -p build
 cd build
 
-# CMake 설정
+# CMake 설정 (SLICER_TRACE=1 이면 Chrome 트레이스 기록 포함)
 echo "📦 CMake 설정 중..."
-emcmake cmake ..
+emcmake cmake .. ${SLICER_TRACE:+-DSLICER_TRACE=ON}
 
 # 빌드 실행
 echo "🔨 WASM 모듈 빌드 중..."
@@ -44,6 +44,15 @@ if [ -f "slicer.js" ] && [ -f "slicer.wasm" ]; then
     echo "📋 public 디렉토리로 복사 중..."
     cp slicer.js ../../public/
     cp slicer.wasm ../../public/
+
+    # pthread / 대용량 힙 변형 (있을 때만)
+    for variant in slicer-mt slicer-large slicer-mem64; do
+        if [ -f "$variant.js" ] && [ -f "$variant.wasm" ]; then
+            echo "  - $variant: $(du -h $variant.wasm | cut -f1)"
+            cp $variant.js ../../public/
+            cp $variant.wasm ../../public/
+        fi
+    done
     
     echo "🎉 WASM Slicer가 성공적으로 빌드되었습니다!"
 else
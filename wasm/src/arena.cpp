@@ -0,0 +1,106 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+const char* sliceStageName(SliceStage stage) {
+    switch (stage) {
+        case SliceStage::Setup: return "setup";
+        case SliceStage::Intersect: return "intersect";
+        default: return "unknown";
+    }
+}
+
+Arena::Arena(size_t chunkSize) : chunkSize(chunkSize) {}
+
+Arena::~Arena() {
+    for (auto& chunk : chunks) {
+        std::free(chunk.data);
+    }
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+    ArenaStageStats& s = stats[static_cast<size_t>(currentStage)];
+    s.allocations++;
+    s.bytes += bytes;
+
+    if (current < chunks.size()) {
+        Chunk& chunk = chunks[current];
+        size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes <= chunk.size) {
+            used = offset + bytes;
+            peakUsed = std::max(peakUsed, usedBytes());
+            return chunk.data + offset;
+        }
+    }
+    return allocateSlow(bytes, alignment);
+}
+
+// 현재 청크가 부족할 때: 뒤쪽의 남는 청크를 재사용하거나 새로 받는다
+void* Arena::allocateSlow(size_t bytes, size_t alignment) {
+    size_t next = chunks.empty() ? 0 : current + 1;
+    while (next < chunks.size() && chunks[next].size < bytes + alignment) {
+        next++;
+    }
+
+    if (next == chunks.size()) {
+        size_t size = std::max(chunkSize, bytes + alignment);
+        char* data = static_cast<char*>(std::malloc(size));
+        if (!data) throw std::bad_alloc();
+        chunks.push_back({data, size});
+    } else if (next != current + 1 && !chunks.empty()) {
+        // 건너뛴 작은 청크는 뒤로 보내 순서를 유지한다
+        std::rotate(chunks.begin() + current + 1, chunks.begin() + next, chunks.begin() + next + 1);
+        next = current + 1;
+    }
+
+    current = next;
+    uintptr_t base = reinterpret_cast<uintptr_t>(chunks[current].data);
+    size_t offset = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    used = offset + bytes;
+    peakUsed = std::max(peakUsed, usedBytes());
+    return chunks[current].data + offset;
+}
+
+void Arena::reset() {
+    current = 0;
+    used = 0;
+}
+
+void Arena::rewind(const Marker& marker) {
+    current = marker.chunk;
+    used = marker.used;
+}
+
+void Arena::resetStats() {
+    for (auto& s : stats) {
+        s = ArenaStageStats();
+    }
+    resetHighWaterMark();
+}
+
+void Arena::resetHighWaterMark() {
+    peakUsed = usedBytes();
+}
+
+size_t Arena::bytesReserved() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+size_t Arena::usedBytes() const {
+    size_t total = used;
+    for (size_t i = 0; i < current && i < chunks.size(); i++) {
+        total += chunks[i].size;
+    }
+    return total;
+}
+
+Arena& Arena::local() {
+    thread_local Arena arena;
+    return arena;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 슬라이싱 단계 (할당 통계 구분용)
+// 아레나에서 임시 데이터를 받는 단계만 둔다. 윤곽선/인필은 결과를 LayerStore 에 바로 쓰므로
+// 임시 할당이 없다 (단계 시간은 SlicerStats 의 contourMs/infillMs).
+enum class SliceStage : uint8_t {
+    Setup,      // 레이어 높이 목록, 구간별 통계
+    Intersect,  // 레이어별 교차점
+    Count
+};
+
+const char* sliceStageName(SliceStage stage);
+
+// 단계별 할당 통계
+struct ArenaStageStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// 단조 증가(bump) 할당기
+// 개별 해제는 없고 reset() 으로 한 번에 되돌린다. 청크는 해제하지 않고 다음 작업에서 재사용한다.
+class Arena {
+public:
+    // 되감기 위치
+    struct Marker {
+        size_t chunk;
+        size_t used;
+    };
+
+    explicit Arena(size_t chunkSize = 256 * 1024);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // 모든 할당을 O(1) 로 되돌림
+    void reset();
+    Marker mark() const { return {current, used}; }
+    void rewind(const Marker& marker);
+
+    void setStage(SliceStage stage) { currentStage = stage; }
+    SliceStage stage() const { return currentStage; }
+
+    const ArenaStageStats& stageStats(SliceStage stage) const {
+        return stats[static_cast<size_t>(stage)];
+    }
+    void resetStats();
+    // 최대 사용량을 현재 사용량부터 다시 잰다 (할당 수 통계는 그대로)
+    void resetHighWaterMark();
+
+    // 시스템(malloc) 에서 받아온 청크 수와 총 크기
+    size_t chunkCount() const { return chunks.size(); }
+    size_t bytesReserved() const;
+    size_t highWaterMark() const { return peakUsed; }
+
+    // 현재 스레드 전용 아레나 (병렬 슬라이싱 시 스레드마다 하나)
+    static Arena& local();
+
+private:
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+
+    void* allocateSlow(size_t bytes, size_t alignment);
+    size_t usedBytes() const;
+
+    size_t chunkSize;
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+    size_t used = 0;
+    size_t peakUsed = 0;
+
+    SliceStage currentStage = SliceStage::Setup;
+    ArenaStageStats stats[static_cast<size_t>(SliceStage::Count)];
+};
+
+// 범위 동안 아레나 단계를 바꾸고 끝나면 되돌린다
+class ArenaStageScope {
+public:
+    ArenaStageScope(Arena& arena, SliceStage stage) : arena(arena), previous(arena.stage()) {
+        arena.setStage(stage);
+    }
+    ~ArenaStageScope() { arena.setStage(previous); }
+
+private:
+    Arena& arena;
+    SliceStage previous;
+};
+
+// STL 컨테이너용 할당기 어댑터 (deallocate 는 아무것도 하지 않음)
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
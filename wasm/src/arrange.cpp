@@ -0,0 +1,454 @@
+#include "arrange.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 부풀리기 전 껍질 꼭짓점 상한 (간격 팔각형을 더해도 24각형, NFP 는 48각형 이하)
+const size_t kMaxHullVertices = 16;
+
+// 간격 0 인 점/선분 발자국도 NFP 를 만들 수 있게 쓰는 최소 반지름 (mm)
+const double kMinRadius = 1e-3;
+
+const double kLengthEpsilon = 1e-7;  // 좌표 비교 (mm)
+const double kAreaEpsilon = 1e-6;    // 외적 부호 판정 (mm^2)
+
+struct Box {
+    double minX, minY, maxX, maxY;
+};
+
+double cross(const ArrangePoint& o, const ArrangePoint& a, const ArrangePoint& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+double polygonArea(const ArrangePolygon& polygon) {
+    double area = 0.0;
+    for (size_t i = 0, n = polygon.size(); i < n; i++) {
+        const ArrangePoint& a = polygon[i];
+        const ArrangePoint& b = polygon[(i + 1) % n];
+        area += a.x * b.y - a.y * b.x;
+    }
+    return area * 0.5;
+}
+
+Box boundsOf(const ArrangePolygon& polygon) {
+    Box box = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+               std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (const ArrangePoint& p : polygon) {
+        box.minX = std::min(box.minX, p.x);
+        box.minY = std::min(box.minY, p.y);
+        box.maxX = std::max(box.maxX, p.x);
+        box.maxY = std::max(box.maxY, p.y);
+    }
+    return box;
+}
+
+// 볼록 다각형을 바깥쪽으로 단순화: 넓이가 가장 적게 늘어나는 변을 양옆 변의 연장선 교점 하나로 바꾼다
+void simplifyOutward(ArrangePolygon& polygon, size_t maxVertices) {
+    while (polygon.size() > maxVertices && polygon.size() > 3) {
+        size_t n = polygon.size();
+        size_t best = n;
+        double bestArea = std::numeric_limits<double>::max();
+        ArrangePoint bestPoint = {0.0, 0.0};
+        for (size_t i = 0; i < n; i++) {
+            const ArrangePoint& a = polygon[(i + n - 1) % n];
+            const ArrangePoint& b = polygon[i];
+            const ArrangePoint& c = polygon[(i + 1) % n];
+            const ArrangePoint& d = polygon[(i + 2) % n];
+            double d1x = b.x - a.x, d1y = b.y - a.y;
+            double d2x = d.x - c.x, d2y = d.y - c.y;
+            double denominator = d1x * d2y - d1y * d2x;
+            if (denominator <= 0.0) continue;  // 양옆 변이 만나지 않는다 (합쳐서 180도 이상 꺾임)
+            double t = ((c.x - b.x) * d2y - (c.y - b.y) * d2x) / denominator;
+            ArrangePoint x = {b.x + d1x * t, b.y + d1y * t};
+            double area = std::fabs(cross(b, x, c)) * 0.5;
+            if (area < bestArea) {
+                bestArea = area;
+                best = i;
+                bestPoint = x;
+            }
+        }
+        if (best == n) break;
+        polygon[best] = bestPoint;
+        polygon.erase(polygon.begin() + static_cast<std::ptrdiff_t>((best + 1) % n));
+    }
+}
+
+// 볼록 다각형에서 일직선/중복 꼭짓점 제거 (시작 꼭짓점은 유지)
+void removeCollinear(ArrangePolygon& polygon) {
+    size_t kept = 0;
+    for (size_t i = 0; i < polygon.size(); i++) {
+        while (kept >= 2 && cross(polygon[kept - 2], polygon[kept - 1], polygon[i]) <= 1e-9) kept--;
+        polygon[kept++] = polygon[i];
+    }
+    while (kept >= 3 && cross(polygon[kept - 2], polygon[kept - 1], polygon[0]) <= 1e-9) kept--;
+    polygon.resize(kept);
+}
+
+// 가장 아래 (같으면 왼쪽) 꼭짓점부터 시작하도록 돌린다 (민코프스키 합의 입력 조건)
+void rotateToBottom(ArrangePolygon& polygon) {
+    auto bottom = std::min_element(polygon.begin(), polygon.end(), [](const ArrangePoint& a, const ArrangePoint& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+    std::rotate(polygon.begin(), bottom, polygon.end());
+}
+
+// 볼록 다각형 두 개의 민코프스키 합 (둘 다 반시계, 가장 아래 꼭짓점부터). 변을 각도 순으로 병합해 O(n + m).
+void minkowskiSum(const ArrangePolygon& a, const ArrangePolygon& b, ArrangePolygon& out) {
+    out.clear();
+    size_t n = a.size(), m = b.size(), i = 0, j = 0;
+    while (i < n || j < m) {
+        const ArrangePoint& pa = a[i % n];
+        const ArrangePoint& pb = b[j % m];
+        out.push_back({pa.x + pb.x, pa.y + pb.y});
+        if (i == n) {
+            j++;
+        } else if (j == m) {
+            i++;
+        } else {
+            const ArrangePoint& na = a[(i + 1) % n];
+            const ArrangePoint& nb = b[(j + 1) % m];
+            double c = (na.x - pa.x) * (nb.y - pb.y) - (na.y - pa.y) * (nb.x - pb.x);
+            if (c >= 0.0) i++;
+            if (c <= 0.0) j++;
+        }
+    }
+    removeCollinear(out);
+}
+
+// 점이 볼록 다각형 안쪽 (경계 제외) 에 있는지. 닿아 있는 위치는 놓을 수 있다.
+bool strictlyInside(const ArrangePoint* polygon, size_t n, const ArrangePoint& q) {
+    for (size_t i = 0; i < n; i++) {
+        if (cross(polygon[i], polygon[i + 1 == n ? 0 : i + 1], q) <= kAreaEpsilon) return false;
+    }
+    return true;
+}
+
+// 부품 하나의 후보 회전
+struct Orientation {
+    double angle = 0.0;
+    Box body = {0, 0, 0, 0};  // 부풀리기 전 회전한 껍질의 범위 (플레이트 경계는 간격 없이 맞춘다)
+    ArrangePolygon inflated;  // 회전 + 간격 / 2 팔각형, 가장 아래 꼭짓점부터
+    ArrangePolygon negated;   // -inflated (NFP = 놓인 부품 + negated)
+    Box inflatedBox = {0, 0, 0, 0};
+};
+
+struct Part {
+    ArrangePolygon hull;
+    double area = 0.0;
+    std::vector<Orientation> orientations;
+};
+
+struct PlacedPart {
+    ArrangePolygon shape;  // 놓인 위치로 옮긴 inflated
+    Box box;
+};
+
+// 회전 하나를 평가하는 작업 공간 (부품마다 재사용)
+struct RotationScratch {
+    std::vector<ArrangePoint> nfpPoints;
+    std::vector<size_t> nfpStart;
+    std::vector<Box> nfpBox;
+    ArrangePolygon sum;
+    std::vector<ArrangePoint> candidates;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+    std::vector<uint32_t> cellFill;
+
+    bool found = false;
+    ArrangePoint best = {0.0, 0.0};
+};
+
+// 아래-왼쪽 순서 (y 가 거의 같으면 x)
+bool lowerLeft(const ArrangePoint& a, const ArrangePoint& b) {
+    if (std::fabs(a.y - b.y) > kLengthEpsilon) return a.y < b.y;
+    return a.x < b.x - kLengthEpsilon;
+}
+
+void addOrientation(Part& part, double angle, double radius) {
+    Orientation o;
+    o.angle = angle;
+    double c = std::cos(angle), s = std::sin(angle);
+    ArrangePolygon body;
+    body.reserve(part.hull.size());
+    for (const ArrangePoint& p : part.hull) body.push_back({p.x * c - p.y * s, p.x * s + p.y * c});
+    o.body = boundsOf(body);
+
+    if (radius > 0.0) {
+        // 반지름 radius 원을 감싸는 팔각형 (회전과 무관하게 축 정렬)
+        ArrangePolygon octagon;
+        double r = radius / std::cos(kPi / 8.0);
+        for (int k = 0; k < 8; k++) {
+            double a = (k + 0.5) * kPi / 4.0;
+            octagon.push_back({r * std::cos(a), r * std::sin(a)});
+        }
+        rotateToBottom(octagon);
+        if (body.size() >= 3) {
+            rotateToBottom(body);
+            minkowskiSum(body, octagon, o.inflated);
+        } else {
+            // 점/선분 발자국: 끝점마다 팔각형을 옮긴 점들의 껍질
+            std::vector<ArrangePoint> points;
+            for (const ArrangePoint& p : body) {
+                for (const ArrangePoint& q : octagon) points.push_back({p.x + q.x, p.y + q.y});
+            }
+            o.inflated = convexHull(std::move(points));
+        }
+    } else {
+        o.inflated = body;
+    }
+    rotateToBottom(o.inflated);
+    o.inflatedBox = boundsOf(o.inflated);
+
+    o.negated.reserve(o.inflated.size());
+    for (const ArrangePoint& p : o.inflated) o.negated.push_back({-p.x, -p.y});
+    rotateToBottom(o.negated);
+
+    part.orientations.push_back(std::move(o));
+}
+
+// 이미 놓인 부품들 사이에서 o 를 놓을 가장 아래-왼쪽 기준점 찾기
+void evaluateOrientation(const Orientation& o, const std::vector<PlacedPart>& placed, const ArrangeSettings& settings,
+                         RotationScratch& scratch) {
+    scratch.found = false;
+
+    // IFP: 기준점이 있을 수 있는 플레이트 안쪽 사각형
+    Box fit = {-settings.plateWidth * 0.5 - o.body.minX, -settings.plateHeight * 0.5 - o.body.minY,
+               settings.plateWidth * 0.5 - o.body.maxX, settings.plateHeight * 0.5 - o.body.maxY};
+    if (fit.minX > fit.maxX + kLengthEpsilon || fit.minY > fit.maxY + kLengthEpsilon) return;
+    fit.maxX = std::max(fit.maxX, fit.minX);
+    fit.maxY = std::max(fit.maxY, fit.minY);
+
+    // IFP 와 겹치는 NFP 만 만든다
+    scratch.nfpPoints.clear();
+    scratch.nfpStart.clear();
+    scratch.nfpBox.clear();
+    for (const PlacedPart& other : placed) {
+        Box reach = {other.box.minX - o.inflatedBox.maxX, other.box.minY - o.inflatedBox.maxY,
+                     other.box.maxX - o.inflatedBox.minX, other.box.maxY - o.inflatedBox.minY};
+        if (reach.maxX <= fit.minX || reach.minX >= fit.maxX || reach.maxY <= fit.minY || reach.minY >= fit.maxY) {
+            continue;
+        }
+        minkowskiSum(other.shape, o.negated, scratch.sum);
+        if (scratch.sum.size() < 3) continue;
+        scratch.nfpStart.push_back(scratch.nfpPoints.size());
+        scratch.nfpPoints.insert(scratch.nfpPoints.end(), scratch.sum.begin(), scratch.sum.end());
+        scratch.nfpBox.push_back(boundsOf(scratch.sum));
+    }
+    size_t nfpCount = scratch.nfpStart.size();
+    scratch.nfpStart.push_back(scratch.nfpPoints.size());
+
+    // 후보: IFP 모서리, IFP 안의 NFP 꼭짓점, NFP 변과 IFP 경계선의 교점
+    std::vector<ArrangePoint>& candidates = scratch.candidates;
+    candidates.clear();
+    candidates.push_back({fit.minX, fit.minY});
+    candidates.push_back({fit.maxX, fit.minY});
+    candidates.push_back({fit.minX, fit.maxY});
+    candidates.push_back({fit.maxX, fit.maxY});
+    auto inFit = [&](const ArrangePoint& p) {
+        return p.x >= fit.minX - kLengthEpsilon && p.x <= fit.maxX + kLengthEpsilon &&
+               p.y >= fit.minY - kLengthEpsilon && p.y <= fit.maxY + kLengthEpsilon;
+    };
+    auto clampToFit = [&](ArrangePoint p) {
+        p.x = std::min(std::max(p.x, fit.minX), fit.maxX);
+        p.y = std::min(std::max(p.y, fit.minY), fit.maxY);
+        return p;
+    };
+    for (size_t k = 0; k < nfpCount; k++) {
+        const ArrangePoint* polygon = scratch.nfpPoints.data() + scratch.nfpStart[k];
+        size_t n = scratch.nfpStart[k + 1] - scratch.nfpStart[k];
+        for (size_t i = 0; i < n; i++) {
+            const ArrangePoint& a = polygon[i];
+            const ArrangePoint& b = polygon[i + 1 == n ? 0 : i + 1];
+            if (inFit(a)) candidates.push_back(clampToFit(a));
+            // 수직선 x = fit.minX / fit.maxX
+            for (double x : {fit.minX, fit.maxX}) {
+                if ((a.x - x) * (b.x - x) < 0.0) {
+                    ArrangePoint p = {x, a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x)};
+                    if (inFit(p)) candidates.push_back(clampToFit(p));
+                }
+            }
+            // 수평선 y = fit.minY / fit.maxY
+            for (double y : {fit.minY, fit.maxY}) {
+                if ((a.y - y) * (b.y - y) < 0.0) {
+                    ArrangePoint p = {a.x + (b.x - a.x) * (y - a.y) / (b.y - a.y), y};
+                    if (inFit(p)) candidates.push_back(clampToFit(p));
+                }
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const ArrangePoint& a, const ArrangePoint& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+
+    // NFP 범위를 IFP 위의 균일 격자에 등록 (CSR)
+    size_t grid = std::max<size_t>(1, std::min<size_t>(64, static_cast<size_t>(std::sqrt(double(nfpCount)) * 2.0)));
+    double cellW = std::max(fit.maxX - fit.minX, kLengthEpsilon) / grid;
+    double cellH = std::max(fit.maxY - fit.minY, kLengthEpsilon) / grid;
+    auto cellX = [&](double x) {
+        double c = std::floor((x - fit.minX) / cellW);
+        return static_cast<size_t>(std::min(std::max(c, 0.0), double(grid - 1)));
+    };
+    auto cellY = [&](double y) {
+        double c = std::floor((y - fit.minY) / cellH);
+        return static_cast<size_t>(std::min(std::max(c, 0.0), double(grid - 1)));
+    };
+    size_t cells = grid * grid;
+    scratch.cellStart.assign(cells + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            for (size_t c = 0; c < cells; c++) scratch.cellStart[c + 1] += scratch.cellStart[c];
+            scratch.cellItems.resize(scratch.cellStart[cells]);
+            scratch.cellFill.assign(scratch.cellStart.begin(), scratch.cellStart.end() - 1);
+        }
+        for (size_t k = 0; k < nfpCount; k++) {
+            const Box& box = scratch.nfpBox[k];
+            size_t x0 = cellX(box.minX), x1 = cellX(box.maxX), y0 = cellY(box.minY), y1 = cellY(box.maxY);
+            for (size_t cy = y0; cy <= y1; cy++) {
+                for (size_t cx = x0; cx <= x1; cx++) {
+                    size_t cell = cy * grid + cx;
+                    if (pass == 0) {
+                        scratch.cellStart[cell + 1]++;
+                    } else {
+                        scratch.cellItems[scratch.cellFill[cell]++] = static_cast<uint32_t>(k);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const ArrangePoint& p : candidates) {
+        size_t cell = cellY(p.y) * grid + cellX(p.x);
+        bool blocked = false;
+        for (uint32_t s = scratch.cellStart[cell]; s < scratch.cellStart[cell + 1] && !blocked; s++) {
+            uint32_t k = scratch.cellItems[s];
+            const Box& box = scratch.nfpBox[k];
+            if (p.x <= box.minX || p.x >= box.maxX || p.y <= box.minY || p.y >= box.maxY) continue;
+            blocked = strictlyInside(scratch.nfpPoints.data() + scratch.nfpStart[k],
+                                     scratch.nfpStart[k + 1] - scratch.nfpStart[k], p);
+        }
+        if (!blocked) {
+            scratch.found = true;
+            scratch.best = p;
+            return;
+        }
+    }
+}
+
+} // namespace
+
+ArrangePolygon convexHull(std::vector<ArrangePoint> points) {
+    std::sort(points.begin(), points.end(), [](const ArrangePoint& a, const ArrangePoint& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end(),
+                             [](const ArrangePoint& a, const ArrangePoint& b) { return a.x == b.x && a.y == b.y; }),
+                 points.end());
+    if (points.size() < 3) return points;
+
+    ArrangePolygon hull(points.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0) k--;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0) k--;
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+std::vector<ArrangeResult> arrangeParts(const std::vector<ArrangePolygon>& parts, const ArrangeSettings& settings,
+                                        ThreadPool* pool) {
+    std::vector<ArrangeResult> results(parts.size());
+    size_t rotations = static_cast<size_t>(std::max(1, settings.rotations));
+    double radius = std::max(0.0, settings.spacing * 0.5);
+
+    // 부품별 껍질과 회전 후보 (부품끼리 독립이라 병렬)
+    std::vector<Part> shapes(parts.size());
+    auto prepare = [&](size_t i) {
+        Part& part = shapes[i];
+        part.hull = convexHull(parts[i]);
+        if (part.hull.empty()) return;
+        simplifyOutward(part.hull, kMaxHullVertices);
+        part.area = std::fabs(polygonArea(part.hull));
+        double r = part.hull.size() < 3 ? std::max(radius, kMinRadius) : radius;
+        for (size_t k = 0; k < rotations; k++) addOrientation(part, 2.0 * kPi * k / rotations, r);
+    };
+    if (pool) {
+        pool->parallelFor(parts.size(), prepare);
+    } else {
+        for (size_t i = 0; i < parts.size(); i++) prepare(i);
+    }
+
+    // 큰 부품부터 (같으면 입력 순서)
+    std::vector<size_t> order(parts.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return shapes[a].area > shapes[b].area; });
+
+    std::vector<PlacedPart> placed;
+    placed.reserve(parts.size());
+    std::vector<Box> placedBodies;
+    std::vector<RotationScratch> scratch(rotations);
+
+    for (size_t index : order) {
+        const Part& part = shapes[index];
+        if (part.orientations.empty()) continue;
+
+        auto evaluate = [&](size_t k) { evaluateOrientation(part.orientations[k], placed, settings, scratch[k]); };
+        if (pool && rotations > 1) {
+            pool->parallelFor(rotations, evaluate);
+        } else {
+            for (size_t k = 0; k < rotations; k++) evaluate(k);
+        }
+
+        // 가장 아래-왼쪽 위치의 회전 (같으면 작은 각도)
+        size_t best = rotations;
+        for (size_t k = 0; k < rotations; k++) {
+            if (!scratch[k].found) continue;
+            if (best == rotations || lowerLeft(scratch[k].best, scratch[best].best)) best = k;
+        }
+        if (best == rotations) continue;
+
+        const Orientation& o = part.orientations[best];
+        ArrangePoint at = scratch[best].best;
+        PlacedPart p;
+        p.shape.reserve(o.inflated.size());
+        for (const ArrangePoint& q : o.inflated) p.shape.push_back({q.x + at.x, q.y + at.y});
+        p.box = {o.inflatedBox.minX + at.x, o.inflatedBox.minY + at.y, o.inflatedBox.maxX + at.x,
+                 o.inflatedBox.maxY + at.y};
+        placed.push_back(std::move(p));
+        placedBodies.push_back({o.body.minX + at.x, o.body.minY + at.y, o.body.maxX + at.x, o.body.maxY + at.y});
+
+        ArrangeResult& result = results[index];
+        result.placed = true;
+        result.x = at.x;
+        result.y = at.y;
+        result.rotation = o.angle;
+    }
+
+    if (settings.alignToCenter && !placedBodies.empty()) {
+        Box all = placedBodies[0];
+        for (const Box& box : placedBodies) {
+            all.minX = std::min(all.minX, box.minX);
+            all.minY = std::min(all.minY, box.minY);
+            all.maxX = std::max(all.maxX, box.maxX);
+            all.maxY = std::max(all.maxY, box.maxY);
+        }
+        double dx = -(all.minX + all.maxX) * 0.5;
+        double dy = -(all.minY + all.maxY) * 0.5;
+        for (ArrangeResult& result : results) {
+            if (!result.placed) continue;
+            result.x += dx;
+            result.y += dy;
+        }
+    }
+    return results;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <vector>
+
+// 플레이트 자동 배치 (no-fit polygon + bottom-left-fill)
+// 부품마다 발자국(모델 원점 기준 XY 점)의 볼록 껍질을 간격 / 2 만큼 부풀려 쓰고,
+// 큰 부품부터 차례로 이미 놓인 부품들과의 NFP 밖, 플레이트 안쪽 영역(IFP) 에서 가장 아래-왼쪽 점에 놓는다.
+// 후보 회전은 ThreadPool 에서 동시에 평가하며, 결과는 스레드 수와 무관하게 같다.
+
+struct ArrangePoint {
+    double x, y;
+};
+
+using ArrangePolygon = std::vector<ArrangePoint>;
+
+struct ArrangeSettings {
+    double plateWidth = 220.0;   // 플레이트 중심이 원점
+    double plateHeight = 220.0;
+    double spacing = 2.0;        // 부품 사이 최소 간격 (mm)
+    int rotations = 4;           // 후보 회전 수 (360 / rotations 간격, 1 = 회전 안 함)
+    bool alignToCenter = false;  // 배치한 부품 묶음을 플레이트 가운데로 옮긴다
+};
+
+// 부품 원점을 (x, y) 로 옮기기 전에 원점 기준으로 rotation (라디안, 반시계) 만큼 돌린다
+struct ArrangeResult {
+    bool placed = false;  // false 면 플레이트에 들어가지 않음 (x, y, rotation 은 0)
+    double x = 0.0;
+    double y = 0.0;
+    double rotation = 0.0;
+};
+
+// Andrew monotone chain, 반시계 방향 (일직선 점 제외). 점이 3개 미만이거나 넓이가 0 이면 그대로에 가깝게 돌려준다.
+ArrangePolygon convexHull(std::vector<ArrangePoint> points);
+
+// parts[i] 는 부품 i 의 발자국 점 (순서 무관). 결과는 parts 와 같은 순서.
+std::vector<ArrangeResult> arrangeParts(const std::vector<ArrangePolygon>& parts, const ArrangeSettings& settings,
+                                        ThreadPool* pool = nullptr);
@@ -0,0 +1,229 @@
+#include "bgcode_writer.h"
+
+#include "deflate.h"
+#include "heatshrink.h"
+#include "meatpack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <streambuf>
+
+namespace {
+
+const uint32_t kMagic = 0x45444347;  // "GCDE"
+const uint32_t kVersion = 1;
+const uint16_t kChecksumCrc32 = 1;
+
+const uint16_t kEncodingIni = 0;
+const uint16_t kEncodingMeatPack = 1;
+const uint16_t kEncodingMeatPackComments = 2;
+const uint16_t kThumbnailPng = 0;
+
+// G-code 블록 하나에 담는 텍스트 (libbgcode 와 같은 64KB)
+const size_t kGCodeBlockSize = 65535;
+const size_t kGCodeBufferSize = 64 * 1024;
+
+void putUint16LE(std::vector<unsigned char>& out, uint16_t value) {
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void putUint32LE(std::vector<unsigned char>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+}
+
+uint32_t readUint32BE(const unsigned char* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+// G-code 스트림: 버퍼가 찰 때마다 BGCodeWriter 로 넘긴다
+class GCodeBlockBuf : public std::streambuf {
+public:
+    explicit GCodeBlockBuf(BGCodeWriter& writer) : writer(writer), buffer(kGCodeBufferSize) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    bool ok() const { return !failed; }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!flushBuffer()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flushBuffer() ? 0 : -1; }
+
+    // tellp() 용 (G-code 크기 통계)
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out)) return pos_type(off_type(-1));
+        return pos_type(static_cast<off_type>(flushed + (pptr() - pbase())));
+    }
+
+private:
+    bool flushBuffer() {
+        size_t size = static_cast<size_t>(pptr() - pbase());
+        if (size > 0 && !failed) {
+            failed = !writer.writeGCode(pbase(), size);
+            flushed += size;
+        }
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return !failed;
+    }
+
+    BGCodeWriter& writer;
+    std::vector<char> buffer;
+    size_t flushed = 0;
+    bool failed = false;
+};
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+std::string formatNumber(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", value);
+    return text;
+}
+
+} // namespace
+
+BGCodeWriter::BGCodeWriter(std::ostream& out, const BGCodeOptions& options) : out(out), options(options) {
+    std::vector<unsigned char> header;
+    putUint32LE(header, kMagic);
+    putUint32LE(header, kVersion);
+    putUint16LE(header, kChecksumCrc32);
+    emit(header.data(), header.size());
+}
+
+bool BGCodeWriter::fail(const std::string& message) {
+    if (lastError.empty()) lastError = message;
+    return false;
+}
+
+bool BGCodeWriter::emit(const void* data, size_t size) {
+    if (!lastError.empty()) return false;
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) return fail("bgcode output write failed");
+    offset += size;
+    return true;
+}
+
+// 블록 헤더 (압축했을 때만 압축 크기) + 파라미터 + 데이터 + 앞 세 부분의 CRC-32
+bool BGCodeWriter::writeBlock(BGCodeBlockType type, BGCodeCompression compression,
+                              const std::vector<unsigned char>& params, const unsigned char* data, size_t size,
+                              size_t uncompressedSize) {
+    if (size > 0xFFFFFFFFu || uncompressedSize > 0xFFFFFFFFu) return fail("bgcode block too large");
+    block.clear();
+    putUint16LE(block, static_cast<uint16_t>(type));
+    putUint16LE(block, static_cast<uint16_t>(compression));
+    putUint32LE(block, static_cast<uint32_t>(uncompressedSize));
+    if (compression != BGCodeCompression::None) putUint32LE(block, static_cast<uint32_t>(size));
+    block.insert(block.end(), params.begin(), params.end());
+    block.insert(block.end(), data, data + size);
+    putUint32LE(block, computeCrc32(block.data(), block.size()));
+    return emit(block.data(), block.size());
+}
+
+bool BGCodeWriter::addMetadata(BGCodeBlockType type, const BGCodeMetadata& entries) {
+    std::string ini;
+    for (const auto& entry : entries) ini += entry.first + "=" + entry.second + "\n";
+    std::vector<unsigned char> params;
+    putUint16LE(params, kEncodingIni);
+    return writeBlock(type, BGCodeCompression::None, params, reinterpret_cast<const unsigned char*>(ini.data()),
+                      ini.size(), ini.size());
+}
+
+bool BGCodeWriter::addThumbnailPng(const std::string& png) {
+    // 크기는 IHDR 에서 읽는다 (서명 8바이트 + 길이 4 + "IHDR" 뒤의 너비/높이)
+    static const unsigned char kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(png.data());
+    if (png.size() < 24 || !std::equal(kSignature, kSignature + 8, p) || png.compare(12, 4, "IHDR") != 0) {
+        return fail("thumbnail is not a PNG");
+    }
+    uint32_t width = readUint32BE(p + 16);
+    uint32_t height = readUint32BE(p + 20);
+    if (width > 0xFFFF || height > 0xFFFF) return fail("thumbnail too large");
+
+    std::vector<unsigned char> params;
+    putUint16LE(params, kThumbnailPng);
+    putUint16LE(params, static_cast<uint16_t>(width));
+    putUint16LE(params, static_cast<uint16_t>(height));
+    return writeBlock(BGCodeBlockType::Thumbnail, BGCodeCompression::None, params, p, png.size(), png.size());
+}
+
+bool BGCodeWriter::writeGCode(const char* text, size_t size) {
+    gcodeIn += size;
+    pending.insert(pending.end(), text, text + size);
+    while (pending.size() >= kGCodeBlockSize) {
+        // 마지막 줄 끝에서 자른다 (64KB 넘는 한 줄은 그대로 자름)
+        size_t cut = kGCodeBlockSize;
+        while (cut > 0 && pending[cut - 1] != '\n') cut--;
+        if (!flushGCode(cut > 0 ? cut : kGCodeBlockSize)) return false;
+    }
+    return true;
+}
+
+bool BGCodeWriter::finish() {
+    if (!pending.empty() && !flushGCode(pending.size())) return false;
+    out.flush();
+    return static_cast<bool>(out) || fail("bgcode output write failed");
+}
+
+// pending 앞 size 바이트 -> MeatPack -> heatshrink. 압축이 커지면 그 블록만 압축하지 않는다.
+bool BGCodeWriter::flushGCode(size_t size) {
+    encoded.clear();
+    meatpackEncode(pending.data(), size, options.keepComments, encoded);
+    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(size));
+
+    BGCodeCompression compression = options.compression;
+    const std::vector<unsigned char>* data = &encoded;
+    if (compression == BGCodeCompression::Heatshrink11 || compression == BGCodeCompression::Heatshrink12) {
+        int windowBits = compression == BGCodeCompression::Heatshrink11 ? 11 : 12;
+        compressed.clear();
+        heatshrinkCompress(encoded.data(), encoded.size(), windowBits, 4, compressed);
+        if (compressed.size() < encoded.size()) {
+            data = &compressed;
+        } else {
+            compression = BGCodeCompression::None;
+        }
+    } else {
+        compression = BGCodeCompression::None;
+    }
+
+    std::vector<unsigned char> params;
+    putUint16LE(params, options.keepComments ? kEncodingMeatPackComments : kEncodingMeatPack);
+    return writeBlock(BGCodeBlockType::GCode, compression, params, data->data(), data->size(), encoded.size());
+}
+
+bool writeBGCode(std::ostream& out, const BGCodePlate& plate, const SlicerSettings& settings,
+                 const std::function<void(std::ostream&)>& writeGCode, std::string* error,
+                 const BGCodeOptions& options) {
+    BGCodeWriter writer(out, options);
+    BGCodeMetadata slicerMetadata = {
+        {"layer_height", formatNumber(settings.layerHeight)},
+        {"fill_density", formatNumber(settings.infillDensity) + "%"},
+    };
+    bool ok = writer.addMetadata(BGCodeBlockType::FileMetadata, {{"Producer", "3d_print-slicer"}}) &&
+              writer.addMetadata(BGCodeBlockType::PrinterMetadata, plate.printerMetadata);
+    for (size_t i = 0; ok && i < plate.thumbnailsPng.size(); i++) ok = writer.addThumbnailPng(plate.thumbnailsPng[i]);
+    ok = ok && writer.addMetadata(BGCodeBlockType::PrintMetadata, plate.printMetadata) &&
+         writer.addMetadata(BGCodeBlockType::SlicerMetadata, slicerMetadata);
+    if (!ok) return fail(error, writer.error());
+
+    {
+        GCodeBlockBuf buffer(writer);
+        std::ostream gcode(&buffer);
+        writeGCode(gcode);
+        gcode.flush();
+        if (!buffer.ok() || !gcode) return fail(error, writer.error().empty() ? "G-code write failed" : writer.error());
+    }
+    if (!writer.finish()) return fail(error, writer.error());
+    return true;
+}
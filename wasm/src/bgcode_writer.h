@@ -0,0 +1,90 @@
+#pragma once
+
+#include "slicer_settings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 바이너리 G-code (.bgcode, libbgcode 형식 버전 1)
+// 파일 헤더 뒤에 블록이 이어진다: [헤더][파라미터][데이터][CRC-32]. 블록 순서는 형식이 정해 두었다:
+// 파일 메타데이터 → 프린터 메타데이터 → 썸네일 → 인쇄 메타데이터 → 슬라이서 메타데이터 → G-code 블록들.
+// 메타데이터는 INI ("key=value\n") 로 압축하지 않고, G-code 는 MeatPack 으로 묶은 뒤 heatshrink 로 압축한다.
+
+enum class BGCodeBlockType : uint16_t {
+    FileMetadata = 0,
+    GCode = 1,
+    SlicerMetadata = 2,
+    PrinterMetadata = 3,
+    PrintMetadata = 4,
+    Thumbnail = 5,
+};
+
+enum class BGCodeCompression : uint16_t {
+    None = 0,
+    Deflate = 1,  // 쓰지 않음 (읽는 쪽 호환용 값)
+    Heatshrink11 = 2,
+    Heatshrink12 = 3,
+};
+
+struct BGCodeOptions {
+    BGCodeCompression compression = BGCodeCompression::Heatshrink12;
+    bool keepComments = false;  // true = MeatPackComments (주석 유지), false = MeatPack (주석 삭제)
+};
+
+using BGCodeMetadata = std::vector<std::pair<std::string, std::string>>;
+
+// 블록 단위로 순차 출력 (탐색할 수 없는 스트림도 됨). G-code 는 줄 경계에서 64KB 이하 블록으로 나눠
+// 버퍼가 찰 때마다 바로 인코딩해 쓰므로 메모리는 블록 하나 크기만 쓴다.
+class BGCodeWriter {
+public:
+    explicit BGCodeWriter(std::ostream& out, const BGCodeOptions& options = BGCodeOptions());
+
+    bool addMetadata(BGCodeBlockType type, const BGCodeMetadata& entries);
+    bool addThumbnailPng(const std::string& png);
+
+    // G-code 텍스트를 이어서 받는다 (줄 중간에서 끊겨도 된다)
+    bool writeGCode(const char* text, size_t size);
+
+    // 남은 G-code 를 마지막 블록으로 쓴다
+    bool finish();
+
+    const std::string& error() const { return lastError; }
+    uint64_t bytesWritten() const { return offset; }
+    uint64_t gcodeBytes() const { return gcodeIn; }
+
+private:
+    bool writeBlock(BGCodeBlockType type, BGCodeCompression compression, const std::vector<unsigned char>& params,
+                    const unsigned char* data, size_t size, size_t uncompressedSize);
+    bool flushGCode(size_t size);
+    bool emit(const void* data, size_t size);
+    bool fail(const std::string& message);
+
+    std::ostream& out;
+    BGCodeOptions options;
+    uint64_t offset = 0;
+    uint64_t gcodeIn = 0;
+    std::string lastError;
+
+    std::vector<char> pending;  // 아직 블록으로 쓰지 않은 G-code
+    std::vector<unsigned char> encoded;
+    std::vector<unsigned char> compressed;
+    std::vector<unsigned char> block;
+};
+
+// .bgcode 에 넣을 자료 (모두 선택)
+struct BGCodePlate {
+    std::vector<std::string> thumbnailsPng;
+    BGCodeMetadata printerMetadata;  // printer_model, nozzle_diameter 등
+    BGCodeMetadata printMetadata;
+};
+
+// 파일 전체를 순차로 쓴다. writeGCode 가 받은 스트림의 G-code 는 만들어지는 대로 블록으로 인코딩된다.
+// 실패하면 false 와 함께 error 에 이유를 적는다.
+bool writeBGCode(std::ostream& out, const BGCodePlate& plate, const SlicerSettings& settings,
+                 const std::function<void(std::ostream&)>& writeGCode, std::string* error = nullptr,
+                 const BGCodeOptions& options = BGCodeOptions());
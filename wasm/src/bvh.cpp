@@ -0,0 +1,558 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int kBins = 16;
+const uint32_t kMaxLeaf = 8;         // SAH 가 리프가 낫다고 해도 이보다 많으면 나눈다
+const uint32_t kMinLeaf = 2;         // 이하이면 항상 리프
+const float kTraversalCost = 2.0f;   // 삼각형 교차 비용 대비 노드 방문 비용
+const int kMaxSahDepth = 48;         // 이보다 깊으면 개수 중앙 분할 (순회 스택 한계 보장)
+const int kStackSize = 128;
+const size_t kParallelRange = 1 << 16;  // 이보다 큰 노드만 binning 을 병렬로
+const size_t kChunk = 1 << 14;
+const size_t kQueryChunk = 64;
+
+const float kInf = std::numeric_limits<float>::infinity();
+
+struct Box {
+    float lo[3] = {kInf, kInf, kInf};
+    float hi[3] = {-kInf, -kInf, -kInf};
+
+    void grow(float x, float y, float z) {
+        lo[0] = std::min(lo[0], x), hi[0] = std::max(hi[0], x);
+        lo[1] = std::min(lo[1], y), hi[1] = std::max(hi[1], y);
+        lo[2] = std::min(lo[2], z), hi[2] = std::max(hi[2], z);
+    }
+    void merge(const Box& other) {
+        for (int a = 0; a < 3; a++) {
+            lo[a] = std::min(lo[a], other.lo[a]);
+            hi[a] = std::max(hi[a], other.hi[a]);
+        }
+    }
+    float area() const {
+        float dx = hi[0] - lo[0], dy = hi[1] - lo[1], dz = hi[2] - lo[2];
+        if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+};
+
+// 노드 범위의 삼각형 경계 + 중심 경계
+struct RangeBounds {
+    Box bounds, centroids;
+};
+
+struct Bin {
+    Box box;
+    uint32_t count = 0;
+};
+
+struct BinSet {
+    Bin bins[3][kBins];
+};
+
+// 구축용 삼각형 자료 (메시 순서): 경계 상자 6 개 + 중심 3 개
+struct BuildTriangles {
+    std::vector<float> bounds;     // lo xyz, hi xyz
+    std::vector<float> centroids;  // xyz
+};
+
+template <typename T, typename Body, typename Merge>
+T reduceRange(ThreadPool* pool, size_t begin, size_t end, const Body& body, const Merge& merge) {
+    size_t count = end - begin;
+    T result;
+    if (!pool || pool->size() <= 1 || count < kParallelRange) {
+        body(begin, end, result);
+        return result;
+    }
+    size_t chunks = (count + kChunk - 1) / kChunk;
+    std::vector<T> partial(chunks);
+    pool->parallelFor(chunks, [&](size_t c) {
+        size_t b = begin + c * kChunk;
+        body(b, std::min(end, b + kChunk), partial[c]);
+    });
+    for (const T& p : partial) merge(result, p);
+    return result;
+}
+
+template <typename Body>
+void forEachChunk(ThreadPool* pool, size_t count, size_t chunk, const Body& body) {
+    size_t chunks = (count + chunk - 1) / chunk;
+    auto run = [&](size_t c) { body(c * chunk, std::min(count, (c + 1) * chunk)); };
+    if (pool && pool->size() > 1 && chunks > 1) {
+        pool->parallelFor(chunks, run);
+    } else {
+        for (size_t c = 0; c < chunks; c++) run(c);
+    }
+}
+
+inline int binOf(float c, float lo, float scale) {
+    int b = static_cast<int>((c - lo) * scale);
+    return std::min(kBins - 1, std::max(0, b));
+}
+
+// 광선이 노드 상자에 들어가는 거리, 안 만나거나 limit 보다 멀면 +inf
+inline float enterBox(const BvhNode& n, const float o[3], const float inv[3], float limit) {
+    float tx1 = (n.minX - o[0]) * inv[0], tx2 = (n.maxX - o[0]) * inv[0];
+    float ty1 = (n.minY - o[1]) * inv[1], ty2 = (n.maxY - o[1]) * inv[1];
+    float tz1 = (n.minZ - o[2]) * inv[2], tz2 = (n.maxZ - o[2]) * inv[2];
+    float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+    float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+    if (tmax < tmin || tmax < 0.0f || tmin > limit) return kInf;
+    return std::max(tmin, 0.0f);
+}
+
+inline double boxDistance2(const BvhNode& n, const double p[3]) {
+    double dx = std::max({double(n.minX) - p[0], 0.0, p[0] - double(n.maxX)});
+    double dy = std::max({double(n.minY) - p[1], 0.0, p[1] - double(n.maxY)});
+    double dz = std::max({double(n.minZ) - p[2], 0.0, p[2] - double(n.maxZ)});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// 삼각형 위에서 p 에 가장 가까운 점 (Ericson, Real-Time Collision Detection 5.1.5)
+void closestOnTriangle(const double p[3], const double a[3], const double b[3], const double c[3], double out[3]) {
+    double ab[3], ac[3], ap[3];
+    for (int i = 0; i < 3; i++) ab[i] = b[i] - a[i], ac[i] = c[i] - a[i], ap[i] = p[i] - a[i];
+    auto dot = [](const double* u, const double* v) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+    auto set = [&](double s, const double* base, double t, const double* e1, double w, const double* e2) {
+        for (int i = 0; i < 3; i++) out[i] = s * base[i] + t * e1[i] + w * e2[i];
+    };
+
+    double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) return set(1.0, a, 0.0, ab, 0.0, ac);
+
+    double bp[3];
+    for (int i = 0; i < 3; i++) bp[i] = p[i] - b[i];
+    double d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) return set(1.0, b, 0.0, ab, 0.0, ac);
+
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) return set(1.0, a, d1 / (d1 - d3), ab, 0.0, ac);
+
+    double cp[3];
+    for (int i = 0; i < 3; i++) cp[i] = p[i] - c[i];
+    double d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) return set(1.0, c, 0.0, ab, 0.0, ac);
+
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) return set(1.0, a, 0.0, ab, d2 / (d2 - d6), ac);
+
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+        double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        double bc[3];
+        for (int i = 0; i < 3; i++) bc[i] = c[i] - b[i];
+        return set(1.0, b, w, bc, 0.0, ac);
+    }
+
+    double denom = 1.0 / (va + vb + vc);
+    return set(1.0, a, vb * denom, ab, vc * denom, ac);
+}
+
+void writeHit(const BvhHit& hit, double* out) {
+    out[0] = hit.distance;
+    out[1] = static_cast<double>(hit.triangle);
+    out[2] = hit.x;
+    out[3] = hit.y;
+    out[4] = hit.z;
+    out[5] = hit.nx;
+    out[6] = hit.ny;
+    out[7] = hit.nz;
+}
+
+} // namespace
+
+bool MeshBvh::build(const Mesh& mesh, ThreadPool* pool) {
+    clear();
+    size_t count = mesh.triangleCount();
+    if (count == 0 || count >= std::numeric_limits<uint32_t>::max()) return false;
+
+    // 삼각형 경계/중심
+    BuildTriangles data;
+    data.bounds.resize(count * 6);
+    data.centroids.resize(count * 3);
+    const MeshScalar* xs = mesh.xData();
+    const MeshScalar* ys = mesh.yData();
+    const MeshScalar* zs = mesh.zData();
+    const MeshIndex* indices = mesh.indexData();
+    forEachChunk(pool, count, kChunk, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            Box box;
+            for (int k = 0; k < 3; k++) {
+                MeshIndex v = indices[t * 3 + k];
+                box.grow(float(xs[v]), float(ys[v]), float(zs[v]));
+            }
+            float* b = &data.bounds[t * 6];
+            float* c = &data.centroids[t * 3];
+            for (int a = 0; a < 3; a++) {
+                b[a] = box.lo[a];
+                b[a + 3] = box.hi[a];
+                c[a] = (box.lo[a] + box.hi[a]) * 0.5f;
+            }
+        }
+    });
+
+    std::vector<uint32_t> refs(count);
+    for (size_t t = 0; t < count; t++) refs[t] = static_cast<uint32_t>(t);
+    nodes.reserve(count / 2 + 1);
+
+    // 깊이 우선 구축: 스택에서 꺼낼 때 노드를 배정하므로 왼쪽 자식은 항상 부모 바로 다음이다
+    struct Task {
+        uint32_t begin, end;
+        uint32_t parent;  // 오른쪽 자식이면 부모 번호 (offset 을 채운다), 아니면 UINT32_MAX
+        int depth;
+    };
+    std::vector<Task> tasks;
+    tasks.push_back({0, static_cast<uint32_t>(count), std::numeric_limits<uint32_t>::max(), 1});
+
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        if (task.parent != std::numeric_limits<uint32_t>::max()) nodes[task.parent].offset = index;
+        treeDepth = std::max(treeDepth, task.depth);
+
+        RangeBounds range = reduceRange<RangeBounds>(
+            pool, task.begin, task.end,
+            [&](size_t begin, size_t end, RangeBounds& r) {
+                for (size_t i = begin; i < end; i++) {
+                    const float* b = &data.bounds[size_t(refs[i]) * 6];
+                    const float* c = &data.centroids[size_t(refs[i]) * 3];
+                    r.bounds.grow(b[0], b[1], b[2]);
+                    r.bounds.grow(b[3], b[4], b[5]);
+                    r.centroids.grow(c[0], c[1], c[2]);
+                }
+            },
+            [](RangeBounds& a, const RangeBounds& b) {
+                a.bounds.merge(b.bounds);
+                a.centroids.merge(b.centroids);
+            });
+
+        BvhNode node;
+        node.minX = range.bounds.lo[0], node.minY = range.bounds.lo[1], node.minZ = range.bounds.lo[2];
+        node.maxX = range.bounds.hi[0], node.maxY = range.bounds.hi[1], node.maxZ = range.bounds.hi[2];
+        node.offset = task.begin;
+        node.count = task.end - task.begin;
+        nodes.push_back(node);
+
+        uint32_t n = task.end - task.begin;
+        if (n <= kMinLeaf) continue;
+
+        // 중심 범위가 가장 긴 축 (중앙 분할 / 퇴화 판정)
+        int longest = 0;
+        float extent[3];
+        for (int a = 0; a < 3; a++) extent[a] = range.centroids.hi[a] - range.centroids.lo[a];
+        if (extent[1] > extent[longest]) longest = 1;
+        if (extent[2] > extent[longest]) longest = 2;
+
+        uint32_t mid = task.end;
+        if (task.depth < kMaxSahDepth && extent[longest] > 0.0f) {
+            float scale[3];
+            for (int a = 0; a < 3; a++) scale[a] = extent[a] > 0.0f ? kBins * 0.99999f / extent[a] : 0.0f;
+
+            BinSet binned = reduceRange<BinSet>(
+                pool, task.begin, task.end,
+                [&](size_t begin, size_t end, BinSet& set) {
+                    for (size_t i = begin; i < end; i++) {
+                        const float* b = &data.bounds[size_t(refs[i]) * 6];
+                        const float* c = &data.centroids[size_t(refs[i]) * 3];
+                        for (int a = 0; a < 3; a++) {
+                            Bin& bin = set.bins[a][binOf(c[a], range.centroids.lo[a], scale[a])];
+                            bin.count++;
+                            bin.box.grow(b[0], b[1], b[2]);
+                            bin.box.grow(b[3], b[4], b[5]);
+                        }
+                    }
+                },
+                [](BinSet& a, const BinSet& b) {
+                    for (int axis = 0; axis < 3; axis++) {
+                        for (int i = 0; i < kBins; i++) {
+                            a.bins[axis][i].count += b.bins[axis][i].count;
+                            a.bins[axis][i].box.merge(b.bins[axis][i].box);
+                        }
+                    }
+                });
+
+            // 칸 경계 15 개 x 3 축의 SAH 비용 (왼쪽 누적 + 오른쪽 누적)
+            float bestCost = kInf;
+            int bestAxis = -1, bestSplit = 0;
+            for (int a = 0; a < 3; a++) {
+                if (extent[a] <= 0.0f) continue;
+                float rightCost[kBins];
+                Box box;
+                uint32_t right = 0;
+                for (int i = kBins - 1; i > 0; i--) {
+                    box.merge(binned.bins[a][i].box);
+                    right += binned.bins[a][i].count;
+                    rightCost[i] = box.area() * right;
+                }
+                box = Box();
+                uint32_t left = 0;
+                for (int i = 0; i < kBins - 1; i++) {
+                    box.merge(binned.bins[a][i].box);
+                    left += binned.bins[a][i].count;
+                    if (left == 0 || left == n) continue;
+                    float cost = box.area() * left + rightCost[i + 1];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = a;
+                        bestSplit = i + 1;
+                    }
+                }
+            }
+
+            float parentArea = range.bounds.area();
+            float leafCost = float(n) * parentArea;
+            float splitCost = kTraversalCost * parentArea + bestCost;
+            if (bestAxis < 0) {
+                if (n <= kMaxLeaf) continue;
+            } else if (splitCost >= leafCost && n <= kMaxLeaf) {
+                continue;
+            } else {
+                float lo = range.centroids.lo[bestAxis], s = scale[bestAxis];
+                uint32_t* first = refs.data() + task.begin;
+                uint32_t* split = std::partition(first, refs.data() + task.end, [&](uint32_t t) {
+                    return binOf(data.centroids[size_t(t) * 3 + bestAxis], lo, s) < bestSplit;
+                });
+                mid = static_cast<uint32_t>(split - refs.data());
+            }
+        } else if (n <= kMaxLeaf) {
+            continue;
+        }
+
+        if (mid == task.end || mid == task.begin) {
+            // SAH 로 못 나누면 (퇴화, 깊이 한계) 긴 축 중심 기준 개수 중앙 분할
+            mid = task.begin + n / 2;
+            std::nth_element(refs.begin() + task.begin, refs.begin() + mid, refs.begin() + task.end,
+                             [&](uint32_t a, uint32_t b) {
+                                 return data.centroids[size_t(a) * 3 + longest] <
+                                        data.centroids[size_t(b) * 3 + longest];
+                             });
+        }
+
+        nodes[index].count = 0;
+        tasks.push_back({mid, task.end, index, task.depth + 1});
+        tasks.push_back({task.begin, mid, std::numeric_limits<uint32_t>::max(), task.depth + 1});
+    }
+
+    nodes.shrink_to_fit();
+
+    // 리프 순서로 삼각형 좌표 재배치
+    triangles.resize(count * 9);
+    triangleIds = std::move(refs);
+    forEachChunk(pool, count, kChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            size_t t = triangleIds[i];
+            float* out = &triangles[i * 9];
+            for (int k = 0; k < 3; k++) {
+                MeshIndex v = indices[t * 3 + k];
+                out[k * 3] = float(xs[v]);
+                out[k * 3 + 1] = float(ys[v]);
+                out[k * 3 + 2] = float(zs[v]);
+            }
+        }
+    });
+    return true;
+}
+
+void MeshBvh::clear() {
+    nodes.clear();
+    triangles.clear();
+    triangleIds.clear();
+    nodes.shrink_to_fit();
+    triangles.shrink_to_fit();
+    triangleIds.shrink_to_fit();
+    treeDepth = 0;
+}
+
+size_t MeshBvh::memoryBytes() const {
+    return nodes.capacity() * sizeof(BvhNode) + triangles.capacity() * sizeof(float) +
+           triangleIds.capacity() * sizeof(uint32_t);
+}
+
+void MeshBvh::fillHit(uint32_t slot, double distance, double x, double y, double z, BvhHit& hit) const {
+    const float* v = &triangles[size_t(slot) * 9];
+    double e1[3] = {double(v[3]) - v[0], double(v[4]) - v[1], double(v[5]) - v[2]};
+    double e2[3] = {double(v[6]) - v[0], double(v[7]) - v[1], double(v[8]) - v[2]};
+    double nx = e1[1] * e2[2] - e1[2] * e2[1], ny = e1[2] * e2[0] - e1[0] * e2[2], nz = e1[0] * e2[1] - e1[1] * e2[0];
+    double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    double inverse = length > 0.0 ? 1.0 / length : 0.0;
+    hit.distance = distance;
+    hit.triangle = static_cast<int64_t>(triangleIds[slot]);
+    hit.x = x, hit.y = y, hit.z = z;
+    hit.nx = nx * inverse, hit.ny = ny * inverse, hit.nz = nz * inverse;
+}
+
+bool MeshBvh::raycast(const double origin[3], const double direction[3], double maxDistance, BvhHit& hit) const {
+    hit = BvhHit();
+    double length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+    if (nodes.empty() || !(length > 0.0)) return false;
+
+    float o[3], d[3], inv[3];
+    for (int a = 0; a < 3; a++) {
+        o[a] = float(origin[a]);
+        d[a] = float(direction[a] / length);
+        // 0 성분은 아주 작은 값으로 바꿔 slab 계산에서 0 * inf 를 피한다
+        inv[a] = 1.0f / (std::fabs(d[a]) > 1e-30f ? d[a] : 1e-30f);
+    }
+    float best = maxDistance > 0.0 && maxDistance < double(kInf) ? float(maxDistance) : kInf;
+    uint32_t bestSlot = std::numeric_limits<uint32_t>::max();
+
+    uint32_t stack[kStackSize];
+    float stackDistance[kStackSize];
+    int top = 0;
+    uint32_t current = 0;
+    if (enterBox(nodes[0], o, inv, best) == kInf) return false;
+
+    while (true) {
+        const BvhNode& node = nodes[current];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                // Moller-Trumbore (양면)
+                const float* v = &triangles[size_t(i) * 9];
+                float e1x = v[3] - v[0], e1y = v[4] - v[1], e1z = v[5] - v[2];
+                float e2x = v[6] - v[0], e2y = v[7] - v[1], e2z = v[8] - v[2];
+                float px = d[1] * e2z - d[2] * e2y, py = d[2] * e2x - d[0] * e2z, pz = d[0] * e2y - d[1] * e2x;
+                float det = e1x * px + e1y * py + e1z * pz;
+                if (det == 0.0f) continue;
+                float invDet = 1.0f / det;
+                float sx = o[0] - v[0], sy = o[1] - v[1], sz = o[2] - v[2];
+                float u = (sx * px + sy * py + sz * pz) * invDet;
+                if (u < 0.0f || u > 1.0f) continue;
+                float qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+                float w = (d[0] * qx + d[1] * qy + d[2] * qz) * invDet;
+                if (w < 0.0f || u + w > 1.0f) continue;
+                float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+                if (t >= 0.0f && t < best) {
+                    best = t;
+                    bestSlot = i;
+                }
+            }
+        } else {
+            uint32_t left = current + 1, right = node.offset;
+            float tLeft = enterBox(nodes[left], o, inv, best);
+            float tRight = enterBox(nodes[right], o, inv, best);
+            if (tLeft > tRight) {
+                std::swap(tLeft, tRight);
+                std::swap(left, right);
+            }
+            if (tLeft != kInf) {
+                if (tRight != kInf) {
+                    stack[top] = right;
+                    stackDistance[top++] = tRight;
+                }
+                current = left;
+                continue;
+            }
+        }
+
+        // 다음 노드 (그 사이 더 가까운 교차를 찾았으면 건너뜀)
+        bool found = false;
+        while (top > 0) {
+            top--;
+            if (stackDistance[top] <= best) {
+                current = stack[top];
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+    }
+
+    if (bestSlot == std::numeric_limits<uint32_t>::max()) return false;
+    double t = best;
+    double unit[3] = {direction[0] / length, direction[1] / length, direction[2] / length};
+    fillHit(bestSlot, t, origin[0] + unit[0] * t, origin[1] + unit[1] * t, origin[2] + unit[2] * t, hit);
+    return true;
+}
+
+bool MeshBvh::closestPoint(const double point[3], double maxDistance, BvhHit& hit) const {
+    hit = BvhHit();
+    if (nodes.empty()) return false;
+
+    double best2 = maxDistance > 0.0 && std::isfinite(maxDistance) ? maxDistance * maxDistance
+                                                                   : std::numeric_limits<double>::infinity();
+    uint32_t bestSlot = std::numeric_limits<uint32_t>::max();
+    double bestPoint[3] = {0.0, 0.0, 0.0};
+
+    uint32_t stack[kStackSize];
+    double stackDistance[kStackSize];
+    int top = 0;
+    uint32_t current = 0;
+    if (boxDistance2(nodes[0], point) > best2) return false;
+
+    while (true) {
+        const BvhNode& node = nodes[current];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const float* v = &triangles[size_t(i) * 9];
+                double a[3] = {v[0], v[1], v[2]}, b[3] = {v[3], v[4], v[5]}, c[3] = {v[6], v[7], v[8]};
+                double q[3];
+                closestOnTriangle(point, a, b, c, q);
+                double dx = q[0] - point[0], dy = q[1] - point[1], dz = q[2] - point[2];
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 < best2) {
+                    best2 = d2;
+                    bestSlot = i;
+                    bestPoint[0] = q[0], bestPoint[1] = q[1], bestPoint[2] = q[2];
+                }
+            }
+        } else {
+            uint32_t left = current + 1, right = node.offset;
+            double dLeft = boxDistance2(nodes[left], point);
+            double dRight = boxDistance2(nodes[right], point);
+            if (dLeft > dRight) {
+                std::swap(dLeft, dRight);
+                std::swap(left, right);
+            }
+            if (dLeft <= best2) {
+                if (dRight <= best2) {
+                    stack[top] = right;
+                    stackDistance[top++] = dRight;
+                }
+                current = left;
+                continue;
+            }
+        }
+
+        bool found = false;
+        while (top > 0) {
+            top--;
+            if (stackDistance[top] <= best2) {
+                current = stack[top];
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+    }
+
+    if (bestSlot == std::numeric_limits<uint32_t>::max()) return false;
+    fillHit(bestSlot, std::sqrt(best2), bestPoint[0], bestPoint[1], bestPoint[2], hit);
+    return true;
+}
+
+void MeshBvh::raycastBatch(const double* rays, size_t count, double maxDistance, double* out,
+                           ThreadPool* pool) const {
+    forEachChunk(pool, count, kQueryChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            BvhHit hit;
+            raycast(rays + i * 6, rays + i * 6 + 3, maxDistance, hit);
+            writeHit(hit, out + i * kBvhHitStride);
+        }
+    });
+}
+
+void MeshBvh::closestPointBatch(const double* points, size_t count, double maxDistance, double* out,
+                                ThreadPool* pool) const {
+    forEachChunk(pool, count, kQueryChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            BvhHit hit;
+            closestPoint(points + i * 3, maxDistance, hit);
+            writeHit(hit, out + i * kBvhHitStride);
+        }
+    });
+}
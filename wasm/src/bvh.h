@@ -0,0 +1,65 @@
+#pragma once
+
+#include "mesh.h"
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 메시 삼각형 BVH (광선 피킹, 측정, 서포트 광선, 벽 두께 검사)
+// 구축은 축마다 16 칸 binned SAH, 큰 노드의 binning 은 ThreadPool 에서 병렬로 한다.
+// 노드는 깊이 우선으로 평탄화해 왼쪽 자식이 바로 다음 노드이고, 리프 삼각형은 리프 순서대로
+// float 좌표 9 개씩 다시 배치해 순회가 연속 메모리만 읽는다. 구축 후에는 읽기 전용이라 여러 스레드에서 동시에 질의해도 된다.
+
+struct BvhNode {
+    float minX, minY, minZ;
+    uint32_t offset;  // 리프: 첫 삼각형 (리프 순서), 내부: 오른쪽 자식
+    float maxX, maxY, maxZ;
+    uint32_t count;   // 0 이면 내부 노드 (왼쪽 자식 = 다음 노드)
+};
+
+// 광선/최근접점 질의 결과. 맞은 것이 없으면 triangle < 0.
+struct BvhHit {
+    double distance = -1.0;  // 광선: 원점에서 맞은 점까지, 최근접점: 질의점에서 맞은 점까지
+    int64_t triangle = -1;   // 메시 삼각형 번호
+    double x = 0.0, y = 0.0, z = 0.0;     // 맞은 점
+    double nx = 0.0, ny = 0.0, nz = 0.0;  // 삼각형 면 법선 (감은 방향 기준, 단위 벡터)
+};
+
+// 일괄 질의 결과 한 개의 double 수 ([distance, triangle, x, y, z, nx, ny, nz])
+const size_t kBvhHitStride = 8;
+
+class MeshBvh {
+public:
+    // 삼각형이 2^32 개 이상이면 false (비운 채로 둔다)
+    bool build(const Mesh& mesh, ThreadPool* pool = nullptr);
+    void clear();
+
+    bool empty() const { return nodes.empty(); }
+    size_t nodeCount() const { return nodes.size(); }
+    size_t triangleCount() const { return triangleIds.size(); }
+    int depth() const { return treeDepth; }
+    size_t memoryBytes() const;
+
+    // origin 에서 direction (정규화해서 쓴다) 으로 maxDistance 안에서 가장 먼저 만나는 삼각형 (양면)
+    bool raycast(const double origin[3], const double direction[3], double maxDistance, BvhHit& hit) const;
+
+    // maxDistance 안에서 point 에 가장 가까운 삼각형 위의 점
+    bool closestPoint(const double point[3], double maxDistance, BvhHit& hit) const;
+
+    // rays: [ox, oy, oz, dx, dy, dz] x count, points: [x, y, z] x count
+    // out: kBvhHitStride x count (맞은 것이 없으면 distance = -1, triangle = -1)
+    void raycastBatch(const double* rays, size_t count, double maxDistance, double* out,
+                      ThreadPool* pool = nullptr) const;
+    void closestPointBatch(const double* points, size_t count, double maxDistance, double* out,
+                           ThreadPool* pool = nullptr) const;
+
+private:
+    std::vector<BvhNode> nodes;
+    std::vector<float> triangles;       // 리프 순서 삼각형 좌표 (x0 y0 z0 x1 y1 z1 x2 y2 z2)
+    std::vector<uint32_t> triangleIds;  // 리프 순서 -> 메시 삼각형 번호
+    int treeDepth = 0;
+
+    void fillHit(uint32_t slot, double distance, double x, double y, double z, BvhHit& hit) const;
+};
@@ -0,0 +1,45 @@
+#include "deflate.h"
+
+#include <cstring>
+
+namespace {
+
+// slice-by-8 표: tables[k][b] = 바이트 b 뒤에 0 바이트 k 개가 붙었을 때의 CRC
+struct Crc32Tables {
+    uint32_t tables[8][256];
+
+    Crc32Tables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+            tables[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++) tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+        }
+    }
+};
+
+const Crc32Tables& crc32Tables() {
+    static const Crc32Tables tables;
+    return tables;
+}
+
+} // namespace
+
+uint32_t computeCrc32(const unsigned char* data, size_t size, uint32_t crc) {
+    const uint32_t(&t)[8][256] = crc32Tables().tables;
+    crc = ~crc;
+
+    // 리틀 엔디언 (wasm, x86, ARM 모두 리틀 엔디언)
+    for (; size >= 8; data += 8, size -= 8) {
+        uint32_t low, high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        low ^= crc;
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; size > 0; data++, size--) crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+    return ~crc;
+}
@@ -0,0 +1,679 @@
+#include "deflate.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const size_t kWindowSize = 32768;
+const int kMinMatch = 3;
+const int kMaxMatch = 258;
+const int kTooFar = 4096;  // 이보다 먼 길이 3 매치는 리터럴보다 손해
+
+const int kHashBits = 15;
+const uint32_t kHashSize = 1u << kHashBits;
+
+// 블록 하나에 모으는 심볼 수 (zlib memLevel 8 과 같음)
+const size_t kBlockSymbols = 16383;
+
+const int kLitLenCodes = 286;
+const int kDistCodes = 30;
+const int kCodeLengthCodes = 19;
+const int kEndOfBlock = 256;
+
+const uint16_t kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistBase[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t kCodeLengthOrder[kCodeLengthCodes] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// 매치 길이/거리 → 코드 번호
+struct SymbolTables {
+    uint8_t lengthCode[kMaxMatch + 1];
+    uint8_t distCodeLow[512];   // 거리 1..512
+    uint8_t distCodeHigh[256];  // (거리 - 1) >> 7, 거리 513..32768
+
+    SymbolTables() {
+        for (int code = 0; code < 29; code++) {
+            int count = code == 28 ? 1 : 1 << kLengthExtra[code];
+            for (int i = 0; i < count && kLengthBase[code] + i <= kMaxMatch; i++) {
+                lengthCode[kLengthBase[code] + i] = static_cast<uint8_t>(code);
+            }
+        }
+        for (int code = 0; code < kDistCodes; code++) {
+            int count = 1 << kDistExtra[code];
+            for (int i = 0; i < count; i++) {
+                int dist = kDistBase[code] + i;
+                if (dist <= 512) distCodeLow[dist - 1] = static_cast<uint8_t>(code);
+                if (dist > 512) distCodeHigh[(dist - 1) >> 7] = static_cast<uint8_t>(code);
+            }
+        }
+    }
+
+    int distCode(int dist) const { return dist <= 512 ? distCodeLow[dist - 1] : distCodeHigh[(dist - 1) >> 7]; }
+};
+
+const SymbolTables& symbolTables() {
+    static const SymbolTables tables;
+    return tables;
+}
+
+// 수준별 매치 탐색 설정 (zlib 의 configuration_table 과 같은 값)
+struct LevelConfig {
+    int goodLength;  // 이전 매치가 이만큼 길면 탐색을 1/4 로
+    int lazyLength;  // 이전 매치가 이만큼 길면 다음 위치를 보지 않음 (greedy 수준에서는 삽입 한도)
+    int niceLength;  // 이만큼 찾으면 탐색 중단
+    int maxChain;
+    bool lazy;
+};
+
+const LevelConfig kLevels[10] = {
+    {0, 0, 0, 0, false},            // 0: 쓰지 않음 (1 로 올림)
+    {4, 4, 8, 4, false},
+    {4, 5, 16, 8, false},
+    {4, 6, 32, 32, false},
+    {4, 4, 16, 16, true},
+    {8, 16, 32, 32, true},
+    {8, 16, 128, 128, true},
+    {8, 32, 128, 256, true},
+    {32, 128, 258, 1024, true},
+    {32, 258, 258, 4096, true},
+};
+
+// LSB 부터 채우는 비트 출력
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<unsigned char>& out) : out(out) {}
+
+    void put(uint32_t value, int bits) {
+        buffer |= static_cast<uint64_t>(value) << count;
+        count += bits;
+        if (count >= 32) {
+            unsigned char bytes[4] = {static_cast<unsigned char>(buffer), static_cast<unsigned char>(buffer >> 8),
+                                      static_cast<unsigned char>(buffer >> 16), static_cast<unsigned char>(buffer >> 24)};
+            out.insert(out.end(), bytes, bytes + 4);
+            buffer >>= 32;
+            count -= 32;
+        }
+    }
+
+    // 남은 비트를 0 으로 채워 바이트 경계로
+    void align() {
+        while (count > 0) {
+            out.push_back(static_cast<unsigned char>(buffer));
+            buffer >>= 8;
+            count = count > 8 ? count - 8 : 0;
+        }
+        buffer = 0;
+    }
+
+    void putBytes(const unsigned char* data, size_t size) { out.insert(out.end(), data, data + size); }
+
+private:
+    std::vector<unsigned char>& out;
+    uint64_t buffer = 0;
+    int count = 0;
+};
+
+uint32_t reverseBits(uint32_t code, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    return reversed;
+}
+
+// 빈도 → 최대 maxBits 비트의 허프만 코드 길이
+// 빈도순으로 최소 중복 코드 길이(Moffat-Katajainen, 제자리) 를 구한 뒤, 넘치는 길이를 maxBits 로
+// 눌러 크래프트 합이 1 이 되도록 맞춘다 (miniz 와 같은 방식).
+void buildCodeLengths(const uint32_t* freq, int count, int maxBits, uint8_t* lengths) {
+    std::fill(lengths, lengths + count, 0);
+    struct Entry {
+        uint32_t key;
+        int symbol;
+    };
+    std::vector<Entry> symbols;
+    for (int i = 0; i < count; i++) {
+        if (freq[i]) symbols.push_back({freq[i], i});
+    }
+    int n = static_cast<int>(symbols.size());
+    if (n == 0) return;
+    if (n == 1) {
+        lengths[symbols[0].symbol] = 1;
+        return;
+    }
+    std::stable_sort(symbols.begin(), symbols.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    std::vector<uint32_t> a(n);
+    for (int i = 0; i < n; i++) a[i] = symbols[i].key;
+    a[0] += a[1];
+    int root = 0, leaf = 2;
+    for (int next = 1; next < n - 1; next++) {
+        if (leaf >= n || a[root] < a[leaf]) {
+            a[next] = a[root];
+            a[root++] = static_cast<uint32_t>(next);
+        } else {
+            a[next] = a[leaf++];
+        }
+        if (leaf >= n || (root < next && a[root] < a[leaf])) {
+            a[next] += a[root];
+            a[root++] = static_cast<uint32_t>(next);
+        } else {
+            a[next] += a[leaf++];
+        }
+    }
+    a[n - 2] = 0;
+    for (int next = n - 3; next >= 0; next--) a[next] = a[a[next]] + 1;
+    int available = 1, used = 0, depth = 0;
+    root = n - 2;
+    int next = n - 1;
+    while (available > 0) {
+        while (root >= 0 && static_cast<int>(a[root]) == depth) {
+            used++;
+            root--;
+        }
+        while (available > used) {
+            a[next--] = static_cast<uint32_t>(depth);
+            available--;
+        }
+        available = 2 * used;
+        depth++;
+        used = 0;
+    }
+
+    // 길이별 개수를 maxBits 안으로
+    int lengthCount[33] = {0};
+    for (int i = 0; i < n; i++) lengthCount[std::min<uint32_t>(a[i], 32)]++;
+    for (int i = maxBits + 1; i <= 32; i++) {
+        lengthCount[maxBits] += lengthCount[i];
+        lengthCount[i] = 0;
+    }
+    uint32_t total = 0;
+    for (int i = maxBits; i > 0; i--) total += static_cast<uint32_t>(lengthCount[i]) << (maxBits - i);
+    while (total != (1u << maxBits)) {
+        lengthCount[maxBits]--;
+        for (int i = maxBits - 1; i > 0; i--) {
+            if (lengthCount[i]) {
+                lengthCount[i]--;
+                lengthCount[i + 1] += 2;
+                break;
+            }
+        }
+        total--;
+    }
+
+    // 빈도가 높은 심볼부터 짧은 길이
+    int j = n;
+    for (int length = 1; length <= maxBits; length++) {
+        for (int k = lengthCount[length]; k > 0; k--) lengths[symbols[--j].symbol] = static_cast<uint8_t>(length);
+    }
+}
+
+// 정규 허프만 코드 (출력 순서대로 비트를 뒤집어 둔다)
+void buildCodes(const uint8_t* lengths, int count, uint16_t* codes) {
+    int lengthCount[16] = {0};
+    for (int i = 0; i < count; i++) lengthCount[lengths[i]]++;
+    lengthCount[0] = 0;
+    uint32_t next[16] = {0};
+    uint32_t code = 0;
+    for (int bits = 1; bits < 16; bits++) {
+        code = (code + lengthCount[bits - 1]) << 1;
+        next[bits] = code;
+    }
+    for (int i = 0; i < count; i++) {
+        codes[i] = lengths[i] ? static_cast<uint16_t>(reverseBits(next[lengths[i]]++, lengths[i])) : 0;
+    }
+}
+
+struct FixedCodes {
+    uint8_t litLenLengths[288];
+    uint8_t distLengths[32];
+    uint16_t litLenCodes[288];
+    uint16_t distCodes[32];
+
+    FixedCodes() {
+        for (int i = 0; i < 288; i++) litLenLengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        for (int i = 0; i < 32; i++) distLengths[i] = 5;
+        buildCodes(litLenLengths, 288, litLenCodes);
+        buildCodes(distLengths, 32, distCodes);
+    }
+};
+
+const FixedCodes& fixedCodes() {
+    static const FixedCodes codes;
+    return codes;
+}
+
+// LZ77 결과: 리터럴 (dist = 0) 또는 (길이, 거리) 매치
+struct Symbol {
+    uint16_t litLen;
+    uint16_t dist;
+};
+
+// 청크 하나의 압축 상태 (스레드마다 하나, 해시 테이블은 재사용)
+class ChunkCompressor {
+public:
+    void compress(const unsigned char* window, size_t dictSize, size_t windowSize, int level, bool last,
+                  std::vector<unsigned char>& out);
+
+private:
+    void insert(size_t pos) {
+        uint32_t h = hashAt(pos);
+        prev[pos] = head[h];
+        head[h] = static_cast<int32_t>(pos);
+    }
+
+    uint32_t hashAt(size_t pos) const {
+        return ((static_cast<uint32_t>(data[pos]) << 10) ^ (static_cast<uint32_t>(data[pos + 1]) << 5) ^ data[pos + 2]) &
+               (kHashSize - 1);
+    }
+
+    int matchLength(size_t a, size_t b, int limit) const;
+    int longestMatch(size_t pos, int prevLength, const LevelConfig& config, int& bestDist) const;
+
+    void addLiteral(unsigned char c) {
+        symbols.push_back({c, 0});
+        litLenFreq[c]++;
+    }
+
+    void addMatch(int length, int dist) {
+        const SymbolTables& tables = symbolTables();
+        symbols.push_back({static_cast<uint16_t>(length), static_cast<uint16_t>(dist)});
+        litLenFreq[257 + tables.lengthCode[length]]++;
+        distFreq[tables.distCode(dist)]++;
+    }
+
+    void flushBlock(BitWriter& bits, size_t blockStart, size_t blockEnd, bool final);
+    void writeSymbols(BitWriter& bits, const uint8_t* litLenLengths, const uint16_t* litLenCodes,
+                      const uint8_t* distLengths, const uint16_t* distCodes) const;
+
+    const unsigned char* data = nullptr;
+    size_t end = 0;
+    std::vector<int32_t> head;
+    std::vector<int32_t> prev;
+    std::vector<Symbol> symbols;
+    uint32_t litLenFreq[kLitLenCodes + 2];
+    uint32_t distFreq[kDistCodes];
+};
+
+int ChunkCompressor::matchLength(size_t a, size_t b, int limit) const {
+    int length = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    while (length + 8 <= limit) {
+        uint64_t x, y;
+        std::memcpy(&x, data + a + length, 8);
+        std::memcpy(&y, data + b + length, 8);
+        if (x != y) return length + (__builtin_ctzll(x ^ y) >> 3);
+        length += 8;
+    }
+#endif
+    while (length < limit && data[a + length] == data[b + length]) length++;
+    return length;
+}
+
+int ChunkCompressor::longestMatch(size_t pos, int prevLength, const LevelConfig& config, int& bestDist) const {
+    int limit = static_cast<int>(std::min<size_t>(kMaxMatch, end - pos));
+    if (limit < kMinMatch || prevLength >= limit) return 0;
+    int chain = prevLength >= config.goodLength ? config.maxChain >> 2 : config.maxChain;
+    int nice = std::min(config.niceLength, limit);
+    int best = prevLength;
+    size_t minPos = pos > kWindowSize ? pos - kWindowSize : 0;
+
+    for (int32_t candidate = prev[pos]; candidate >= 0 && static_cast<size_t>(candidate) >= minPos && chain-- > 0;
+         candidate = prev[candidate]) {
+        size_t c = static_cast<size_t>(candidate);
+        // 지금까지 최선의 끝 바이트부터 비교해 대부분의 후보를 빨리 거른다
+        if (best >= kMinMatch && (data[c + best] != data[pos + best] || data[c] != data[pos])) continue;
+        int length = matchLength(c, pos, limit);
+        if (length > best) {
+            best = length;
+            bestDist = static_cast<int>(pos - c);
+            if (length >= nice) break;
+        }
+    }
+    return best > prevLength ? best : 0;
+}
+
+void ChunkCompressor::writeSymbols(BitWriter& bits, const uint8_t* litLenLengths, const uint16_t* litLenCodes,
+                                   const uint8_t* distLengths, const uint16_t* distCodes) const {
+    const SymbolTables& tables = symbolTables();
+    for (const Symbol& symbol : symbols) {
+        if (symbol.dist == 0) {
+            bits.put(litLenCodes[symbol.litLen], litLenLengths[symbol.litLen]);
+            continue;
+        }
+        int lengthCode = tables.lengthCode[symbol.litLen];
+        bits.put(litLenCodes[257 + lengthCode], litLenLengths[257 + lengthCode]);
+        if (kLengthExtra[lengthCode]) bits.put(symbol.litLen - kLengthBase[lengthCode], kLengthExtra[lengthCode]);
+        int distCode = tables.distCode(symbol.dist);
+        bits.put(distCodes[distCode], distLengths[distCode]);
+        if (kDistExtra[distCode]) bits.put(symbol.dist - kDistBase[distCode], kDistExtra[distCode]);
+    }
+    bits.put(litLenCodes[kEndOfBlock], litLenLengths[kEndOfBlock]);
+}
+
+// 모은 심볼을 동적 허프만, 고정 허프만, stored 중 가장 짧은 블록으로 쓴다
+void ChunkCompressor::flushBlock(BitWriter& bits, size_t blockStart, size_t blockEnd, bool final) {
+    litLenFreq[kEndOfBlock] = 1;
+
+    uint8_t litLenLengths[kLitLenCodes];
+    uint8_t distLengths[kDistCodes];
+    buildCodeLengths(litLenFreq, kLitLenCodes, 15, litLenLengths);
+    buildCodeLengths(distFreq, kDistCodes, 15, distLengths);
+
+    int litLenCount = kLitLenCodes;
+    while (litLenCount > 257 && litLenLengths[litLenCount - 1] == 0) litLenCount--;
+    int distCount = kDistCodes;
+    while (distCount > 1 && distLengths[distCount - 1] == 0) distCount--;
+    if (distLengths[0] == 0 && distCount == 1) distLengths[0] = 1;  // 거리 코드가 하나도 없어도 하나는 적는다
+
+    // 코드 길이 목록의 런 길이 부호화 (16: 앞 길이 반복, 17/18: 0 반복)
+    uint8_t allLengths[kLitLenCodes + kDistCodes];
+    std::memcpy(allLengths, litLenLengths, litLenCount);
+    std::memcpy(allLengths + litLenCount, distLengths, distCount);
+    int total = litLenCount + distCount;
+    std::vector<uint8_t> runs;  // (코드, 추가 비트 값) 쌍
+    uint32_t codeLengthFreq[kCodeLengthCodes] = {0};
+    for (int i = 0; i < total;) {
+        uint8_t length = allLengths[i];
+        int run = 1;
+        while (i + run < total && allLengths[i + run] == length) run++;
+        i += run;
+        if (length == 0) {
+            while (run >= 11) {
+                int take = std::min(run, 138);
+                runs.push_back(18);
+                runs.push_back(static_cast<uint8_t>(take - 11));
+                codeLengthFreq[18]++;
+                run -= take;
+            }
+            if (run >= 3) {
+                runs.push_back(17);
+                runs.push_back(static_cast<uint8_t>(run - 3));
+                codeLengthFreq[17]++;
+                run = 0;
+            }
+        } else {
+            runs.push_back(length);
+            runs.push_back(0);
+            codeLengthFreq[length]++;
+            run--;
+            while (run >= 3) {
+                int take = std::min(run, 6);
+                runs.push_back(16);
+                runs.push_back(static_cast<uint8_t>(take - 3));
+                codeLengthFreq[16]++;
+                run -= take;
+            }
+        }
+        for (; run > 0; run--) {
+            runs.push_back(length);
+            runs.push_back(0);
+            codeLengthFreq[length]++;
+        }
+    }
+    uint8_t codeLengthLengths[kCodeLengthCodes];
+    buildCodeLengths(codeLengthFreq, kCodeLengthCodes, 7, codeLengthLengths);
+    int codeLengthCount = kCodeLengthCodes;
+    while (codeLengthCount > 4 && codeLengthLengths[kCodeLengthOrder[codeLengthCount - 1]] == 0) codeLengthCount--;
+
+    // 크기 비교 (비트)
+    const FixedCodes& fixed = fixedCodes();
+    uint64_t extraBits = 0, dynamicBits = 3 + 5 + 5 + 4 + 3 * static_cast<uint64_t>(codeLengthCount), fixedBits = 3;
+    for (int i = 0; i < kLitLenCodes; i++) {
+        dynamicBits += static_cast<uint64_t>(litLenFreq[i]) * litLenLengths[i];
+        fixedBits += static_cast<uint64_t>(litLenFreq[i]) * fixed.litLenLengths[i];
+        if (i >= 257) extraBits += static_cast<uint64_t>(litLenFreq[i]) * kLengthExtra[i - 257];
+    }
+    for (int i = 0; i < kDistCodes; i++) {
+        dynamicBits += static_cast<uint64_t>(distFreq[i]) * distLengths[i];
+        fixedBits += static_cast<uint64_t>(distFreq[i]) * 5;
+        extraBits += static_cast<uint64_t>(distFreq[i]) * kDistExtra[i];
+    }
+    static const int kRunExtra[3] = {2, 3, 7};
+    for (int i = 0; i < kCodeLengthCodes; i++) {
+        dynamicBits += static_cast<uint64_t>(codeLengthFreq[i]) * (codeLengthLengths[i] + (i >= 16 ? kRunExtra[i - 16] : 0));
+    }
+    dynamicBits += extraBits;
+    fixedBits += extraBits;
+    size_t rawSize = blockEnd - blockStart;
+    uint64_t storedBits = (rawSize / 65535 + 1) * (3 + 7 + 32) + rawSize * 8;
+
+    if (storedBits <= dynamicBits && storedBits <= fixedBits) {
+        size_t pos = blockStart;
+        do {
+            size_t take = std::min<size_t>(blockEnd - pos, 65535);
+            bool lastPiece = pos + take == blockEnd;
+            bits.put(final && lastPiece ? 1 : 0, 1);
+            bits.put(0, 2);
+            bits.align();
+            unsigned char header[4] = {static_cast<unsigned char>(take), static_cast<unsigned char>(take >> 8),
+                                       static_cast<unsigned char>(~take), static_cast<unsigned char>(~take >> 8)};
+            bits.putBytes(header, 4);
+            bits.putBytes(data + pos, take);
+            pos += take;
+        } while (pos < blockEnd);
+    } else if (fixedBits <= dynamicBits) {
+        bits.put(final ? 1 : 0, 1);
+        bits.put(1, 2);
+        writeSymbols(bits, fixed.litLenLengths, fixed.litLenCodes, fixed.distLengths, fixed.distCodes);
+    } else {
+        uint16_t litLenCodes[kLitLenCodes];
+        uint16_t distCodes[kDistCodes];
+        uint16_t codeLengthCodes[kCodeLengthCodes];
+        buildCodes(litLenLengths, kLitLenCodes, litLenCodes);
+        buildCodes(distLengths, kDistCodes, distCodes);
+        buildCodes(codeLengthLengths, kCodeLengthCodes, codeLengthCodes);
+
+        bits.put(final ? 1 : 0, 1);
+        bits.put(2, 2);
+        bits.put(static_cast<uint32_t>(litLenCount - 257), 5);
+        bits.put(static_cast<uint32_t>(distCount - 1), 5);
+        bits.put(static_cast<uint32_t>(codeLengthCount - 4), 4);
+        for (int i = 0; i < codeLengthCount; i++) bits.put(codeLengthLengths[kCodeLengthOrder[i]], 3);
+        for (size_t i = 0; i < runs.size(); i += 2) {
+            uint8_t code = runs[i];
+            bits.put(codeLengthCodes[code], codeLengthLengths[code]);
+            if (code >= 16) bits.put(runs[i + 1], kRunExtra[code - 16]);
+        }
+        writeSymbols(bits, litLenLengths, litLenCodes, distLengths, distCodes);
+    }
+
+    symbols.clear();
+    std::fill(litLenFreq, litLenFreq + kLitLenCodes + 2, 0);
+    std::fill(distFreq, distFreq + kDistCodes, 0);
+}
+
+// window[0, dictSize) 는 사전, [dictSize, windowSize) 를 압축한다.
+// 마지막 청크가 아니면 빈 stored 블록으로 끝내 다음 청크가 바이트 경계에서 시작하게 한다.
+void ChunkCompressor::compress(const unsigned char* window, size_t dictSize, size_t windowSize, int level, bool last,
+                               std::vector<unsigned char>& out) {
+    const LevelConfig& config = kLevels[std::max(1, std::min(level, 9))];
+    data = window;
+    end = windowSize;
+    head.assign(kHashSize, -1);
+    prev.resize(windowSize);
+    symbols.clear();
+    symbols.reserve(kBlockSymbols + 1);
+    std::fill(litLenFreq, litLenFreq + kLitLenCodes + 2, 0);
+    std::fill(distFreq, distFreq + kDistCodes, 0);
+
+    BitWriter bits(out);
+    size_t hashEnd = windowSize >= kMinMatch ? windowSize - kMinMatch + 1 : 0;  // 해시에 넣을 수 있는 마지막 위치 + 1
+    for (size_t pos = 0; pos < dictSize && pos < hashEnd; pos++) insert(pos);
+
+    size_t blockStart = dictSize;
+    size_t pos = dictSize;
+    auto maybeFlush = [&](size_t blockEnd) {
+        if (symbols.size() >= kBlockSymbols) {
+            flushBlock(bits, blockStart, blockEnd, false);
+            blockStart = blockEnd;
+        }
+    };
+
+    if (!config.lazy) {
+        while (pos < windowSize) {
+            int dist = 0;
+            int length = 0;
+            if (pos < hashEnd) {
+                insert(pos);
+                length = longestMatch(pos, kMinMatch - 1, config, dist);
+                if (length == kMinMatch && dist > kTooFar) length = 0;
+            }
+            if (length >= kMinMatch) {
+                addMatch(length, dist);
+                size_t matchEnd = pos + static_cast<size_t>(length);
+                if (length <= config.lazyLength) {
+                    for (size_t p = pos + 1; p < matchEnd && p < hashEnd; p++) insert(p);
+                }
+                pos = matchEnd;
+            } else {
+                addLiteral(data[pos]);
+                pos++;
+            }
+            maybeFlush(pos);
+        }
+    } else {
+        // 지연 매칭: 다음 위치에서 더 긴 매치가 나오면 현재 바이트는 리터럴로
+        int prevLength = kMinMatch - 1;
+        int prevDist = 0;
+        bool pendingLiteral = false;
+        while (pos < windowSize) {
+            int dist = 0;
+            int length = kMinMatch - 1;
+            if (pos < hashEnd) {
+                insert(pos);
+                if (prevLength < config.lazyLength) {
+                    int found = longestMatch(pos, prevLength, config, dist);
+                    if (found) length = found;
+                    if (length == kMinMatch && dist > kTooFar) length = kMinMatch - 1;
+                }
+            }
+
+            if (prevLength >= kMinMatch && length <= prevLength) {
+                // pos - 1 에서 시작한 이전 매치를 쓴다
+                addMatch(prevLength, prevDist);
+                size_t matchEnd = pos - 1 + static_cast<size_t>(prevLength);
+                for (size_t p = pos + 1; p < matchEnd && p < hashEnd; p++) insert(p);
+                pos = matchEnd;
+                pendingLiteral = false;
+                prevLength = kMinMatch - 1;
+                maybeFlush(pos);
+                continue;
+            }
+
+            if (pendingLiteral) {
+                addLiteral(data[pos - 1]);
+                maybeFlush(pos);
+            }
+            pendingLiteral = true;
+            prevLength = length;
+            prevDist = dist;
+            pos++;
+        }
+        if (pendingLiteral) addLiteral(data[windowSize - 1]);
+    }
+
+    flushBlock(bits, blockStart, windowSize, last);
+    if (!last) {
+        // 동기화 표시: 빈 stored 블록
+        bits.put(0, 3);
+        bits.align();
+        static const unsigned char kEmptyStored[4] = {0, 0, 0xFF, 0xFF};
+        bits.putBytes(kEmptyStored, 4);
+    } else {
+        bits.align();
+    }
+}
+
+void compressChunk(const unsigned char* window, size_t dictSize, size_t windowSize, int level, bool last,
+                   std::vector<unsigned char>& out) {
+    thread_local ChunkCompressor compressor;
+    out.clear();
+    compressor.compress(window, dictSize, windowSize, level, last, out);
+}
+
+} // namespace
+
+DeflateStream::DeflateStream(Sink sink, int level, ThreadPool* pool)
+    : sink(std::move(sink)), level(level), pool(pool), batchChunks(pool ? pool->size() : 1) {}
+
+bool DeflateStream::write(const void* data, size_t size) {
+    if (finished || failed) return false;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    totalIn += size;
+    size_t batchBytes = batchChunks * kDeflateChunkSize;
+    while (size > 0) {
+        // 꽉 찬 배치는 뒤에 입력이 더 올 때만 압축한다. 입력이 청크 경계에서 끝나면 마지막 청크가
+        // finish() 에서 마지막 블록이 되어야 출력이 배치 크기 (스레드 수) 와 관계없이 같다.
+        if (input.size() - historySize == batchBytes && !compressPending(false)) return false;
+        size_t pending = input.size() - historySize;
+        size_t take = std::min(size, batchBytes - pending);
+        input.insert(input.end(), p, p + take);
+        p += take;
+        size -= take;
+    }
+    return true;
+}
+
+bool DeflateStream::finish() {
+    if (finished || failed) return false;
+    finished = true;
+    return compressPending(true);
+}
+
+// 쌓인 입력을 청크로 나눠 (풀이 있으면 동시에) 압축하고 순서대로 내보낸다.
+// 마지막이 아니면 꽉 찬 청크만 압축하고, 다음 청크의 사전으로 끝 32KB 를 남긴다.
+bool DeflateStream::compressPending(bool last) {
+    size_t pending = input.size() - historySize;
+    size_t chunks = last ? std::max<size_t>(1, (pending + kDeflateChunkSize - 1) / kDeflateChunkSize)
+                         : pending / kDeflateChunkSize;
+    if (chunks == 0) return true;
+    if (chunkOutputs.size() < chunks) chunkOutputs.resize(chunks);
+
+    auto compressOne = [&](size_t i) {
+        size_t start = historySize + i * kDeflateChunkSize;
+        size_t stop = std::min(input.size(), start + kDeflateChunkSize);
+        size_t windowStart = start > kWindowSize ? start - kWindowSize : 0;
+        compressChunk(input.data() + windowStart, start - windowStart, stop - windowStart, level,
+                      last && i == chunks - 1, chunkOutputs[i]);
+    };
+    if (pool && chunks > 1) {
+        pool->parallelFor(chunks, compressOne);
+    } else {
+        for (size_t i = 0; i < chunks; i++) compressOne(i);
+    }
+
+    for (size_t i = 0; i < chunks; i++) {
+        totalOut += chunkOutputs[i].size();
+        if (!sink(chunkOutputs[i].data(), chunkOutputs[i].size())) {
+            failed = true;
+            return false;
+        }
+    }
+
+    size_t consumed = std::min(input.size(), historySize + chunks * kDeflateChunkSize);
+    size_t keep = std::min(consumed, kWindowSize);
+    input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(consumed - keep));
+    historySize = keep;
+    return true;
+}
+
+std::vector<unsigned char> deflateRaw(const void* data, size_t size, int level, ThreadPool* pool) {
+    std::vector<unsigned char> out;
+    DeflateStream stream(
+        [&](const unsigned char* bytes, size_t count) {
+            out.insert(out.end(), bytes, bytes + count);
+            return true;
+        },
+        level, pool);
+    stream.write(data, size);
+    stream.finish();
+    return out;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class ThreadPool;
+
+// 자체 deflate (RFC 1951 raw 스트림) 압축/해제와 CRC-32
+// zlib 없이 네이티브와 wasm 빌드에서 같은 코드를 쓴다. 압축 수준은 zlib 과 같은 뜻
+// (1 = 가장 빠름, 6 = 기본, 9 = 최대 압축) 이지만 출력 바이트는 zlib 과 다르다.
+
+const int kDeflateDefaultLevel = 6;
+
+// 병렬 압축 단위 (pigz 와 같은 128KB)
+const size_t kDeflateChunkSize = 128 * 1024;
+
+// 블록 병렬 압축 스트림 (pigz 방식)
+// 입력을 kDeflateChunkSize 청크로 나누고, 청크마다 바로 앞 32KB 입력을 사전으로 삼아 따로 압축한 뒤
+// 바이트 경계(빈 stored 블록) 로 맞춰 순서대로 이어 붙인다. 청크 경계는 입력 위치로만 정해지므로
+// 출력은 스레드 수와 관계없이 같다. 메모리는 (풀 크기 × 청크) 정도의 입력/출력 버퍼로 제한된다.
+class DeflateStream {
+public:
+    // 압축된 바이트를 순서대로 받는다. false 를 돌려주면 스트림이 실패 상태가 된다.
+    using Sink = std::function<bool(const unsigned char* data, size_t size)>;
+
+    explicit DeflateStream(Sink sink, int level = kDeflateDefaultLevel, ThreadPool* pool = nullptr);
+
+    bool write(const void* data, size_t size);
+
+    // 남은 입력을 마지막 블록으로 압축한다. 이후 write() 는 실패한다.
+    bool finish();
+
+    uint64_t bytesIn() const { return totalIn; }
+    uint64_t bytesOut() const { return totalOut; }
+
+private:
+    bool compressPending(bool last);
+
+    Sink sink;
+    int level;
+    ThreadPool* pool;
+    size_t batchChunks;
+
+    // [사전으로만 쓰는 앞 입력 (최대 32KB)][아직 압축하지 않은 입력]
+    std::vector<unsigned char> input;
+    size_t historySize = 0;
+    std::vector<std::vector<unsigned char>> chunkOutputs;
+
+    uint64_t totalIn = 0;
+    uint64_t totalOut = 0;
+    bool finished = false;
+    bool failed = false;
+};
+
+// 한 번에 압축 (작은 엔트리, 벤치마크)
+std::vector<unsigned char> deflateRaw(const void* data, size_t size, int level = kDeflateDefaultLevel,
+                                      ThreadPool* pool = nullptr);
+
+// raw deflate 해제 (표 기반 허프만 디코딩). 출력 크기를 미리 알아야 하며 (zip 엔트리)
+// 스트림이 정확히 outSize 바이트로 끝나야 true.
+bool inflateRaw(const unsigned char* in, size_t inSize, unsigned char* out, size_t outSize);
+
+// CRC-32 (zip/PNG 와 같은 다항식, slice-by-8). crc 에 이전 값을 넘기면 이어서 계산한다.
+uint32_t computeCrc32(const unsigned char* data, size_t size, uint32_t crc = 0);
@@ -0,0 +1,400 @@
+#include "footprint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const size_t kVertexBlock = 64 * 1024;    // 투영/필터 병렬 단위 (정점)
+const size_t kTriangleBlock = 256 * 1024; // 래스터화 병렬 단위 (삼각형)
+const int kMinGridCells = 8;
+const int kMaxGridCells = 2048;
+
+// xs/ys/zs -> px/py (분기 없는 직선 루프라 SSE2 / wasm simd128 으로 자동 벡터화된다)
+template <typename Scalar>
+void projectBlock(const Scalar* xs, const Scalar* ys, const Scalar* zs, size_t count, const double* m,
+                  double* px, double* py) {
+    const double m0 = m[0], m4 = m[4], m8 = m[8], m12 = m[12];
+    const double m1 = m[1], m5 = m[5], m9 = m[9], m13 = m[13];
+    for (size_t i = 0; i < count; i++) {
+        double x = xs[i], y = ys[i], z = zs[i];
+        px[i] = m0 * x + m4 * y + m8 * z + m12;
+        py[i] = m1 * x + m5 * y + m9 * z + m13;
+    }
+}
+
+// 8 방향 (x, y, x + y, x - y 의 최소/최대) 극점
+struct Extremes {
+    double value[8];
+    size_t index[8];
+
+    Extremes() {
+        for (int k = 0; k < 8; k++) {
+            value[k] = k % 2 == 0 ? std::numeric_limits<double>::max() : std::numeric_limits<double>::lowest();
+            index[k] = 0;
+        }
+    }
+
+    void add(double v, int k, size_t i) {
+        if (k % 2 == 0 ? v < value[k] : v > value[k]) {
+            value[k] = v;
+            index[k] = i;
+        }
+    }
+
+    void scan(const double* px, const double* py, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            double x = px[i], y = py[i];
+            add(x, 0, i);
+            add(x, 1, i);
+            add(y, 2, i);
+            add(y, 3, i);
+            add(x + y, 4, i);
+            add(x + y, 5, i);
+            add(x - y, 6, i);
+            add(x - y, 7, i);
+        }
+    }
+
+    void merge(const Extremes& other) {
+        for (int k = 0; k < 8; k++) add(other.value[k], k, other.index[k]);
+    }
+};
+
+// 점유 격자 (바깥 한 칸은 항상 비워 경계 추적이 테두리를 넘지 않게 한다)
+struct Grid {
+    double originX = 0.0, originY = 0.0, cell = 1.0;
+    int cols = 0, rows = 0;
+
+    int cellX(double x) const {
+        int c = static_cast<int>(std::floor((x - originX) / cell)) + 1;
+        return std::min(std::max(c, 1), cols - 2);
+    }
+    int cellY(double y) const {
+        int c = static_cast<int>(std::floor((y - originY) / cell)) + 1;
+        return std::min(std::max(c, 1), rows - 2);
+    }
+};
+
+void rasterTriangle(const Grid& grid, uint8_t* cells, double ax, double ay, double bx, double by, double cx,
+                    double cy) {
+    int x0 = std::min({grid.cellX(ax), grid.cellX(bx), grid.cellX(cx)});
+    int x1 = std::max({grid.cellX(ax), grid.cellX(bx), grid.cellX(cx)});
+    int y0 = std::min({grid.cellY(ay), grid.cellY(by), grid.cellY(cy)});
+    int y1 = std::max({grid.cellY(ay), grid.cellY(by), grid.cellY(cy)});
+    if (x0 == x1 && y0 == y1) {
+        cells[y0 * grid.cols + x0] = 1;
+        return;
+    }
+
+    // 변: 반 칸 간격으로 따라가며 표시 (옆에서 본 벽처럼 폭이 0 인 삼각형도 남긴다)
+    const double edges[3][4] = {{ax, ay, bx, by}, {bx, by, cx, cy}, {cx, cy, ax, ay}};
+    for (const auto& e : edges) {
+        double length = std::max(std::fabs(e[2] - e[0]), std::fabs(e[3] - e[1]));
+        int steps = static_cast<int>(std::ceil(length / (grid.cell * 0.5)));
+        for (int s = 0; s <= steps; s++) {
+            double t = steps > 0 ? double(s) / steps : 0.0;
+            cells[grid.cellY(e[1] + (e[3] - e[1]) * t) * grid.cols + grid.cellX(e[0] + (e[2] - e[0]) * t)] = 1;
+        }
+    }
+
+    // 내부: 칸 중심이 삼각형 안에 있는 칸
+    double area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if (area == 0.0) return;
+    double sign = area > 0.0 ? 1.0 : -1.0;
+    for (int y = y0; y <= y1; y++) {
+        double py = grid.originY + (y - 0.5) * grid.cell;
+        for (int x = x0; x <= x1; x++) {
+            double px = grid.originX + (x - 0.5) * grid.cell;
+            double w0 = ((bx - ax) * (py - ay) - (by - ay) * (px - ax)) * sign;
+            double w1 = ((cx - bx) * (py - by) - (cy - by) * (px - bx)) * sign;
+            double w2 = ((ax - cx) * (py - cy) - (ay - cy) * (px - cx)) * sign;
+            if (w0 >= 0.0 && w1 >= 0.0 && w2 >= 0.0) cells[y * grid.cols + x] = 1;
+        }
+    }
+}
+
+// 닫힌 다각형 Douglas-Peucker (0 번과 가장 먼 꼭짓점으로 나눠 양쪽을 단순화)
+void simplifyClosed(ArrangePolygon& polygon, double tolerance) {
+    size_t n = polygon.size();
+    if (n <= 4) return;
+
+    size_t far = 0;
+    double farDistance = -1.0;
+    for (size_t i = 1; i < n; i++) {
+        double dx = polygon[i].x - polygon[0].x, dy = polygon[i].y - polygon[0].y;
+        if (dx * dx + dy * dy > farDistance) {
+            farDistance = dx * dx + dy * dy;
+            far = i;
+        }
+    }
+
+    std::vector<uint8_t> keep(n, 0);
+    keep[0] = keep[far] = 1;
+    std::vector<std::pair<size_t, size_t>> stack = {{0, far}, {far, n}};
+    while (!stack.empty()) {
+        size_t first = stack.back().first, last = stack.back().second;
+        stack.pop_back();
+        const ArrangePoint& a = polygon[first];
+        const ArrangePoint& b = polygon[last % n];
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double length = std::sqrt(dx * dx + dy * dy);
+        size_t split = 0;
+        double worst = tolerance;
+        for (size_t i = first + 1; i < last; i++) {
+            double ex = polygon[i].x - a.x, ey = polygon[i].y - a.y;
+            double d = length > 0.0 ? std::fabs(dx * ey - dy * ex) / length : std::sqrt(ex * ex + ey * ey);
+            if (d > worst) {
+                worst = d;
+                split = i;
+            }
+        }
+        if (split != 0) {
+            keep[split] = 1;
+            stack.push_back({first, split});
+            stack.push_back({split, last});
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (keep[i]) polygon[kept++] = polygon[i];
+    }
+    if (kept >= 3) polygon.resize(kept);
+}
+
+double polygonArea(const ArrangePolygon& polygon) {
+    double area = 0.0;
+    for (size_t i = 0, n = polygon.size(); i < n; i++) {
+        const ArrangePoint& a = polygon[i];
+        const ArrangePoint& b = polygon[(i + 1) % n];
+        area += a.x * b.y - a.y * b.x;
+    }
+    return area * 0.5;
+}
+
+template <typename Body>
+void forEachBlock(ThreadPool* pool, size_t count, const Body& body) {
+    if (pool && count > 1) {
+        pool->parallelFor(count, body);
+    } else {
+        for (size_t i = 0; i < count; i++) body(i);
+    }
+}
+
+// 점유 격자에서 구멍을 메운 섬들의 바깥 경계 (점유 칸이 왼쪽인 칸 변을 이어 반시계 루프로)
+void traceOutlines(const Grid& grid, const std::vector<uint8_t>& cells, double tolerance,
+                   std::vector<ArrangePolygon>& outlines) {
+    const int cols = grid.cols, rows = grid.rows;
+
+    // 테두리에서 4-연결로 닿는 빈 칸만 바깥 (나머지 빈 칸은 구멍이라 채운다)
+    std::vector<uint8_t> outside(cells.size(), 0);
+    std::vector<int> stack = {0};
+    outside[0] = 1;
+    while (!stack.empty()) {
+        int c = stack.back();
+        stack.pop_back();
+        int x = c % cols, y = c / cols;
+        const int neighbors[4] = {x > 0 ? c - 1 : -1, x + 1 < cols ? c + 1 : -1, y > 0 ? c - cols : -1,
+                                  y + 1 < rows ? c + cols : -1};
+        for (int n : neighbors) {
+            if (n >= 0 && !outside[n] && !cells[n]) {
+                outside[n] = 1;
+                stack.push_back(n);
+            }
+        }
+    }
+
+    // 꼭짓점별 나가는 변 방향 비트 (0: +x, 1: +y, 2: -x, 3: -y)
+    const int vcols = cols + 1;
+    std::vector<uint8_t> out(static_cast<size_t>(vcols) * (rows + 1), 0);
+    for (int y = 1; y < rows - 1; y++) {
+        for (int x = 1; x < cols - 1; x++) {
+            int c = y * cols + x;
+            if (outside[c]) continue;
+            if (outside[c - cols]) out[y * vcols + x] |= 1;
+            if (outside[c + 1]) out[y * vcols + x + 1] |= 2;
+            if (outside[c + cols]) out[(y + 1) * vcols + x + 1] |= 4;
+            if (outside[c - 1]) out[(y + 1) * vcols + x] |= 8;
+        }
+    }
+
+    const int step[4] = {1, vcols, -1, -vcols};
+    for (int start = 0; start < static_cast<int>(out.size()); start++) {
+        while (out[start]) {
+            ArrangePolygon loop;
+            int v = start, previous = -1, first = -1;
+            do {
+                // 대각선으로만 닿은 꼭짓점에서는 왼쪽으로 꺾어 섬을 따로 닫는다
+                int dir = -1;
+                if (previous < 0) {
+                    for (int d = 0; d < 4 && dir < 0; d++) {
+                        if (out[v] & (1 << d)) dir = d;
+                    }
+                    first = dir;
+                } else {
+                    for (int turn : {1, 0, 3}) {
+                        int d = (previous + turn) % 4;
+                        if (out[v] & (1 << d)) {
+                            dir = d;
+                            break;
+                        }
+                    }
+                }
+                if (dir < 0) break;
+                out[v] &= static_cast<uint8_t>(~(1 << dir));
+                if (dir != previous) {
+                    loop.push_back({grid.originX + (v % vcols - 1) * grid.cell,
+                                    grid.originY + (v / vcols - 1) * grid.cell});
+                }
+                previous = dir;
+                v += step[dir];
+            } while (v != start);
+            if (previous == first && loop.size() > 1) loop.erase(loop.begin());  // 시작점이 직선 위
+
+            simplifyClosed(loop, tolerance);
+            if (loop.size() >= 3) outlines.push_back(std::move(loop));
+        }
+    }
+}
+
+} // namespace
+
+bool computeFootprint(const Mesh& mesh, const double* matrix, Footprint& out, const FootprintOptions& options,
+                      ThreadPool* pool) {
+    out = Footprint();
+    size_t vertexCount = mesh.vertexCount();
+    if (vertexCount == 0 || mesh.empty()) return false;
+
+    // 투영 + 블록별 극점
+    std::vector<double> px(vertexCount), py(vertexCount);
+    size_t vertexBlocks = (vertexCount + kVertexBlock - 1) / kVertexBlock;
+    std::vector<Extremes> blockExtremes(vertexBlocks);
+    forEachBlock(pool, vertexBlocks, [&](size_t b) {
+        size_t begin = b * kVertexBlock, end = std::min(vertexCount, begin + kVertexBlock);
+        projectBlock(mesh.xData() + begin, mesh.yData() + begin, mesh.zData() + begin, end - begin, matrix,
+                     px.data() + begin, py.data() + begin);
+        blockExtremes[b].scan(px.data(), py.data(), begin, end);
+    });
+    Extremes extremes;
+    for (const Extremes& e : blockExtremes) extremes.merge(e);
+    out.minX = extremes.value[0];
+    out.maxX = extremes.value[1];
+    out.minY = extremes.value[2];
+    out.maxY = extremes.value[3];
+
+    // 볼록 껍질: 극점 팔각형 안쪽 (경계 제외) 정점은 껍질에 들 수 없으므로 버린다
+    std::vector<ArrangePoint> corners;
+    for (int k = 0; k < 8; k++) corners.push_back({px[extremes.index[k]], py[extremes.index[k]]});
+    ArrangePolygon octagon = convexHull(corners);
+    std::vector<std::vector<ArrangePoint>> survivors(vertexBlocks);
+    forEachBlock(pool, vertexBlocks, [&](size_t b) {
+        size_t begin = b * kVertexBlock, end = std::min(vertexCount, begin + kVertexBlock);
+        std::vector<ArrangePoint>& kept = survivors[b];
+        for (size_t i = begin; i < end; i++) {
+            bool inside = octagon.size() >= 3;
+            for (size_t k = 0, n = octagon.size(); k < n && inside; k++) {
+                const ArrangePoint& a = octagon[k];
+                const ArrangePoint& c = octagon[k + 1 == n ? 0 : k + 1];
+                inside = (c.x - a.x) * (py[i] - a.y) - (c.y - a.y) * (px[i] - a.x) > 0.0;
+            }
+            if (!inside) kept.push_back({px[i], py[i]});
+        }
+    });
+    std::vector<ArrangePoint> candidates;
+    for (const auto& kept : survivors) candidates.insert(candidates.end(), kept.begin(), kept.end());
+    out.hull = convexHull(std::move(candidates));
+
+    // 윤곽: 점유 격자 래스터화 (블록마다 따로 그려 OR)
+    double longest = std::max(out.maxX - out.minX, out.maxY - out.minY);
+    int gridCells = std::min(std::max(options.gridCells, kMinGridCells), kMaxGridCells);
+    Grid grid;
+    grid.originX = out.minX;
+    grid.originY = out.minY;
+    grid.cell = longest > 0.0 ? longest / gridCells : 1e-6;
+    grid.cols = std::min(static_cast<int>((out.maxX - out.minX) / grid.cell), gridCells) + 3;
+    grid.rows = std::min(static_cast<int>((out.maxY - out.minY) / grid.cell), gridCells) + 3;
+
+    size_t triangleCount = mesh.triangleCount();
+    size_t triangleBlocks = (triangleCount + kTriangleBlock - 1) / kTriangleBlock;
+    size_t layers = std::max<size_t>(1, std::min(triangleBlocks, pool ? pool->size() : size_t(1)));
+    std::vector<std::vector<uint8_t>> cells(layers, std::vector<uint8_t>(size_t(grid.cols) * grid.rows, 0));
+    const MeshIndex* indices = mesh.indexData();
+    forEachBlock(pool, layers, [&](size_t l) {
+        size_t begin = triangleCount * l / layers, end = triangleCount * (l + 1) / layers;
+        uint8_t* target = cells[l].data();
+        for (size_t t = begin; t < end; t++) {
+            const MeshIndex* idx = indices + t * 3;
+            rasterTriangle(grid, target, px[idx[0]], py[idx[0]], px[idx[1]], py[idx[1]], px[idx[2]], py[idx[2]]);
+        }
+    });
+    for (size_t l = 1; l < layers; l++) {
+        for (size_t i = 0; i < cells[0].size(); i++) cells[0][i] |= cells[l][i];
+    }
+
+    double tolerance = options.tolerance > 0.0 ? options.tolerance : grid.cell;
+    traceOutlines(grid, cells[0], tolerance, out.outlines);
+    std::sort(out.outlines.begin(), out.outlines.end(), [](const ArrangePolygon& a, const ArrangePolygon& b) {
+        return polygonArea(a) > polygonArea(b);
+    });
+    for (const ArrangePolygon& outline : out.outlines) out.area += polygonArea(outline);
+    return true;
+}
+
+void FootprintCache::setMesh(const std::string& id, Mesh&& mesh) {
+    Entry& entry = entries[id];
+    totalBytes -= entry.bytes;
+    entry.mesh = std::move(mesh);
+    entry.valid = false;
+    entry.bytes = entry.mesh.memoryBytes();
+    entry.lastUse = ++useClock;
+    totalBytes += entry.bytes;
+    evict(id);
+}
+
+void FootprintCache::remove(const std::string& id) {
+    auto found = entries.find(id);
+    if (found == entries.end()) return;
+    totalBytes -= found->second.bytes;
+    entries.erase(found);
+}
+
+void FootprintCache::clear() {
+    entries.clear();
+    totalBytes = 0;
+}
+
+void FootprintCache::setMemoryLimit(size_t bytes) {
+    memoryLimit = bytes;
+    evict(std::string());
+}
+
+// 객체 수가 적어 (플레이트 위 모델) 가장 오래된 항목은 매번 훑어 찾는다
+void FootprintCache::evict(const std::string& keep) {
+    while (totalBytes > memoryLimit) {
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first == keep) continue;
+            if (oldest == entries.end() || it->second.lastUse < oldest->second.lastUse) oldest = it;
+        }
+        if (oldest == entries.end()) return;
+        totalBytes -= oldest->second.bytes;
+        entries.erase(oldest);
+    }
+}
+
+const Footprint* FootprintCache::get(const std::string& id, const double* matrix, ThreadPool* pool) {
+    auto found = entries.find(id);
+    if (found == entries.end()) return nullptr;
+    Entry& entry = found->second;
+    entry.lastUse = ++useClock;
+    if (!entry.valid || std::memcmp(entry.matrix, matrix, sizeof(entry.matrix)) != 0) {
+        computeFootprint(entry.mesh, matrix, entry.footprint, FootprintOptions(), pool);
+        std::memcpy(entry.matrix, matrix, sizeof(entry.matrix));
+        entry.valid = true;
+    }
+    return &entry.footprint;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "arrange.h"
+#include "mesh.h"
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 메시의 XY 발자국 (배치, 충돌 검사, 브림/순차 출력 간격)
+// 정점을 변환 행렬로 평면에 투영하고 (SoA 축 배열을 블록 단위로, 자동 벡터화되는 직선 루프)
+//  - hull     : 극점 팔각형 밖의 정점만 골라 (Akl-Toussaint) 볼록 껍질, O(n log n)
+//  - outlines : 삼각형을 점유 격자에 그려 구멍을 메운 뒤 섬마다 바깥 경계를 따라가 Douglas-Peucker 로 단순화
+// 행렬은 열 우선 4x4 (Three.js Matrix4.elements 와 같은 배치), 결과는 변환 후 좌표.
+
+struct Footprint {
+    ArrangePolygon hull;                  // 반시계 볼록 껍질
+    std::vector<ArrangePolygon> outlines; // 섬별 바깥 윤곽 (반시계, 오목할 수 있음), 넓이 큰 순
+    double area = 0.0;                    // outlines 넓이 합
+    double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+};
+
+struct FootprintOptions {
+    int gridCells = 256;     // 윤곽 격자의 긴 변 칸 수 (칸 크기 = 긴 변 / gridCells)
+    double tolerance = 0.0;  // 윤곽 단순화 허용 오차 (0 = 칸 크기, 계단을 직선으로 편다)
+};
+
+// 메시가 비어 있으면 false (out 은 비워 둔다)
+bool computeFootprint(const Mesh& mesh, const double* matrix, Footprint& out,
+                      const FootprintOptions& options = FootprintOptions(), ThreadPool* pool = nullptr);
+
+// 객체별 발자국 캐시: 메시는 한 번만 받아 두고, 변환 행렬이 바뀔 때만 다시 계산한다
+// 메시 사본이 메모리 상한을 넘으면 가장 오래 쓰지 않은 객체부터 버린다 (get 이 nullptr 이면 메시를 다시 보낸다).
+class FootprintCache {
+public:
+    static const size_t kDefaultMemoryLimit = size_t(64) << 20;
+
+    void setMesh(const std::string& id, Mesh&& mesh);
+    bool hasMesh(const std::string& id) const { return entries.count(id) != 0; }
+    void remove(const std::string& id);
+    void clear();
+
+    // 보관한 메시 사본 전체의 상한 (바이트). setMesh 로 방금 받은 메시는 혼자 상한보다 커도 남긴다.
+    void setMemoryLimit(size_t bytes);
+    size_t memoryBytes() const { return totalBytes; }
+
+    // 메시를 받지 않았거나 버린 id 면 nullptr. 포인터는 다음 setMesh/get/remove 호출 전까지 유효하다.
+    const Footprint* get(const std::string& id, const double* matrix, ThreadPool* pool = nullptr);
+
+private:
+    struct Entry {
+        Mesh mesh;
+        double matrix[16];
+        bool valid = false;
+        Footprint footprint;
+        size_t bytes = 0;
+        uint64_t lastUse = 0;
+    };
+
+    void evict(const std::string& keep);
+
+    std::unordered_map<std::string, Entry> entries;
+    size_t memoryLimit = kDefaultMemoryLimit;
+    size_t totalBytes = 0;
+    uint64_t useClock = 0;
+};
@@ -0,0 +1,171 @@
+#include "gcode_3mf_writer.h"
+
+#include "md5.h"
+#include "zip_writer.h"
+
+#include <cstdio>
+#include <streambuf>
+#include <vector>
+
+namespace {
+
+const char* kGCodeEntry = "Metadata/plate_1.gcode";
+const size_t kGCodeBufferSize = 64 * 1024;
+
+// G-code 엔트리 스트림: 버퍼가 찰 때마다 MD5 를 갱신하고 zip 엔트리로 deflate
+class GCodeEntryBuf : public std::streambuf {
+public:
+    GCodeEntryBuf(ZipWriter& zip, MD5& md5) : zip(zip), md5(md5), buffer(kGCodeBufferSize) {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    bool ok() const { return !failed; }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!flushBuffer()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flushBuffer() ? 0 : -1; }
+
+    // tellp() 용 (G-code 크기 통계)
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out)) return pos_type(off_type(-1));
+        return pos_type(static_cast<off_type>(flushed + (pptr() - pbase())));
+    }
+
+private:
+    bool flushBuffer() {
+        size_t size = static_cast<size_t>(pptr() - pbase());
+        if (size > 0 && !failed) {
+            md5.update(pbase(), size);
+            failed = !zip.write(pbase(), size);
+            flushed += size;
+        }
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return !failed;
+    }
+
+    ZipWriter& zip;
+    MD5& md5;
+    std::vector<char> buffer;
+    size_t flushed = 0;
+    bool failed = false;
+};
+
+bool addText(ZipWriter& zip, const char* name, const std::string& text) {
+    return zip.addEntry(name, text.data(), text.size());
+}
+
+std::string contentTypes() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">\n"
+           " <Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>\n"
+           " <Default Extension=\"model\" ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>\n"
+           " <Default Extension=\"png\" ContentType=\"image/png\"/>\n"
+           " <Default Extension=\"gcode\" ContentType=\"text/x.gcode\"/>\n"
+           "</Types>\n";
+}
+
+std::string rootRelationships(bool thumbnail) {
+    std::string rels = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">\n"
+                       " <Relationship Target=\"/3D/3dmodel.model\" Id=\"rel-1\" "
+                       "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>\n";
+    if (thumbnail) {
+        rels += " <Relationship Target=\"/Metadata/plate_1.png\" Id=\"rel-2\" "
+                "Type=\"http://schemas.openxmlformats.org/package/2006/relationships/metadata/thumbnail\"/>\n";
+    }
+    return rels + "</Relationships>\n";
+}
+
+// 출력 전용 패키지라 메시는 넣지 않는다 (프린터는 G-code 만 읽는다)
+std::string emptyModel() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<model unit=\"millimeter\" xml:lang=\"en-US\" "
+           "xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+           " <metadata name=\"Application\">3d_print-slicer</metadata>\n"
+           " <resources/>\n"
+           " <build/>\n"
+           "</model>\n";
+}
+
+// Bambu Studio 와 같은 키 이름 (값은 문자열)
+std::string projectSettingsFrom(const SlicerSettings& settings) {
+    char text[256];
+    std::snprintf(text, sizeof(text),
+                  "{\n"
+                  "    \"layer_height\": \"%g\",\n"
+                  "    \"sparse_infill_density\": \"%g%%\"\n"
+                  "}\n",
+                  settings.layerHeight, settings.infillDensity);
+    return text;
+}
+
+std::string sliceInfo() {
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<config>\n"
+           "  <header>\n"
+           "    <header_item key=\"X-BBL-Client-Type\" value=\"slicer\"/>\n"
+           "  </header>\n"
+           "  <plate>\n"
+           "    <metadata key=\"index\" value=\"1\"/>\n"
+           "  </plate>\n"
+           "</config>\n";
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+bool writeGCode3MF(std::ostream& out, const GCode3MFPlate& plate, const SlicerSettings& settings,
+                   const std::function<void(std::ostream&)>& writeGCode, std::string* error, ThreadPool* pool) {
+    ZipWriter zip(out, pool);
+    bool thumbnail = !plate.thumbnailPng.empty();
+    if (!addText(zip, "[Content_Types].xml", contentTypes()) ||
+        !addText(zip, "_rels/.rels", rootRelationships(thumbnail)) ||
+        !addText(zip, "3D/3dmodel.model", emptyModel())) {
+        return fail(error, zip.error());
+    }
+
+    // G-code 는 만들어지는 대로 압축한다 (메모리에는 버퍼와 압축 배치만)
+    MD5 md5;
+    if (!zip.beginEntry(kGCodeEntry)) return fail(error, zip.error());
+    {
+        GCodeEntryBuf buffer(zip, md5);
+        std::ostream gcode(&buffer);
+        writeGCode(gcode);
+        gcode.flush();
+        if (!buffer.ok() || !gcode) return fail(error, zip.error().empty() ? "G-code write failed" : zip.error());
+    }
+    if (!zip.endEntry()) return fail(error, zip.error());
+
+    // 프린터는 대문자 16진수 MD5 로 G-code 를 검사한다
+    std::string checksum = md5.hexDigest(true);
+    if (!addText(zip, "Metadata/plate_1.gcode.md5", checksum)) return fail(error, zip.error());
+
+    // PNG 는 이미 압축되어 있으므로 저장만
+    if (thumbnail && !zip.addEntry("Metadata/plate_1.png", plate.thumbnailPng.data(), plate.thumbnailPng.size(), 0)) {
+        return fail(error, zip.error());
+    }
+    if (!plate.smallThumbnailPng.empty() &&
+        !zip.addEntry("Metadata/plate_1_small.png", plate.smallThumbnailPng.data(), plate.smallThumbnailPng.size(), 0)) {
+        return fail(error, zip.error());
+    }
+
+    const std::string settingsText =
+        plate.projectSettings.empty() ? projectSettingsFrom(settings) : plate.projectSettings;
+    if (!addText(zip, "Metadata/project_settings.config", settingsText) ||
+        !addText(zip, "Metadata/slice_info.config", sliceInfo()) || !zip.finish()) {
+        return fail(error, zip.error());
+    }
+    return true;
+}
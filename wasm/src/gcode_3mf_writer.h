@@ -0,0 +1,25 @@
+#pragma once
+
+#include "slicer_settings.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+class ThreadPool;
+
+// .gcode.3mf 에 G-code 와 함께 넣는 플레이트 자료 (모두 선택, PNG 는 바이트 그대로)
+struct GCode3MFPlate {
+    std::string thumbnailPng;       // Metadata/plate_1.png
+    std::string smallThumbnailPng;  // Metadata/plate_1_small.png
+    std::string projectSettings;    // Metadata/project_settings.config (비어 있으면 settings 로 만든다)
+};
+
+// Bambu 프린터용 .gcode.3mf 를 한 번에 순차로 쓴다.
+// writeGCode 가 받은 스트림에 쓰는 G-code 는 Metadata/plate_1.gcode 엔트리로 바로 deflate 되고,
+// 같은 바이트로 CRC 와 MD5(plate_1.gcode.md5) 를 계산하므로 G-code 전체 문자열을 만들지 않는다.
+// out 은 탐색할 수 없어도 된다. pool 이 있으면 G-code 를 청크 단위로 병렬 압축한다.
+// 실패하면 false 와 함께 error 에 이유를 적는다.
+bool writeGCode3MF(std::ostream& out, const GCode3MFPlate& plate, const SlicerSettings& settings,
+                   const std::function<void(std::ostream&)>& writeGCode, std::string* error = nullptr,
+                   ThreadPool* pool = nullptr);
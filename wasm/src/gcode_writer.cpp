@@ -0,0 +1,96 @@
+#include "gcode_writer.h"
+
+namespace {
+
+const size_t kCountingBufferSize = 64 * 1024;
+
+} // namespace
+
+CountingStreamBuf::CountingStreamBuf(std::streambuf* target) : target(target), buffer(kCountingBufferSize) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+CountingStreamBuf::int_type CountingStreamBuf::overflow(int_type ch) {
+    if (!flushBuffer()) return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int CountingStreamBuf::sync() {
+    return flushBuffer() ? 0 : -1;
+}
+
+bool CountingStreamBuf::flushBuffer() {
+    std::streamsize size = pptr() - pbase();
+    bool ok = size == 0 || (target && target->sputn(pbase(), size) == size);
+    flushed += static_cast<uint64_t>(size);
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return ok;
+}
+
+// 숫자 형식 (정밀도, 로캘 등) 은 대상 스트림 설정을 그대로 따른다
+GCodeWriter::GCodeWriter(std::ostream& target, double layerHeight, double infillDensity)
+    : target(target), counter(target.rdbuf()), out(&counter), layerHeight(layerHeight), infillDensity(infillDensity) {
+    out.copyfmt(target);
+    out.exceptions(std::ios_base::goodbit);
+}
+
+GCodeWriter::~GCodeWriter() {
+    out.flush();
+}
+
+// 남은 버퍼를 넘기고, 넘기지 못했으면 대상 스트림에 오류를 표시한다
+void GCodeWriter::flush() {
+    if (!out.flush()) target.setstate(std::ios_base::badbit);
+}
+
+void GCodeWriter::begin() {
+    out << "; Generated by WASM Slicer\n";
+    out << "; Layer height: " << layerHeight << "mm\n";
+    out << "; Infill density: " << infillDensity << "%\n\n";
+
+    out << "G21 ; Set units to mm\n";
+    out << "G90 ; Absolute positioning\n";
+    out << "M82 ; Extruder absolute mode\n\n";
+}
+
+void GCodeWriter::writeLayer(size_t index, const LayerView& layer) {
+    out << "; Layer " << index << " at Z=" << layer.height << "\n";
+
+    // 윤곽선 출력
+    for (size_t c = 0; c < layer.contourCount(); c++) {
+        PolylineView contour = layer.contour(c);
+        if (contour.empty()) continue;
+
+        out << "G0 Z" << layer.height << " F1200\n";
+        out << "G0 X" << contour[0].x << " Y" << contour[0].y << " F3000\n";
+
+        for (size_t j = 1; j < contour.size(); j++) {
+            e += 0.1; // 간단한 압출량 계산
+            out << "G1 X" << contour[j].x << " Y" << contour[j].y << " E" << e << " F1800\n";
+        }
+    }
+
+    // 인필 출력
+    for (size_t c = 0; c < layer.infillCount(); c++) {
+        PolylineView infillLine = layer.infill(c);
+        if (infillLine.size() < 2) continue;
+
+        out << "G0 Z" << layer.height << " F1200\n";
+        out << "G0 X" << infillLine[0].x << " Y" << infillLine[0].y << " F3000\n";
+
+        e += 0.05;
+        out << "G1 X" << infillLine[1].x << " Y" << infillLine[1].y << " E" << e << " F1800\n";
+    }
+
+    lastHeight = layer.height;
+}
+
+void GCodeWriter::end() {
+    out << "\nG0 Z" << (lastHeight + 10) << " F1200\n";
+    out << "M84 ; Disable steppers\n";
+    flush();
+}
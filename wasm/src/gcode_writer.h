@@ -0,0 +1,57 @@
+#pragma once
+
+#include "layer_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+// 쓴 바이트를 세며 대상 스트림 버퍼로 넘기는 버퍼 (탐색할 수 없는 출력에서도 크기를 안다)
+class CountingStreamBuf : public std::streambuf {
+public:
+    explicit CountingStreamBuf(std::streambuf* target);
+
+    uint64_t count() const { return flushed + static_cast<uint64_t>(pptr() - pbase()); }
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+private:
+    bool flushBuffer();
+
+    std::streambuf* target;
+    std::vector<char> buffer;
+    uint64_t flushed = 0;
+};
+
+// G-code 출력기
+// 레이어를 하나씩 받아 바로 스트림에 쓰므로 전체 슬라이스 결과 없이도 출력할 수 있다.
+// 출력은 내부 버퍼를 거쳐 out 으로 나가며 end() (또는 소멸) 에서 마저 넘긴다.
+class GCodeWriter {
+public:
+    GCodeWriter(std::ostream& target, double layerHeight, double infillDensity);
+    ~GCodeWriter();
+    GCodeWriter(const GCodeWriter&) = delete;
+    GCodeWriter& operator=(const GCodeWriter&) = delete;
+
+    void begin();
+    void writeLayer(size_t index, const LayerView& layer);
+    void end();
+
+    // 지금까지 쓴 G-code 바이트
+    uint64_t bytesWritten() const { return counter.count(); }
+
+private:
+    void flush();
+
+    std::ostream& target;
+    CountingStreamBuf counter;
+    std::ostream out;
+    double layerHeight;
+    double infillDensity;
+    double e = 0.0; // 압출량
+    double lastHeight = 0.0;
+};
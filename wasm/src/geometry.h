@@ -0,0 +1,13 @@
+#pragma once
+
+// 3D 벡터 구조체
+struct Vector3 {
+    double x, y, z;
+    Vector3(double x = 0, double y = 0, double z = 0) : x(x), y(y), z(z) {}
+};
+
+// 삼각형 구조체
+struct Triangle {
+    Vector3 v1, v2, v3;
+    Triangle(Vector3 v1, Vector3 v2, Vector3 v3) : v1(v1), v2(v2), v3(v3) {}
+};
@@ -0,0 +1,97 @@
+#include "heatshrink.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+const int kHashBits = 13;
+const uint32_t kHashSize = 1u << kHashBits;
+const int kMaxChain = 64;
+
+// MSB 부터 채우는 비트 출력
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<unsigned char>& out) : out(out) {}
+
+    void put(uint32_t value, int bits) {
+        buffer = (buffer << bits) | (value & ((1u << bits) - 1));
+        count += bits;
+        while (count >= 8) {
+            count -= 8;
+            out.push_back(static_cast<unsigned char>(buffer >> count));
+        }
+    }
+
+    void finish() {
+        if (count > 0) out.push_back(static_cast<unsigned char>(buffer << (8 - count)));
+        count = 0;
+    }
+
+private:
+    std::vector<unsigned char>& out;
+    uint32_t buffer = 0;
+    int count = 0;
+};
+
+uint32_t hashAt(const unsigned char* p) {
+    return ((static_cast<uint32_t>(p[0]) << 5) ^ p[1]) & (kHashSize - 1);
+}
+
+} // namespace
+
+void heatshrinkCompress(const unsigned char* data, size_t size, int windowBits, int lookaheadBits,
+                        std::vector<unsigned char>& out) {
+    const size_t window = size_t(1) << windowBits;
+    const size_t maxLength = size_t(1) << lookaheadBits;
+    // 참조 비용 (1 + W + L 비트) 이 같은 길이의 리터럴 (9비트씩) 보다 작아지는 최소 길이
+    const size_t minLength = static_cast<size_t>(1 + windowBits + lookaheadBits) / 9 + 1;
+
+    // 2바이트 해시 체인 (블록은 작으므로 위치 전체에 대해 prev 를 둔다)
+    std::vector<int32_t> head(kHashSize, -1);
+    std::vector<int32_t> prev(size);
+    auto insert = [&](size_t pos) {
+        if (pos + 1 >= size) return;
+        uint32_t h = hashAt(data + pos);
+        prev[pos] = head[h];
+        head[h] = static_cast<int32_t>(pos);
+    };
+
+    BitWriter bits(out);
+    size_t pos = 0;
+    while (pos < size) {
+        size_t bestLength = 0, bestDistance = 0;
+        size_t limit = std::min(maxLength, size - pos);
+        if (limit >= minLength) {
+            insert(pos);
+            int chain = kMaxChain;
+            for (int32_t candidate = prev[pos]; candidate >= 0 && pos - static_cast<size_t>(candidate) <= window &&
+                                                chain-- > 0;
+                 candidate = prev[candidate]) {
+                const unsigned char* a = data + candidate;
+                const unsigned char* b = data + pos;
+                if (bestLength > 0 && a[bestLength] != b[bestLength]) continue;
+                size_t length = 0;
+                while (length < limit && a[length] == b[length]) length++;
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = pos - static_cast<size_t>(candidate);
+                    if (length == limit) break;
+                }
+            }
+        }
+
+        if (bestLength >= minLength) {
+            bits.put(0, 1);
+            bits.put(static_cast<uint32_t>(bestDistance - 1), windowBits);
+            bits.put(static_cast<uint32_t>(bestLength - 1), lookaheadBits);
+            for (size_t p = pos + 1; p < pos + bestLength; p++) insert(p);
+            pos += bestLength;
+        } else {
+            bits.put(1, 1);
+            bits.put(data[pos], 8);
+            pos++;
+        }
+    }
+    bits.finish();
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// heatshrink 호환 LZSS (bgcode 의 Heatshrink_11_4 / Heatshrink_12_4 블록 압축)
+// 비트 스트림은 MSB 부터: 1 + 8비트 리터럴, 또는 0 + windowBits 비트 (거리 - 1) + lookaheadBits 비트 (길이 - 1).
+// 마지막 바이트의 남는 비트는 0 으로 채운다. 블록마다 독립이라 이전 블록을 참조하지 않는다.
+
+// out 뒤에 압축 결과를 붙인다
+void heatshrinkCompress(const unsigned char* data, size_t size, int windowBits, int lookaheadBits,
+                        std::vector<unsigned char>& out);
@@ -0,0 +1,285 @@
+#include "deflate.h"
+
+#include <cstring>
+
+namespace {
+
+const uint16_t kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistBase[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+const int kLitLenTableBits = 10;
+const int kDistTableBits = 8;
+const int kCodeLengthTableBits = 7;
+
+// 허프만 디코딩 표
+// 길이가 tableBits 이하인 코드는 다음 비트들로 바로 찾는다 (항목 = 심볼 << 4 | 길이).
+// 더 긴 코드(드묾)는 항목이 0 이고, 정규 코드의 길이별 개수로 한 비트씩 찾는다.
+struct HuffmanTable {
+    int tableBits = 0;
+    uint16_t fast[1 << kLitLenTableBits];
+    uint16_t counts[16];
+    uint16_t symbols[288];
+
+    bool build(const uint8_t* lengths, int count, int bits) {
+        tableBits = bits;
+        std::memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < count; i++) counts[lengths[i]]++;
+        counts[0] = 0;
+
+        // 초과 구독이면 잘못된 코드 (불완전한 코드는 허용: 거리 코드 하나짜리 블록 등)
+        int left = 1;
+        for (int length = 1; length < 16; length++) {
+            left = (left << 1) - counts[length];
+            if (left < 0) return false;
+        }
+
+        uint16_t offsets[16];
+        offsets[1] = 0;
+        for (int length = 1; length < 15; length++) offsets[length + 1] = static_cast<uint16_t>(offsets[length] + counts[length]);
+        for (int i = 0; i < count; i++) {
+            if (lengths[i]) symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+        }
+
+        std::memset(fast, 0, sizeof(uint16_t) << bits);
+        uint32_t code = 0;
+        int index = 0;
+        for (int length = 1; length <= bits; length++) {
+            for (int k = 0; k < counts[length]; k++, index++, code++) {
+                // 코드는 MSB 부터 읽히므로 표 색인은 뒤집은 값
+                uint32_t reversed = 0;
+                for (int b = 0; b < length; b++) reversed |= ((code >> b) & 1u) << (length - 1 - b);
+                uint16_t entry = static_cast<uint16_t>((symbols[index] << 4) | length);
+                for (uint32_t slot = reversed; slot < (1u << bits); slot += 1u << length) fast[slot] = entry;
+            }
+            code <<= 1;
+        }
+        return true;
+    }
+};
+
+// LSB 부터 읽는 비트 입력 (64비트 버퍼, 8바이트씩 채움)
+class BitReader {
+public:
+    BitReader(const unsigned char* data, size_t size) : pos(data), end(data + size) {}
+
+    // 최소 56비트를 채운다 (입력 끝 근처에서는 남은 만큼만)
+    void refill() {
+        if (end - pos >= 8) {
+            uint64_t word;
+            std::memcpy(&word, pos, 8);
+            buffer |= word << count;
+            pos += (63 ^ count) >> 3;
+            count |= 56;
+        } else {
+            while (count <= 56 && pos < end) {
+                buffer |= static_cast<uint64_t>(*pos++) << count;
+                count += 8;
+            }
+        }
+    }
+
+    uint32_t peek(int bits) const { return static_cast<uint32_t>(buffer & ((1ull << bits) - 1)); }
+
+    bool consume(int bits) {
+        if (bits > count) return false;
+        buffer >>= bits;
+        count -= bits;
+        return true;
+    }
+
+    bool read(int bits, uint32_t& value) {
+        if (bits == 0) {
+            value = 0;
+            return true;
+        }
+        if (count < bits) refill();
+        value = peek(bits);
+        return consume(bits);
+    }
+
+    // stored 블록: 바이트 경계로 맞추고 버퍼에 미리 읽은 바이트를 입력으로 되돌린다
+    void alignToByte() {
+        consume(count & 7);
+        pos -= count >> 3;
+        buffer = 0;
+        count = 0;
+    }
+
+    const unsigned char* position() const { return pos; }
+    size_t remaining() const { return static_cast<size_t>(end - pos); }
+    void skip(size_t bytes) { pos += bytes; }
+
+    bool decode(const HuffmanTable& table, int& symbol) {
+        if (count < 15) refill();
+        uint16_t entry = table.fast[peek(table.tableBits)];
+        if (entry) {
+            symbol = entry >> 4;
+            return consume(entry & 15);
+        }
+        // 긴 코드: 정규 허프만 코드를 한 비트씩
+        int code = 0, first = 0, index = 0;
+        for (int length = 1; length < 16; length++) {
+            code |= static_cast<int>((buffer >> (length - 1)) & 1);
+            int n = table.counts[length];
+            if (code - first < n) {
+                symbol = table.symbols[index + code - first];
+                return consume(length);
+            }
+            index += n;
+            first = (first + n) << 1;
+            code <<= 1;
+        }
+        return false;
+    }
+
+private:
+    const unsigned char* pos;
+    const unsigned char* end;
+    uint64_t buffer = 0;
+    int count = 0;
+};
+
+struct FixedTables {
+    HuffmanTable litLen;
+    HuffmanTable dist;
+
+    FixedTables() {
+        uint8_t lengths[288];
+        for (int i = 0; i < 288; i++) lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        litLen.build(lengths, 288, kLitLenTableBits);
+        for (int i = 0; i < 30; i++) lengths[i] = 5;
+        dist.build(lengths, 30, kDistTableBits);
+    }
+};
+
+const FixedTables& fixedTables() {
+    static const FixedTables tables;
+    return tables;
+}
+
+bool readDynamicTables(BitReader& bits, HuffmanTable& litLen, HuffmanTable& dist) {
+    uint32_t hlit, hdist, hclen;
+    if (!bits.read(5, hlit) || !bits.read(5, hdist) || !bits.read(4, hclen)) return false;
+    int litLenCount = static_cast<int>(hlit) + 257;
+    int distCount = static_cast<int>(hdist) + 1;
+    if (litLenCount > 286 || distCount > 30) return false;
+
+    uint8_t codeLengthLengths[19] = {0};
+    for (uint32_t i = 0; i < hclen + 4; i++) {
+        uint32_t length;
+        if (!bits.read(3, length)) return false;
+        codeLengthLengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(length);
+    }
+    HuffmanTable codeLengths;
+    if (!codeLengths.build(codeLengthLengths, 19, kCodeLengthTableBits)) return false;
+
+    uint8_t lengths[286 + 30];
+    int total = litLenCount + distCount;
+    for (int i = 0; i < total;) {
+        int symbol;
+        if (!bits.decode(codeLengths, symbol)) return false;
+        if (symbol < 16) {
+            lengths[i++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+        uint32_t repeat;
+        uint8_t value = 0;
+        if (symbol == 16) {
+            if (i == 0 || !bits.read(2, repeat)) return false;
+            value = lengths[i - 1];
+            repeat += 3;
+        } else if (symbol == 17) {
+            if (!bits.read(3, repeat)) return false;
+            repeat += 3;
+        } else {
+            if (!bits.read(7, repeat)) return false;
+            repeat += 11;
+        }
+        if (i + static_cast<int>(repeat) > total) return false;
+        for (uint32_t r = 0; r < repeat; r++) lengths[i++] = value;
+    }
+    if (lengths[256] == 0) return false;  // 블록 끝 코드가 없음
+
+    return litLen.build(lengths, litLenCount, kLitLenTableBits) &&
+           dist.build(lengths + litLenCount, distCount, kDistTableBits);
+}
+
+// 허프만 블록 하나
+bool inflateBlock(BitReader& bits, const HuffmanTable& litLen, const HuffmanTable& dist, unsigned char* out,
+                  size_t outSize, size_t& outPos) {
+    for (;;) {
+        int symbol;
+        if (!bits.decode(litLen, symbol)) return false;
+        if (symbol < 256) {
+            if (outPos >= outSize) return false;
+            out[outPos++] = static_cast<unsigned char>(symbol);
+            continue;
+        }
+        if (symbol == 256) return true;
+
+        symbol -= 257;
+        if (symbol >= 29) return false;
+        uint32_t extra;
+        if (!bits.read(kLengthExtra[symbol], extra)) return false;
+        size_t length = kLengthBase[symbol] + extra;
+
+        int distSymbol;
+        if (!bits.decode(dist, distSymbol) || distSymbol >= 30) return false;
+        if (!bits.read(kDistExtra[distSymbol], extra)) return false;
+        size_t distance = kDistBase[distSymbol] + extra;
+        if (distance > outPos || length > outSize - outPos) return false;
+
+        // 겹치지 않는 거리면 8바이트씩 (출력 끝에서 넘치지 않을 때만)
+        unsigned char* dst = out + outPos;
+        const unsigned char* src = dst - distance;
+        if (distance >= 8 && outSize - outPos >= length + 8) {
+            for (size_t i = 0; i < length; i += 8) std::memcpy(dst + i, src + i, 8);
+        } else {
+            for (size_t i = 0; i < length; i++) dst[i] = src[i];
+        }
+        outPos += length;
+    }
+}
+
+} // namespace
+
+bool inflateRaw(const unsigned char* in, size_t inSize, unsigned char* out, size_t outSize) {
+    BitReader bits(in, inSize);
+    size_t outPos = 0;
+    HuffmanTable litLen, dist;
+
+    for (;;) {
+        uint32_t final, type;
+        if (!bits.read(1, final) || !bits.read(2, type)) return false;
+
+        if (type == 0) {
+            bits.alignToByte();
+            if (bits.remaining() < 4) return false;
+            const unsigned char* header = bits.position();
+            size_t length = header[0] | (header[1] << 8);
+            size_t check = header[2] | (header[3] << 8);
+            if ((length ^ 0xFFFF) != check) return false;
+            bits.skip(4);
+            if (bits.remaining() < length || outSize - outPos < length) return false;
+            std::memcpy(out + outPos, bits.position(), length);
+            bits.skip(length);
+            outPos += length;
+        } else if (type == 1) {
+            const FixedTables& fixed = fixedTables();
+            if (!inflateBlock(bits, fixed.litLen, fixed.dist, out, outSize, outPos)) return false;
+        } else if (type == 2) {
+            if (!readDynamicTables(bits, litLen, dist)) return false;
+            if (!inflateBlock(bits, litLen, dist, out, outSize, outPos)) return false;
+        } else {
+            return false;
+        }
+
+        if (final) return outPos == outSize;
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 점 배열 오프셋 타입 (memory64 빌드에서는 64비트)
+#ifdef SLICER_WIDE_INDEX
+using PolylineOffset = uint64_t;
+#else
+using PolylineOffset = uint32_t;
+#endif
+
+// 레이어 평면 위의 점 (z 는 레이어 높이로 대신한다)
+struct Point2 {
+    double x, y;
+};
+static_assert(sizeof(Point2) == 2 * sizeof(double), "Point2 must pack as two doubles");
+
+// 연속 점 배열 위의 폴리라인 하나
+struct PolylineView {
+    const Point2* points;
+    size_t count;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Point2& operator[](size_t i) const { return points[i]; }
+    const Point2* begin() const { return points; }
+    const Point2* end() const { return points + count; }
+};
+
+// 폴리라인 묶음 (CSR: 점 배열 하나 + 폴리라인 시작 오프셋 배열)
+// clear() 는 용량을 유지하므로 슬라이스를 반복해도 재할당이 거의 없다.
+class PolylineBuffer {
+public:
+    PolylineBuffer() : offsets(1, 0) {}
+
+    void clear() {
+        points.clear();
+        offsets.assign(1, 0);
+    }
+
+    void addPoint(double x, double y) { points.push_back({x, y}); }
+    void endPolyline() { offsets.push_back(static_cast<PolylineOffset>(points.size())); }
+
+    size_t polylineCount() const { return offsets.size() - 1; }
+    size_t pointCount() const { return points.size(); }
+
+    PolylineView polyline(size_t i) const {
+        return {points.data() + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i])};
+    }
+
+    // 다른 버퍼의 폴리라인을 순서대로 이어 붙인다 (병렬 슬라이스 결과 병합)
+    void append(const PolylineBuffer& other) {
+        PolylineOffset base = static_cast<PolylineOffset>(points.size());
+        points.insert(points.end(), other.points.begin(), other.points.end());
+        for (size_t i = 1; i < other.offsets.size(); i++) offsets.push_back(base + other.offsets[i]);
+    }
+
+    // 원본 배열 (복사 없이 typed array 로 넘길 때)
+    // 점은 x, y 가 번갈아 놓인 double 배열, 오프셋은 polylineCount() + 1 개
+    const double* pointData() const { return reinterpret_cast<const double*>(points.data()); }
+    const PolylineOffset* offsetData() const { return offsets.data(); }
+
+private:
+    std::vector<Point2> points;
+    std::vector<PolylineOffset> offsets;
+};
+
+// 한 레이어가 가진 폴리라인 범위
+struct LayerView {
+    double height;
+    const PolylineBuffer* contourBuffer;
+    const PolylineBuffer* infillBuffer;
+    size_t firstContour, contourEnd;
+    size_t firstInfill, infillEnd;
+
+    size_t contourCount() const { return contourEnd - firstContour; }
+    size_t infillCount() const { return infillEnd - firstInfill; }
+    PolylineView contour(size_t i) const { return contourBuffer->polyline(firstContour + i); }
+    PolylineView infill(size_t i) const { return infillBuffer->polyline(firstInfill + i); }
+};
+
+// 슬라이스 결과 저장소
+// 종류(윤곽선/인필)마다 점 배열과 오프셋 배열 하나씩만 두고, 레이어는 폴리라인 범위로 표현한다.
+//
+// 슬라이스별 Arena 대신 용량을 유지하는 std::vector 를 쓴다. 결과는 slice() 가 끝난 뒤에도
+// (G-code 출력, JS 로 복사 없이 넘기는 툴패스) 남아 있어야 하고, 점 수를 미리 알 수 없어 배열이
+// 커져야 하는데 bump 할당기는 제자리에서 키울 수 없어 두 배로 늘릴 때마다 옛 배열이 청크에 남는다.
+// 할당 횟수 (단일 스레드, 생성 메시 200K 삼각형, 약 200 레이어): 첫 slice() 88 번, 반복 11 번.
+// 레이어별 중첩 vector 는 폴리라인마다 최소 1 번이라 1400 번 이상 (예전 코드처럼 복사하면 8000 번).
+class LayerStore {
+public:
+    void clear() {
+        heights.clear();
+        contourStart.clear();
+        infillStart.clear();
+        contourLines.clear();
+        infillLines.clear();
+    }
+
+    // 새 레이어 시작; 이후 추가되는 폴리라인은 이 레이어에 속한다
+    void beginLayer(double height) {
+        heights.push_back(height);
+        contourStart.push_back(contourLines.polylineCount());
+        infillStart.push_back(infillLines.polylineCount());
+    }
+
+    PolylineBuffer& contours() { return contourLines; }
+    PolylineBuffer& infill() { return infillLines; }
+    const PolylineBuffer& contours() const { return contourLines; }
+    const PolylineBuffer& infill() const { return infillLines; }
+
+    size_t layerCount() const { return heights.size(); }
+    bool empty() const { return heights.empty(); }
+
+    // 다른 저장소의 레이어를 뒤에 이어 붙인다 (폴리라인 번호는 이어지도록 옮긴다)
+    void append(const LayerStore& other) {
+        size_t contourBase = contourLines.polylineCount();
+        size_t infillBase = infillLines.polylineCount();
+        heights.insert(heights.end(), other.heights.begin(), other.heights.end());
+        for (size_t start : other.contourStart) contourStart.push_back(contourBase + start);
+        for (size_t start : other.infillStart) infillStart.push_back(infillBase + start);
+        contourLines.append(other.contourLines);
+        infillLines.append(other.infillLines);
+    }
+
+    // 레이어 높이와 레이어별 첫 폴리라인 번호
+    const std::vector<double>& layerHeights() const { return heights; }
+    const std::vector<size_t>& layerContourStart() const { return contourStart; }
+    const std::vector<size_t>& layerInfillStart() const { return infillStart; }
+
+    LayerView layer(size_t i) const {
+        bool last = i + 1 == heights.size();
+        return {heights[i], &contourLines, &infillLines,
+                contourStart[i], last ? contourLines.polylineCount() : contourStart[i + 1],
+                infillStart[i], last ? infillLines.polylineCount() : infillStart[i + 1]};
+    }
+
+private:
+    std::vector<double> heights;
+    std::vector<size_t> contourStart;
+    std::vector<size_t> infillStart;
+    PolylineBuffer contourLines;
+    PolylineBuffer infillLines;
+};
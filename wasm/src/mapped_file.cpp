@@ -0,0 +1,67 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__unix__) || defined(__APPLE__))
+#define SLICER_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef SLICER_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) {
+            ::close(fd);
+            opened = true;
+            return true;
+        }
+        void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            // 파서는 앞에서부터 한 번 훑으므로 미리 읽기를 늘린다
+            ::madvise(addr, length, MADV_SEQUENTIAL);
+            ::close(fd);
+            bytes = static_cast<const unsigned char*>(addr);
+            opened = true;
+            mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+    length = 0;
+#endif
+
+    // 매핑할 수 없으면 통째로 읽는다
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (in.bad()) {
+        fallback.clear();
+        return false;
+    }
+    bytes = fallback.data();
+    length = fallback.size();
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef SLICER_HAVE_MMAP
+    if (mapped) ::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    std::vector<unsigned char>().swap(fallback);
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+    mapped = false;
+}
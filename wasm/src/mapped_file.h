@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 읽기 전용 파일 매핑
+// POSIX 네이티브 빌드에서는 mmap 으로 열어 OS 가 필요한 페이지만 읽게 하고(페이지 캐시 재사용),
+// mmap 을 쓸 수 없는 환경(Emscripten, Windows, 특수 파일)에서는 한 번 읽어 버퍼에 담는다.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 실패하면 false (파일이 없거나 읽을 수 없음). 빈 파일은 성공이며 size() == 0.
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool isOpen() const { return opened; }
+    bool isMapped() const { return mapped; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    bool mapped = false;
+    std::vector<unsigned char> fallback;
+};
@@ -0,0 +1,115 @@
+#include "md5.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// 라운드별 회전량과 상수 (K[i] = floor(|sin(i + 1)| * 2^32))
+const int kShifts[64] = {7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                         5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                         4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                         6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+const uint32_t kConstants[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+inline uint32_t rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+// 리틀 엔디언 읽기 (wasm, x86, ARM 모두 리틀 엔디언)
+inline uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+MD5::MD5() {
+    state[0] = 0x67452301;
+    state[1] = 0xefcdab89;
+    state[2] = 0x98badcfe;
+    state[3] = 0x10325476;
+}
+
+void MD5::processBlock(const unsigned char* block) {
+    uint32_t words[16];
+    for (int i = 0; i < 16; i++) words[i] = read32(block + i * 4);
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; i++) {
+        uint32_t f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) & 15;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) & 15;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) & 15;
+        }
+        uint32_t next = d;
+        d = c;
+        c = b;
+        b = b + rotl(a + f + kConstants[i] + words[g], kShifts[i]);
+        a = next;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+void MD5::update(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    totalSize += size;
+
+    // 이전 호출에서 남은 64바이트 블록 채우기
+    if (buffered > 0) {
+        size_t take = std::min(size, sizeof(buffer) - buffered);
+        std::memcpy(buffer + buffered, p, take);
+        buffered += take;
+        p += take;
+        size -= take;
+        if (buffered < sizeof(buffer)) return;
+        processBlock(buffer);
+        buffered = 0;
+    }
+
+    for (; size >= 64; p += 64, size -= 64) processBlock(p);
+
+    std::memcpy(buffer, p, size);
+    buffered = size;
+}
+
+std::string MD5::hexDigest(bool uppercase) {
+    // 패딩: 0x80, 0 으로 56바이트까지 채우고 비트 길이 (리틀 엔디언 64비트)
+    uint64_t bitLength = totalSize * 8;
+    static const unsigned char padding[64] = {0x80};
+    size_t padSize = buffered < 56 ? 56 - buffered : 120 - buffered;
+    update(padding, padSize);
+    unsigned char length[8];
+    for (int i = 0; i < 8; i++) length[i] = static_cast<unsigned char>(bitLength >> (i * 8));
+    update(length, sizeof(length));
+
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string hex(32, '0');
+    for (int i = 0; i < 16; i++) {
+        unsigned char byte = static_cast<unsigned char>(state[i / 4] >> ((i % 4) * 8));
+        hex[i * 2] = digits[byte >> 4];
+        hex[i * 2 + 1] = digits[byte & 15];
+    }
+    return hex;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// MD5 (RFC 1321). .gcode.3mf 의 plate_N.gcode.md5 처럼 프린터가 검사하는 체크섬용 (보안 용도 아님)
+class MD5 {
+public:
+    MD5();
+
+    void update(const void* data, size_t size);
+
+    // 32자리 16진수 (uppercase = true 면 대문자). 이후 update() 는 하지 않는다.
+    std::string hexDigest(bool uppercase = false);
+
+private:
+    void processBlock(const unsigned char* block);
+
+    uint32_t state[4];
+    unsigned char buffer[64];
+    size_t buffered = 0;
+    uint64_t totalSize = 0;
+};
@@ -0,0 +1,85 @@
+#include "meatpack.h"
+
+#include <cstdint>
+
+namespace {
+
+const unsigned char kSignalByte = 0xFF;
+const unsigned char kCommandEnablePacking = 251;
+const unsigned char kCommandEnableNoSpaces = 247;
+const uint8_t kNotPacked = 0xF;
+
+// 공백 생략 모드의 4비트 코드 (공백 자리 11 에 'E')
+const char kPackedChars[15] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', 'E', '\n', 'G', 'X'};
+
+struct PackTable {
+    uint8_t code[256];
+
+    PackTable() {
+        for (int i = 0; i < 256; i++) code[i] = kNotPacked;
+        for (uint8_t i = 0; i < 15; i++) code[static_cast<unsigned char>(kPackedChars[i])] = i;
+    }
+};
+
+const PackTable& packTable() {
+    static const PackTable table;
+    return table;
+}
+
+void appendCommand(std::vector<unsigned char>& out, unsigned char command) {
+    out.push_back(kSignalByte);
+    out.push_back(kSignalByte);
+    out.push_back(command);
+}
+
+// 두 글자 -> 니블 바이트 (첫 글자가 아래 니블) + 묶지 못한 글자
+void appendPair(std::vector<unsigned char>& out, unsigned char first, unsigned char second) {
+    const PackTable& table = packTable();
+    uint8_t low = table.code[first];
+    uint8_t high = table.code[second];
+    out.push_back(static_cast<unsigned char>((high << 4) | low));
+    if (low == kNotPacked) out.push_back(first);
+    if (high == kNotPacked) out.push_back(second);
+}
+
+} // namespace
+
+void meatpackEncode(const char* text, size_t size, bool keepComments, std::vector<unsigned char>& out) {
+    appendCommand(out, kCommandEnablePacking);
+    appendCommand(out, kCommandEnableNoSpaces);
+
+    bool pending = false;
+    unsigned char held = 0;
+    auto emit = [&](unsigned char c) {
+        if (pending) {
+            appendPair(out, held, c);
+            pending = false;
+        } else {
+            held = c;
+            pending = true;
+        }
+    };
+
+    size_t lineStart = 0;
+    while (lineStart < size) {
+        size_t lineEnd = lineStart;
+        while (lineEnd < size && text[lineEnd] != '\n') lineEnd++;
+
+        bool inComment = false;
+        bool empty = true;
+        for (size_t i = lineStart; i < lineEnd; i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c == '\r') continue;
+            if (c == ';') {
+                if (!keepComments) break;
+                inComment = true;
+            }
+            if (!inComment && (c == ' ' || c == '\t')) continue;
+            emit(c);
+            empty = false;
+        }
+        if (!empty) emit('\n');
+        lineStart = lineEnd + 1;
+    }
+    if (pending) emit('\n');
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// MeatPack G-code 문자 압축 (bgcode 의 G-code 블록 인코딩, Marlin/Prusa 펌웨어와 같은 규칙)
+// 자주 쓰는 15 글자 (0-9 . \n G X E) 는 4비트로, 나머지는 0xF 니블 + 원래 바이트로 두 글자씩 묶는다.
+// 블록마다 독립적으로 풀리도록 앞에 "패킹 켜기 + 공백 생략" 명령을 넣는다.
+//
+// keepComments = false : 주석을 지운다 (bgcode MeatPack)
+// keepComments = true  : 주석은 공백까지 그대로 둔다 (bgcode MeatPackComments)
+// 주석 밖의 공백과 '\r', 비게 된 줄은 지운다. 글자 수가 홀수면 끝에 '\n' 을 하나 더 넣어 짝을 맞춘다.
+
+// text 는 줄 단위로 끝나야 한다. out 뒤에 인코딩 결과를 붙인다.
+void meatpackEncode(const char* text, size_t size, bool keepComments, std::vector<unsigned char>& out);
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "geometry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// 메시 좌표 저장 타입
+// SLICER_FLOAT32_MESH 빌드에서는 float32 로 저장해 메시 메모리를 절반으로 줄인다.
+// 교차점/바운딩 박스 계산은 저장 타입과 무관하게 double 로 수행한다.
+#ifdef SLICER_FLOAT32_MESH
+using MeshScalar = float;
+#else
+using MeshScalar = double;
+#endif
+
+// 정점 인덱스 타입
+// SLICER_WIDE_INDEX(memory64 빌드) 에서는 64비트 인덱스로 40억 개 이상의 정점을 다룬다.
+#ifdef SLICER_WIDE_INDEX
+using MeshIndex = uint64_t;
+#else
+using MeshIndex = uint32_t;
+#endif
+
+// 인덱스 메시 (정점 좌표는 축별 배열(SoA) 로 저장)
+template <typename Scalar>
+class MeshT {
+public:
+    using ScalarType = Scalar;
+
+    // 인덱스 타입으로 표현 가능한 최대 정점 수
+    static constexpr size_t maxVertices() {
+        return static_cast<size_t>(std::numeric_limits<MeshIndex>::max());
+    }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        zs.clear();
+        indices.clear();
+    }
+
+    void reserve(size_t vertexCount, size_t triangleCount) {
+        xs.reserve(vertexCount);
+        ys.reserve(vertexCount);
+        zs.reserve(vertexCount);
+        indices.reserve(triangleCount * 3);
+    }
+
+    MeshIndex addVertex(double x, double y, double z) {
+        xs.push_back(static_cast<Scalar>(x));
+        ys.push_back(static_cast<Scalar>(y));
+        zs.push_back(static_cast<Scalar>(z));
+        return static_cast<MeshIndex>(xs.size() - 1);
+    }
+
+    // 이미 추가한 정점 좌표 바꾸기 (로더가 변환 행렬을 제자리에서 적용할 때)
+    void setVertex(size_t i, double x, double y, double z) {
+        xs[i] = static_cast<Scalar>(x);
+        ys[i] = static_cast<Scalar>(y);
+        zs[i] = static_cast<Scalar>(z);
+    }
+
+    void addTriangle(MeshIndex a, MeshIndex b, MeshIndex c) {
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+
+    bool empty() const { return indices.empty(); }
+    size_t vertexCount() const { return xs.size(); }
+    size_t triangleCount() const { return indices.size() / 3; }
+
+    Vector3 vertex(size_t i) const { return Vector3(xs[i], ys[i], zs[i]); }
+
+    Triangle triangle(size_t t) const {
+        const MeshIndex* idx = &indices[t * 3];
+        return Triangle(vertex(idx[0]), vertex(idx[1]), vertex(idx[2]));
+    }
+
+    const Scalar* xData() const { return xs.data(); }
+    const Scalar* yData() const { return ys.data(); }
+    const Scalar* zData() const { return zs.data(); }
+    const MeshIndex* indexData() const { return indices.data(); }
+
+    // 좌표 + 인덱스 버퍼가 차지하는 바이트 수
+    size_t memoryBytes() const {
+        return (xs.capacity() + ys.capacity() + zs.capacity()) * sizeof(Scalar) +
+               indices.capacity() * sizeof(MeshIndex);
+    }
+
+private:
+    std::vector<Scalar> xs, ys, zs;
+    std::vector<MeshIndex> indices;
+};
+
+using Mesh = MeshT<MeshScalar>;
@@ -0,0 +1,231 @@
+#include "mesh_analysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const size_t kVertexBlock = 1 << 16;
+const size_t kTriangleBlock = 1 << 14;
+
+struct Extent {
+    double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                    std::numeric_limits<double>::max()};
+    double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                    std::numeric_limits<double>::lowest()};
+};
+
+// 삼각형 블록 합 (박스 중심 기준 좌표)
+struct BlockSums {
+    double det = 0.0;                  // 6 x 부피
+    double detCenter[3] = {0, 0, 0};   // det x (a + b + c)
+    double area = 0.0;
+    double areaCenter[3] = {0, 0, 0};  // 넓이 x (a + b + c) / 3
+    size_t degenerate = 0;
+};
+
+template <typename Body>
+void forEach(ThreadPool* pool, size_t count, const Body& body) {
+    if (pool && pool->size() > 1 && count > 1) {
+        pool->parallelFor(count, body);
+    } else {
+        for (size_t i = 0; i < count; i++) body(i);
+    }
+}
+
+// 바이트 단위 LSD 기수 정렬 (모든 키가 같은 바이트는 건너뛴다)
+void radixSort(std::vector<uint64_t>& keys) {
+    size_t n = keys.size();
+    if (n < 2) return;
+    std::vector<size_t> histogram(8 * 256, 0);
+    for (uint64_t key : keys) {
+        for (int b = 0; b < 8; b++) histogram[b * 256 + ((key >> (b * 8)) & 0xff)]++;
+    }
+    std::vector<uint64_t> scratch(n);
+    for (int b = 0; b < 8; b++) {
+        size_t* counts = &histogram[b * 256];
+        if (counts[(keys[0] >> (b * 8)) & 0xff] == n) continue;
+        size_t offset = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t c = counts[d];
+            counts[d] = offset;
+            offset += c;
+        }
+        for (uint64_t key : keys) scratch[counts[(key >> (b * 8)) & 0xff]++] = key;
+        keys.swap(scratch);
+    }
+}
+
+// 정렬된 키에서 같은 변이 몇 번 나오는지 센다
+template <typename Key>
+void countEdges(const std::vector<Key>& keys, MeshAnalysis& out) {
+    size_t open = 0, nonManifold = 0;
+    for (size_t i = 0; i < keys.size();) {
+        size_t j = i + 1;
+        while (j < keys.size() && keys[j] == keys[i]) j++;
+        size_t uses = j - i;
+        if (uses == 1) open++;
+        if (uses > 2) nonManifold++;
+        i = j;
+    }
+    out.openEdges = static_cast<double>(open);
+    out.nonManifoldEdges = static_cast<double>(nonManifold);
+}
+
+} // namespace
+
+MeshAnalysis analyzeMesh(const Mesh& mesh, ThreadPool* pool) {
+    MeshAnalysis out;
+    size_t vertexCount = mesh.vertexCount();
+    size_t triangleCount = mesh.triangleCount();
+    out.vertices = static_cast<double>(vertexCount);
+    out.triangles = static_cast<double>(triangleCount);
+    if (vertexCount == 0) return out;
+
+    const MeshScalar* xs = mesh.xData();
+    const MeshScalar* ys = mesh.yData();
+    const MeshScalar* zs = mesh.zData();
+    const MeshIndex* indices = mesh.indexData();
+
+    // 1. 바운딩 박스 (축 배열 min/max, 자동 벡터화)
+    size_t vertexBlocks = (vertexCount + kVertexBlock - 1) / kVertexBlock;
+    std::vector<Extent> extents(vertexBlocks);
+    forEach(pool, vertexBlocks, [&](size_t b) {
+        size_t begin = b * kVertexBlock, end = std::min(vertexCount, begin + kVertexBlock);
+        const MeshScalar* axes[3] = {xs, ys, zs};
+        for (int a = 0; a < 3; a++) {
+            MeshScalar lo = axes[a][begin], hi = axes[a][begin];
+            for (size_t i = begin; i < end; i++) {
+                lo = std::min(lo, axes[a][i]);
+                hi = std::max(hi, axes[a][i]);
+            }
+            extents[b].lo[a] = lo;
+            extents[b].hi[a] = hi;
+        }
+    });
+    Extent box;
+    for (const Extent& e : extents) {
+        for (int a = 0; a < 3; a++) {
+            box.lo[a] = std::min(box.lo[a], e.lo[a]);
+            box.hi[a] = std::max(box.hi[a], e.hi[a]);
+        }
+    }
+    out.minX = box.lo[0], out.minY = box.lo[1], out.minZ = box.lo[2];
+    out.maxX = box.hi[0], out.maxY = box.hi[1], out.maxZ = box.hi[2];
+    const double center[3] = {(box.lo[0] + box.hi[0]) * 0.5, (box.lo[1] + box.hi[1]) * 0.5,
+                              (box.lo[2] + box.hi[2]) * 0.5};
+    if (triangleCount == 0) return out;
+
+    // 2. 삼각형 블록: 부피/넓이/중심 합 + 변 키
+    // 정점 번호가 32 비트에 들어가면 변을 (작은 번호 << 32 | 큰 번호) 한 칸으로, 아니면 번호 쌍으로 둔다
+    bool packed = vertexCount <= (uint64_t(1) << 32);
+    std::vector<uint64_t> packedKeys;
+    std::vector<std::pair<MeshIndex, MeshIndex>> pairKeys;
+    if (packed) {
+        packedKeys.resize(triangleCount * 3);
+    } else {
+        pairKeys.resize(triangleCount * 3);
+    }
+
+    size_t triangleBlocks = (triangleCount + kTriangleBlock - 1) / kTriangleBlock;
+    std::vector<BlockSums> sums(triangleBlocks);
+    std::vector<size_t> edgeCounts(triangleBlocks, 0);
+    forEach(pool, triangleBlocks, [&](size_t b) {
+        size_t begin = b * kTriangleBlock, end = std::min(triangleCount, begin + kTriangleBlock);
+        BlockSums s;
+        size_t edges = begin * 3;  // 블록은 자기 구간 [begin * 3, end * 3) 에만 쓰고 남은 칸은 나중에 압축
+        for (size_t t = begin; t < end; t++) {
+            MeshIndex v[3] = {indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]};
+            double p[3][3];
+            for (int k = 0; k < 3; k++) {
+                p[k][0] = double(xs[v[k]]) - center[0];
+                p[k][1] = double(ys[v[k]]) - center[1];
+                p[k][2] = double(zs[v[k]]) - center[2];
+            }
+            double e1[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+            double e2[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+            double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                           e1[0] * e2[1] - e1[1] * e2[0]};
+            double twiceArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            double det = p[0][0] * n[0] + p[0][1] * n[1] + p[0][2] * n[2];  // a . ((b - a) x (c - a)) = a . (b x c)
+            double sum[3] = {p[0][0] + p[1][0] + p[2][0], p[0][1] + p[1][1] + p[2][1], p[0][2] + p[1][2] + p[2][2]};
+
+            s.det += det;
+            s.area += twiceArea * 0.5;
+            for (int a = 0; a < 3; a++) {
+                s.detCenter[a] += det * sum[a];
+                s.areaCenter[a] += twiceArea * 0.5 * sum[a] * (1.0 / 3.0);
+            }
+
+            bool repeated = v[0] == v[1] || v[1] == v[2] || v[2] == v[0];
+            double scale = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2] + e2[0] * e2[0] + e2[1] * e2[1] +
+                           e2[2] * e2[2];
+            if (repeated || twiceArea <= 1e-12 * scale) s.degenerate++;
+
+            for (int k = 0; k < 3; k++) {
+                MeshIndex a = v[k], c = v[(k + 1) % 3];
+                if (a == c) continue;
+                if (a > c) std::swap(a, c);
+                if (packed) {
+                    packedKeys[edges++] = (uint64_t(a) << 32) | uint64_t(c);
+                } else {
+                    pairKeys[edges++] = {a, c};
+                }
+            }
+        }
+        sums[b] = s;
+        edgeCounts[b] = edges - begin * 3;
+    });
+
+    // 블록 순서대로 합친다
+    BlockSums total;
+    size_t degenerate = 0;
+    for (const BlockSums& s : sums) {
+        total.det += s.det;
+        total.area += s.area;
+        for (int a = 0; a < 3; a++) {
+            total.detCenter[a] += s.detCenter[a];
+            total.areaCenter[a] += s.areaCenter[a];
+        }
+        degenerate += s.degenerate;
+    }
+    out.volume = total.det / 6.0;
+    out.area = total.area;
+    out.degenerateTriangles = static_cast<double>(degenerate);
+
+    double local[3] = {0.0, 0.0, 0.0};
+    if (std::fabs(total.det) > 1e-12 * total.area * std::sqrt(total.area)) {
+        for (int a = 0; a < 3; a++) local[a] = total.detCenter[a] / (4.0 * total.det);
+    } else if (total.area > 0.0) {
+        for (int a = 0; a < 3; a++) local[a] = total.areaCenter[a] / total.area;
+    }
+    out.centroidX = local[0] + center[0];
+    out.centroidY = local[1] + center[1];
+    out.centroidZ = local[2] + center[2];
+
+    // 3. 변 키 압축 (건너뛴 자기 변 자리 제거) -> 정렬 -> 개수
+    auto compact = [&](auto& keys) {
+        size_t write = 0;
+        for (size_t b = 0; b < triangleBlocks; b++) {
+            size_t read = b * kTriangleBlock * 3;
+            if (write != read) std::move(keys.begin() + read, keys.begin() + read + edgeCounts[b], keys.begin() + write);
+            write += edgeCounts[b];
+        }
+        keys.resize(write);
+    };
+    if (packed) {
+        compact(packedKeys);
+        radixSort(packedKeys);
+        countEdges(packedKeys, out);
+    } else {
+        compact(pairKeys);
+        std::sort(pairKeys.begin(), pairKeys.end());
+        countEdges(pairKeys, out);
+    }
+    out.watertight = out.openEdges == 0 && out.nonManifoldEdges == 0;
+    return out;
+}
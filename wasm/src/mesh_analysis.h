@@ -0,0 +1,26 @@
+#pragma once
+
+#include "mesh.h"
+#include "thread_pool.h"
+
+// 메시 분석 (모델 정보 패널, 견적): 부피/넓이/무게중심/바운딩 박스와 메시 결함 수를 한 번에
+// 정점 축 배열을 한 번 훑어 바운딩 박스를 구하고, 삼각형 블록마다 (박스 중심 기준 좌표로) 부피/넓이/중심 합과
+// 변 키를 함께 만든다. 변 키를 정렬해 한 번만 쓰인 변 (열린 변) 과 세 번 이상 쓰인 변 (비다양체 변) 을 센다.
+// 블록은 ThreadPool 에서 병렬로, 합치는 순서는 고정이라 결과는 스레드 수와 무관하다.
+// 수는 embind value_object 로 그대로 넘기려고 double 로 둔다 (SlicerStats 와 같은 방식).
+
+struct MeshAnalysis {
+    double triangles = 0;
+    double vertices = 0;
+    double volume = 0;   // mm^3, 부호 있음 (바깥을 향한 반시계 감기면 양수)
+    double area = 0;     // mm^2
+    double centroidX = 0, centroidY = 0, centroidZ = 0;  // 부피 중심 (부피가 0 이면 표면 중심)
+    double minX = 0, minY = 0, minZ = 0;
+    double maxX = 0, maxY = 0, maxZ = 0;
+    double openEdges = 0;            // 삼각형 하나에만 속한 변
+    double nonManifoldEdges = 0;     // 삼각형 셋 이상이 공유하는 변
+    double degenerateTriangles = 0;  // 같은 정점을 두 번 쓰거나 넓이가 0 인 삼각형
+    bool watertight = false;         // 열린 변과 비다양체 변이 없음
+};
+
+MeshAnalysis analyzeMesh(const Mesh& mesh, ThreadPool* pool = nullptr);
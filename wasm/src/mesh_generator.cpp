@@ -0,0 +1,517 @@
+#include "mesh_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+struct Point3 {
+    double x, y, z;
+};
+
+Point3 sub(const Point3& a, const Point3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+
+Point3 cross(const Point3& a, const Point3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const Point3& a, const Point3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// 자이로이드 시트 marching tetrahedra
+// 격자점마다 값을 한 번 계산하고, 교차 모서리의 정점은 (격자점, 격자점) 키로 공유한다.
+class GyroidMesher {
+public:
+    GyroidMesher(Mesh& mesh, double size, double period, double thickness, size_t cells)
+        : mesh(mesh), cells(cells), size(size), step(size / cells) {
+        size_t n = cells + 1;
+        values.resize(n * n * n);
+        double k = 2 * kPi / period;
+        for (size_t z = 0; z < n; z++) {
+            for (size_t y = 0; y < n; y++) {
+                for (size_t x = 0; x < n; x++) {
+                    double value;
+                    if (x == 0 || y == 0 || z == 0 || x == cells || y == cells || z == cells) {
+                        // 경계 격자점은 바깥으로 두어 표면을 닫는다
+                        value = 1.0;
+                    } else {
+                        double px = x * step * k, py = y * step * k, pz = z * step * k;
+                        double g = std::sin(px) * std::cos(py) + std::sin(py) * std::cos(pz) +
+                                   std::sin(pz) * std::cos(px);
+                        value = g * g - thickness * thickness;
+                        // 정확히 0 이면 퇴화 삼각형이 생기므로 바깥으로 민다
+                        if (value == 0) value = 1e-12;
+                    }
+                    values[index(x, y, z)] = value;
+                }
+            }
+        }
+    }
+
+    void run() {
+        // 정육면체를 대각선(0-6)을 공유하는 사면체 6개로 나눈다
+        static const int kCorner[8][3] = {
+            {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+            {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+        static const int kTets[6][4] = {
+            {0, 5, 1, 6}, {0, 1, 2, 6}, {0, 2, 3, 6},
+            {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}};
+
+        for (size_t z = 0; z < cells; z++) {
+            for (size_t y = 0; y < cells; y++) {
+                for (size_t x = 0; x < cells; x++) {
+                    size_t corner[8];
+                    for (int c = 0; c < 8; c++) {
+                        corner[c] = index(x + kCorner[c][0], y + kCorner[c][1], z + kCorner[c][2]);
+                    }
+                    for (const auto& tet : kTets) {
+                        polygonize(corner[tet[0]], corner[tet[1]], corner[tet[2]], corner[tet[3]]);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    size_t index(size_t x, size_t y, size_t z) const {
+        size_t n = cells + 1;
+        return (z * n + y) * n + x;
+    }
+
+    Point3 position(size_t i) const {
+        size_t n = cells + 1;
+        size_t x = i % n, y = (i / n) % n, z = i / (n * n);
+        return {x * step - size / 2, y * step - size / 2, z * step};
+    }
+
+    MeshIndex edgeVertex(size_t a, size_t b) {
+        if (a > b) std::swap(a, b);
+        uint64_t key = static_cast<uint64_t>(a) * values.size() + b;
+        auto found = edgeVertices.find(key);
+        if (found != edgeVertices.end()) return found->second;
+
+        Point3 pa = position(a), pb = position(b);
+        double t = values[a] / (values[a] - values[b]);
+        MeshIndex id = mesh.addVertex(pa.x + t * (pb.x - pa.x),
+                                      pa.y + t * (pb.y - pa.y),
+                                      pa.z + t * (pb.z - pa.z));
+        edgeVertices.emplace(key, id);
+        return id;
+    }
+
+    // outward: 안쪽에서 바깥쪽을 향하는 방향 (삼각형 감기 방향을 맞추는 기준)
+    void emit(MeshIndex a, MeshIndex b, MeshIndex c, const Point3& outward) {
+        Point3 pa{mesh.xData()[a], mesh.yData()[a], mesh.zData()[a]};
+        Point3 pb{mesh.xData()[b], mesh.yData()[b], mesh.zData()[b]};
+        Point3 pc{mesh.xData()[c], mesh.yData()[c], mesh.zData()[c]};
+        if (dot(cross(sub(pb, pa), sub(pc, pa)), outward) < 0) std::swap(b, c);
+        mesh.addTriangle(a, b, c);
+    }
+
+    void polygonize(size_t v0, size_t v1, size_t v2, size_t v3) {
+        size_t v[4] = {v0, v1, v2, v3};
+        size_t in[4], out[4];
+        int inCount = 0, outCount = 0;
+        for (size_t i : v) {
+            if (values[i] < 0) in[inCount++] = i;
+            else out[outCount++] = i;
+        }
+        if (inCount == 0 || outCount == 0) return;
+
+        auto centroid = [this](const size_t* ids, int count) {
+            Point3 c{0, 0, 0};
+            for (int i = 0; i < count; i++) {
+                Point3 p = position(ids[i]);
+                c.x += p.x; c.y += p.y; c.z += p.z;
+            }
+            return Point3{c.x / count, c.y / count, c.z / count};
+        };
+        Point3 outward = sub(centroid(out, outCount), centroid(in, inCount));
+
+        if (inCount == 1 || outCount == 1) {
+            // 꼭짓점 하나만 반대편: 삼각형 하나
+            size_t apex = inCount == 1 ? in[0] : out[0];
+            const size_t* others = inCount == 1 ? out : in;
+            emit(edgeVertex(apex, others[0]), edgeVertex(apex, others[1]), edgeVertex(apex, others[2]),
+                 outward);
+        } else {
+            // 2:2 분할: 사각형을 삼각형 둘로
+            MeshIndex a = edgeVertex(in[0], out[0]);
+            MeshIndex b = edgeVertex(in[0], out[1]);
+            MeshIndex c = edgeVertex(in[1], out[1]);
+            MeshIndex d = edgeVertex(in[1], out[0]);
+            emit(a, b, c, outward);
+            emit(a, c, d, outward);
+        }
+    }
+
+    Mesh& mesh;
+    size_t cells;
+    double size;
+    double step;
+    std::vector<double> values;
+    std::unordered_map<uint64_t, MeshIndex> edgeVertices;
+};
+
+// 플랫폼과 표준 라이브러리에 관계없이 같은 수열을 내는 난수 (splitmix64)
+class SeededRandom {
+public:
+    explicit SeededRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+private:
+    uint64_t state;
+};
+
+// 멩거 스펀지 단계 level 의 셀이 채워져 있는지 (어느 자리에서든 두 좌표 이상이 가운데(1)면 빈 칸)
+bool mengerFilled(int x, int y, int z, int level) {
+    for (int i = 0; i < level; i++) {
+        int middle = (x % 3 == 1) + (y % 3 == 1) + (z % 3 == 1);
+        if (middle >= 2) return false;
+        x /= 3; y /= 3; z /= 3;
+    }
+    return true;
+}
+
+// 노출된 단위 면 수 (삼각형 수 = 2 * 면 수 * subdivisions^2)
+size_t mengerFaceCount(int level) {
+    int n = 1;
+    for (int i = 0; i < level; i++) n *= 3;
+    auto filled = [&](int x, int y, int z) {
+        return x >= 0 && y >= 0 && z >= 0 && x < n && y < n && z < n && mengerFilled(x, y, z, level);
+    };
+    size_t faces = 0;
+    for (int z = 0; z < n; z++) {
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+                if (!filled(x, y, z)) continue;
+                faces += !filled(x + 1, y, z) + !filled(x - 1, y, z) + !filled(x, y + 1, z) +
+                         !filled(x, y - 1, z) + !filled(x, y, z + 1) + !filled(x, y, z - 1);
+            }
+        }
+    }
+    return faces;
+}
+
+} // namespace
+
+void generateSphere(Mesh& mesh, double radius, size_t targetTriangles) {
+    // 삼각형 수 = 2 * slices * (stacks - 1), slices = 2 * stacks
+    size_t stacks = std::max<size_t>(3, static_cast<size_t>(std::lround(std::sqrt(targetTriangles / 4.0))));
+    size_t slices = stacks * 2;
+
+    mesh.clear();
+    mesh.reserve(slices * (stacks - 1) + 2, 2 * slices * (stacks - 1));
+
+    MeshIndex bottom = mesh.addVertex(0, 0, 0);
+    for (size_t i = 1; i < stacks; i++) {
+        double phi = kPi * i / stacks;          // 아래 극에서부터
+        double z = radius - radius * std::cos(phi);
+        double r = radius * std::sin(phi);
+        for (size_t j = 0; j < slices; j++) {
+            double theta = 2 * kPi * j / slices;
+            mesh.addVertex(r * std::cos(theta), r * std::sin(theta), z);
+        }
+    }
+    MeshIndex top = mesh.addVertex(0, 0, 2 * radius);
+
+    auto ring = [slices](size_t i, size_t j) {
+        return static_cast<MeshIndex>(1 + (i - 1) * slices + j % slices);
+    };
+
+    for (size_t j = 0; j < slices; j++) {
+        mesh.addTriangle(bottom, ring(1, j + 1), ring(1, j));
+    }
+    for (size_t i = 1; i + 1 < stacks; i++) {
+        for (size_t j = 0; j < slices; j++) {
+            mesh.addTriangle(ring(i, j), ring(i, j + 1), ring(i + 1, j + 1));
+            mesh.addTriangle(ring(i, j), ring(i + 1, j + 1), ring(i + 1, j));
+        }
+    }
+    for (size_t j = 0; j < slices; j++) {
+        mesh.addTriangle(top, ring(stacks - 1, j), ring(stacks - 1, j + 1));
+    }
+}
+
+void generateTorus(Mesh& mesh, double majorRadius, double minorRadius, size_t targetTriangles) {
+    // 삼각형 수 = 2 * major * minor
+    size_t major = std::max<size_t>(3, static_cast<size_t>(std::lround(std::sqrt(static_cast<double>(targetTriangles)))));
+    size_t minor = std::max<size_t>(3, static_cast<size_t>(std::lround(targetTriangles / (2.0 * major))));
+
+    mesh.clear();
+    mesh.reserve(major * minor, 2 * major * minor);
+
+    for (size_t i = 0; i < major; i++) {
+        double u = 2 * kPi * i / major;
+        for (size_t j = 0; j < minor; j++) {
+            double v = 2 * kPi * j / minor;
+            double r = majorRadius + minorRadius * std::cos(v);
+            mesh.addVertex(r * std::cos(u), r * std::sin(u), minorRadius + minorRadius * std::sin(v));
+        }
+    }
+
+    auto at = [major, minor](size_t i, size_t j) {
+        return static_cast<MeshIndex>((i % major) * minor + j % minor);
+    };
+    for (size_t i = 0; i < major; i++) {
+        for (size_t j = 0; j < minor; j++) {
+            mesh.addTriangle(at(i, j), at(i + 1, j), at(i + 1, j + 1));
+            mesh.addTriangle(at(i, j), at(i + 1, j + 1), at(i, j + 1));
+        }
+    }
+}
+
+void generateGyroid(Mesh& mesh, double size, double period, double thickness, size_t targetTriangles) {
+    // 주기당 4칸보다 거칠면 얇은 시트가 격자 사이로 빠져 형상이 무너지므로 그보다 낮추지 않는다.
+    // 목표가 그보다 작으면 최소 해상도 메시가 나온다.
+    size_t minCells = std::max<size_t>(8, static_cast<size_t>(std::ceil(4 * size / period)));
+
+    // 삼각형 수는 해상도의 거듭제곱에 가깝게 늘어난다 (해상이 충분하면 제곱).
+    // 최소 해상도와 그 두 배로 지수를 잰 뒤 목표 해상도를 외삽한다.
+    auto probe = [&](size_t cells) {
+        mesh.clear();
+        GyroidMesher mesher(mesh, size, period, thickness, cells);
+        mesher.run();
+        return std::max<double>(1.0, static_cast<double>(mesh.triangleCount()));
+    };
+    double low = probe(minCells);
+    if (low >= targetTriangles) return;
+    double high = probe(minCells * 2);
+    double exponent = std::max(1.0, std::log(high / low) / std::log(2.0));
+
+    size_t cells = std::max<size_t>(
+        minCells, static_cast<size_t>(std::lround(minCells * 2 * std::pow(targetTriangles / high, 1.0 / exponent))));
+    if (cells == minCells * 2) return;
+
+    // 외삽이 크게 빗나가면 실제 결과로 한 번 더 보정한다
+    double produced = probe(cells);
+    double ratio = targetTriangles / produced;
+    if (ratio > 1.15 || ratio < 0.85) {
+        double scale = std::min(1.5, std::max(0.66, std::sqrt(ratio)));
+        size_t corrected = std::max<size_t>(minCells, static_cast<size_t>(std::lround(cells * scale)));
+        if (corrected != cells) probe(corrected);
+    }
+}
+
+void generateMengerSponge(Mesh& mesh, double size, int level, int subdivisions) {
+    level = std::max(0, level);
+    subdivisions = std::max(1, subdivisions);
+    int n = 1;
+    for (int i = 0; i < level; i++) n *= 3;
+    int fine = n * subdivisions;
+    double step = size / fine;
+
+    mesh.clear();
+    std::unordered_map<uint64_t, MeshIndex> vertices;
+    auto vertex = [&](int x, int y, int z) {
+        uint64_t key = (static_cast<uint64_t>(z) * (fine + 1) + y) * (fine + 1) + x;
+        auto found = vertices.find(key);
+        if (found != vertices.end()) return found->second;
+        MeshIndex id = mesh.addVertex(x * step - size / 2, y * step - size / 2, z * step);
+        vertices.emplace(key, id);
+        return id;
+    };
+
+    auto filled = [&](int x, int y, int z) {
+        return x >= 0 && y >= 0 && z >= 0 && x < n && y < n && z < n && mengerFilled(x, y, z, level);
+    };
+
+    // 방향별 면: 이웃 셀 오프셋, 면 원점 오프셋(셀 단위), U x V 가 바깥 법선이 되는 두 축
+    struct Face {
+        int dx, dy, dz;
+        int ox, oy, oz;
+        int ux, uy, uz;
+        int vx, vy, vz;
+    };
+    static const Face kFaces[6] = {
+        {+1, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1},
+        {-1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
+        {0, +1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0},
+        {0, -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1},
+        {0, 0, +1, 0, 0, 1, 1, 0, 0, 0, 1, 0},
+        {0, 0, -1, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+    };
+
+    for (int z = 0; z < n; z++) {
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+                if (!filled(x, y, z)) continue;
+                for (const Face& f : kFaces) {
+                    if (filled(x + f.dx, y + f.dy, z + f.dz)) continue;
+                    int px = (x + f.ox) * subdivisions;
+                    int py = (y + f.oy) * subdivisions;
+                    int pz = (z + f.oz) * subdivisions;
+                    for (int b = 0; b < subdivisions; b++) {
+                        for (int a = 0; a < subdivisions; a++) {
+                            auto corner = [&](int da, int db) {
+                                return vertex(px + (a + da) * f.ux + (b + db) * f.vx,
+                                              py + (a + da) * f.uy + (b + db) * f.vy,
+                                              pz + (a + da) * f.uz + (b + db) * f.vz);
+                            };
+                            MeshIndex c0 = corner(0, 0), c1 = corner(1, 0);
+                            MeshIndex c2 = corner(1, 1), c3 = corner(0, 1);
+                            mesh.addTriangle(c0, c1, c2);
+                            mesh.addTriangle(c0, c2, c3);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void generateVase(Mesh& mesh, double radius, double height, double wall, int waves, double phase,
+                  size_t targetTriangles) {
+    // 삼각형 수 ~= 4 * segments * rings (외벽 + 내벽), segments = 4 * rings
+    size_t rings = std::max<size_t>(2, static_cast<size_t>(std::lround(std::sqrt(targetTriangles / 16.0))));
+    size_t segments = std::max<size_t>(std::max<size_t>(16, 8 * static_cast<size_t>(std::max(waves, 0))),
+                                       rings * 4);
+    double floor = wall;
+    double amplitude = 0.08;
+
+    // 배 부분이 불룩한 윤곽 + 높이에 따라 비틀리는 물결
+    auto outerRadius = [&](double theta, double z) {
+        double t = z / height;
+        double profile = radius * (0.7 + 0.3 * std::sin(kPi * t)) / (1 + amplitude);
+        return profile * (1 + amplitude * std::sin(waves * theta + phase + 2 * kPi * t));
+    };
+
+    mesh.clear();
+    mesh.reserve(2 * segments * (rings + 1) + 2, 4 * segments * rings + 4 * segments);
+
+    auto addRing = [&](double z, bool inner) {
+        for (size_t j = 0; j < segments; j++) {
+            double theta = 2 * kPi * j / segments;
+            double r = outerRadius(theta, z) - (inner ? wall : 0);
+            mesh.addVertex(r * std::cos(theta), r * std::sin(theta), z);
+        }
+    };
+
+    MeshIndex outerBase = static_cast<MeshIndex>(mesh.vertexCount());
+    for (size_t i = 0; i <= rings; i++) addRing(height * i / rings, false);
+    MeshIndex innerBase = static_cast<MeshIndex>(mesh.vertexCount());
+    for (size_t i = 0; i <= rings; i++) addRing(floor + (height - floor) * i / rings, true);
+    MeshIndex bottomCenter = mesh.addVertex(0, 0, 0);
+    MeshIndex floorCenter = mesh.addVertex(0, 0, floor);
+
+    auto outer = [&](size_t i, size_t j) {
+        return static_cast<MeshIndex>(outerBase + i * segments + j % segments);
+    };
+    auto inner = [&](size_t i, size_t j) {
+        return static_cast<MeshIndex>(innerBase + i * segments + j % segments);
+    };
+
+    for (size_t i = 0; i < rings; i++) {
+        for (size_t j = 0; j < segments; j++) {
+            // 외벽은 바깥, 내벽은 축 쪽을 향한다
+            mesh.addTriangle(outer(i, j), outer(i, j + 1), outer(i + 1, j + 1));
+            mesh.addTriangle(outer(i, j), outer(i + 1, j + 1), outer(i + 1, j));
+            mesh.addTriangle(inner(i, j), inner(i + 1, j + 1), inner(i, j + 1));
+            mesh.addTriangle(inner(i, j), inner(i + 1, j), inner(i + 1, j + 1));
+        }
+    }
+    for (size_t j = 0; j < segments; j++) {
+        // 바닥면(아래), 안쪽 바닥(위), 입구 테두리(위)
+        mesh.addTriangle(bottomCenter, outer(0, j + 1), outer(0, j));
+        mesh.addTriangle(floorCenter, inner(0, j), inner(0, j + 1));
+        mesh.addTriangle(outer(rings, j), outer(rings, j + 1), inner(rings, j + 1));
+        mesh.addTriangle(outer(rings, j), inner(rings, j + 1), inner(rings, j));
+    }
+}
+
+const char* testMeshShapeName(TestMeshShape shape) {
+    switch (shape) {
+        case TestMeshShape::Sphere: return "sphere";
+        case TestMeshShape::Torus: return "torus";
+        case TestMeshShape::Menger: return "menger";
+        case TestMeshShape::Vase: return "vase";
+        case TestMeshShape::Gyroid: return "gyroid";
+    }
+    return "unknown";
+}
+
+bool parseTestMeshShape(const std::string& name, TestMeshShape& shape) {
+    for (TestMeshShape s : {TestMeshShape::Sphere, TestMeshShape::Torus, TestMeshShape::Menger,
+                            TestMeshShape::Vase, TestMeshShape::Gyroid}) {
+        if (name == testMeshShapeName(s)) {
+            shape = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+void generateTestMesh(Mesh& mesh, const TestMeshOptions& options) {
+    SeededRandom random(options.seed);
+    uint32_t islands = std::max<uint32_t>(1, options.islands);
+    size_t perIsland = std::max<size_t>(1, options.triangles / islands);
+    double size = options.size;
+    double complexity = std::max(0.1, options.complexity);
+
+    // 섬 하나를 만든 뒤 복사해 배치한다
+    Mesh island;
+    switch (options.shape) {
+        case TestMeshShape::Sphere:
+            generateSphere(island, size / 2, perIsland);
+            break;
+        case TestMeshShape::Torus:
+            generateTorus(island, size * 0.35, size * 0.15, perIsland);
+            break;
+        case TestMeshShape::Menger: {
+            // 목표를 넘지 않는 가장 높은 단계(최대 4)를 고르고 면 분할로 나머지를 채운다
+            int level = 1;
+            while (level < 4 && 2 * mengerFaceCount(level + 1) <= perIsland) level++;
+            double faces = static_cast<double>(mengerFaceCount(level));
+            int subdivisions = std::max(1, static_cast<int>(std::sqrt(perIsland / (2 * faces))));
+            generateMengerSponge(island, size, level, subdivisions);
+            break;
+        }
+        case TestMeshShape::Vase: {
+            int waves = std::max(1, static_cast<int>(std::lround(6 * complexity)));
+            generateVase(island, size / 2, size * 1.5, 0.8, waves, random.uniform(0, 2 * kPi), perIsland);
+            break;
+        }
+        case TestMeshShape::Gyroid:
+            generateGyroid(island, size, size / (4 * complexity), 0.4, perIsland);
+            break;
+    }
+
+    mesh.clear();
+    mesh.reserve(island.vertexCount() * islands, island.triangleCount() * islands);
+
+    uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(islands))));
+    uint32_t rows = (islands + columns - 1) / columns;
+    double spacing = size * 1.25;
+    double jitter = islands > 1 ? size * 0.1 : 0.0;
+
+    for (uint32_t k = 0; k < islands; k++) {
+        double angle = islands > 1 ? random.uniform(0, 2 * kPi) : 0.0;
+        double cx = ((k % columns) - (columns - 1) / 2.0) * spacing + random.uniform(-jitter, jitter);
+        double cy = ((k / columns) - (rows - 1) / 2.0) * spacing + random.uniform(-jitter, jitter);
+        double c = std::cos(angle), s = std::sin(angle);
+
+        MeshIndex base = static_cast<MeshIndex>(mesh.vertexCount());
+        for (size_t i = 0; i < island.vertexCount(); i++) {
+            double x = island.xData()[i], y = island.yData()[i];
+            mesh.addVertex(cx + c * x - s * y, cy + s * x + c * y, island.zData()[i]);
+        }
+        const MeshIndex* idx = island.indexData();
+        for (size_t t = 0; t < island.triangleCount(); t++) {
+            mesh.addTriangle(base + idx[t * 3], base + idx[t * 3 + 1], base + idx[t * 3 + 2]);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 벤치마크/테스트용 절차적 메시 생성
+// 모든 메시는 바닥이 z = 0 에 놓이고 xy 원점 중심이며, 바깥쪽을 향하는 반시계 방향 삼각형으로 만든다.
+// 삼각형 수는 targetTriangles 에 가깝게 맞추되 정확히 같지는 않다.
+
+// UV 구 (위도/경도 분할)
+void generateSphere(Mesh& mesh, double radius, size_t targetTriangles);
+
+// z 축을 중심으로 누운 토러스
+void generateTorus(Mesh& mesh, double majorRadius, double minorRadius, size_t targetTriangles);
+
+// 자이로이드 시트 격자 (|sin x cos y + sin y cos z + sin z cos x| < thickness 인 영역)
+// 한 변 size 인 정육면체 안을 marching tetrahedra 로 삼각형화하며, 경계에서 닫힌 솔리드가 된다.
+// 레이어마다 수많은 작은 섬(island)과 짧은 교차 구간이 생겨 슬라이싱 최악 경우에 가깝다.
+void generateGyroid(Mesh& mesh, double size, double period, double thickness, size_t targetTriangles);
+
+// 멩거 스펀지 (한 변 size, 단계 level). 단위 면을 subdivisions x subdivisions 로 나눠 삼각형 수를 맞춘다.
+// 수평면이 레이어 높이와 겹치고 구멍이 많아 레이어당 윤곽선 수가 크다.
+void generateMengerSponge(Mesh& mesh, double size, int level, int subdivisions = 1);
+
+// 얇은 벽 꽃병 (물결 모양 외벽, 두께 wall 의 벽과 바닥)
+// waves 가 클수록 레이어당 윤곽선이 길고 구불구불해진다.
+void generateVase(Mesh& mesh, double radius, double height, double wall, int waves, double phase,
+                  size_t targetTriangles);
+
+enum class TestMeshShape {
+    Sphere,
+    Torus,
+    Menger,
+    Vase,
+    Gyroid,
+};
+
+const char* testMeshShapeName(TestMeshShape shape);
+bool parseTestMeshShape(const std::string& name, TestMeshShape& shape);
+
+// 테스트 메시 조합 옵션
+struct TestMeshOptions {
+    TestMeshShape shape = TestMeshShape::Sphere;
+    size_t triangles = 100000;   // 전체 목표 삼각형 수 (섬들에 나눠 배분)
+    uint32_t islands = 1;        // 서로 떨어진 복사본 수 (레이어당 윤곽선/섬 수)
+    double complexity = 1.0;     // 레이어 내 형상 빈도 (꽃병 물결 수, 자이로이드 셀 수)
+    double size = 40.0;          // 섬 하나의 xy 크기 (mm)
+    uint64_t seed = 1;           // 같은 시드면 항상 같은 메시
+};
+
+// 옵션대로 메시를 만든다. 섬은 격자로 배치하고 시드에 따라 회전/위치를 흔든다.
+void generateTestMesh(Mesh& mesh, const TestMeshOptions& options);
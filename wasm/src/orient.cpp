@@ -0,0 +1,361 @@
+#include "orient.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const size_t kTriangleBlock = 4096;  // 블록 하나의 SoA (7 x 16KB) 가 L2 에 들어간다
+const size_t kVertexBlock = 1024;    // 높이 범위 계산의 경계 구 단위
+const size_t kLanes = 8;
+
+// 넓은 평면 후보: 법선을 정육면체 면 6 x 16 x 16 칸에 모아 넓이가 큰 칸부터
+const int kNormalBins = 16;
+const size_t kPlaneCandidates = 32;
+
+// 삼각형 속성 (메시 중심 기준 float, 축별 배열)
+struct TriangleSoA {
+    std::vector<float> nx, ny, nz, area, cx, cy, cz;
+
+    void resize(size_t n) {
+        for (auto* v : {&nx, &ny, &nz, &area, &cx, &cy, &cz}) v->resize(n);
+    }
+};
+
+struct VertexSoA {
+    std::vector<float> x, y, z;
+    // 블록별 경계 구 (중심 + 반지름) 로 높이 범위 계산에서 블록을 건너뛴다
+    std::vector<float> sphere;  // [cx, cy, cz, r] 반복
+};
+
+// 후보 하나의 삼각형 블록 합
+struct Sums {
+    double overhangArea = 0.0;
+    double projected = 0.0;        // sum(a * dn)        (오버행 면)
+    double projectedHeight = 0.0;  // sum(a * dn * h)    (오버행 면, h 는 중심 기준 높이)
+    double contactArea = 0.0;
+};
+
+void quaternionToDown(OrientCandidate& c) {
+    // a = down, b = (0, 0, -1): q = (a x b, 1 + a.b) 정규화
+    double ax = c.downX, ay = c.downY, az = c.downZ;
+    double dot = -az;
+    if (dot < -1.0 + 1e-9) {
+        // 반대 방향: X 축으로 180 도
+        c.qx = 1.0;
+        c.qy = c.qz = c.qw = 0.0;
+        return;
+    }
+    double qx = -ay, qy = ax, qz = 0.0, qw = 1.0 + dot;
+    double length = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+    c.qx = qx / length;
+    c.qy = qy / length;
+    c.qz = qz / length;
+    c.qw = qw / length;
+}
+
+int normalBin(float x, float y, float z) {
+    float ax = std::fabs(x), ay = std::fabs(y), az = std::fabs(z);
+    int face;
+    float u, v, m;
+    if (ax >= ay && ax >= az) {
+        face = x > 0 ? 0 : 1;
+        m = ax, u = y, v = z;
+    } else if (ay >= az) {
+        face = y > 0 ? 2 : 3;
+        m = ay, u = x, v = z;
+    } else {
+        face = z > 0 ? 4 : 5;
+        m = az, u = x, v = y;
+    }
+    if (m <= 0.0f) return -1;
+    int iu = std::min(kNormalBins - 1, static_cast<int>((u / m * 0.5f + 0.5f) * kNormalBins));
+    int iv = std::min(kNormalBins - 1, static_cast<int>((v / m * 0.5f + 0.5f) * kNormalBins));
+    return (face * kNormalBins + std::max(iu, 0)) * kNormalBins + std::max(iv, 0);
+}
+
+template <typename Body>
+void forEach(ThreadPool* pool, size_t count, const Body& body) {
+    if (pool && count > 1) {
+        pool->parallelFor(count, body);
+    } else {
+        for (size_t i = 0; i < count; i++) body(i);
+    }
+}
+
+} // namespace
+
+std::vector<OrientCandidate> findOrientations(const Mesh& mesh, const OrientOptions& options, ThreadPool* pool) {
+    size_t triangleCount = mesh.triangleCount();
+    size_t vertexCount = mesh.vertexCount();
+    if (triangleCount == 0 || vertexCount == 0) return {};
+
+    // 메시 중심 (float 정밀도 확보)
+    double center[3] = {0.0, 0.0, 0.0};
+    {
+        double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::max()};
+        double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                        std::numeric_limits<double>::lowest()};
+        const MeshScalar* axes[3] = {mesh.xData(), mesh.yData(), mesh.zData()};
+        for (int a = 0; a < 3; a++) {
+            for (size_t i = 0; i < vertexCount; i++) {
+                lo[a] = std::min(lo[a], double(axes[a][i]));
+                hi[a] = std::max(hi[a], double(axes[a][i]));
+            }
+            center[a] = (lo[a] + hi[a]) * 0.5;
+        }
+    }
+
+    // 정점 (중심 기준 float) + 블록 경계 구
+    VertexSoA vertices;
+    vertices.x.resize(vertexCount);
+    vertices.y.resize(vertexCount);
+    vertices.z.resize(vertexCount);
+    size_t vertexBlocks = (vertexCount + kVertexBlock - 1) / kVertexBlock;
+    vertices.sphere.resize(vertexBlocks * 4);
+    forEach(pool, vertexBlocks, [&](size_t b) {
+        size_t begin = b * kVertexBlock, end = std::min(vertexCount, begin + kVertexBlock);
+        float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                       std::numeric_limits<float>::max()};
+        float hi[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                       std::numeric_limits<float>::lowest()};
+        for (size_t i = begin; i < end; i++) {
+            float p[3] = {float(mesh.xData()[i] - center[0]), float(mesh.yData()[i] - center[1]),
+                          float(mesh.zData()[i] - center[2])};
+            vertices.x[i] = p[0];
+            vertices.y[i] = p[1];
+            vertices.z[i] = p[2];
+            for (int a = 0; a < 3; a++) {
+                lo[a] = std::min(lo[a], p[a]);
+                hi[a] = std::max(hi[a], p[a]);
+            }
+        }
+        float* s = &vertices.sphere[b * 4];
+        float r2 = 0.0f;
+        for (int a = 0; a < 3; a++) {
+            s[a] = (lo[a] + hi[a]) * 0.5f;
+            r2 += (hi[a] - lo[a]) * (hi[a] - lo[a]) * 0.25f;
+        }
+        s[3] = std::sqrt(r2) * 1.0001f;
+    });
+
+    // 삼각형 법선/넓이/중심 (정점 float 좌표에서, 블록 병렬)
+    TriangleSoA triangles;
+    triangles.resize(triangleCount);
+    size_t triangleBlocks = (triangleCount + kTriangleBlock - 1) / kTriangleBlock;
+    std::vector<double> blockArea(triangleBlocks, 0.0);
+    forEach(pool, triangleBlocks, [&](size_t b) {
+        size_t begin = b * kTriangleBlock, end = std::min(triangleCount, begin + kTriangleBlock);
+        const MeshIndex* indices = mesh.indexData();
+        double total = 0.0;
+        for (size_t t = begin; t < end; t++) {
+            MeshIndex i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            float ax = vertices.x[i0], ay = vertices.y[i0], az = vertices.z[i0];
+            float e1x = vertices.x[i1] - ax, e1y = vertices.y[i1] - ay, e1z = vertices.z[i1] - az;
+            float e2x = vertices.x[i2] - ax, e2y = vertices.y[i2] - ay, e2z = vertices.z[i2] - az;
+            float nx = e1y * e2z - e1z * e2y, ny = e1z * e2x - e1x * e2z, nz = e1x * e2y - e1y * e2x;
+            float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+            triangles.nx[t] = nx * inverse;
+            triangles.ny[t] = ny * inverse;
+            triangles.nz[t] = nz * inverse;
+            triangles.area[t] = length * 0.5f;
+            triangles.cx[t] = ax + (e1x + e2x) * (1.0f / 3.0f);
+            triangles.cy[t] = ay + (e1y + e2y) * (1.0f / 3.0f);
+            triangles.cz[t] = az + (e1z + e2z) * (1.0f / 3.0f);
+            total += length * 0.5f;
+        }
+        blockArea[b] = total;
+    });
+    double totalArea = 0.0;
+    for (double a : blockArea) totalArea += a;
+
+    // 후보 방향: 피보나치 구면 + 축 6 개 + 넓은 평면의 법선
+    std::vector<OrientCandidate> candidates;
+    auto addDirection = [&](double x, double y, double z) {
+        double length = std::sqrt(x * x + y * y + z * z);
+        if (length <= 0.0) return;
+        OrientCandidate c;
+        c.downX = x / length;
+        c.downY = y / length;
+        c.downZ = z / length;
+        candidates.push_back(c);
+    };
+    addDirection(0, 0, -1);
+    addDirection(0, 0, 1);
+    addDirection(1, 0, 0);
+    addDirection(-1, 0, 0);
+    addDirection(0, 1, 0);
+    addDirection(0, -1, 0);
+    {
+        std::vector<double> bins(6 * kNormalBins * kNormalBins * 4, 0.0);  // 넓이, 넓이 가중 법선 합
+        for (size_t t = 0; t < triangleCount; t++) {
+            int bin = normalBin(triangles.nx[t], triangles.ny[t], triangles.nz[t]);
+            if (bin < 0) continue;
+            double a = triangles.area[t];
+            bins[bin * 4] += a;
+            bins[bin * 4 + 1] += a * triangles.nx[t];
+            bins[bin * 4 + 2] += a * triangles.ny[t];
+            bins[bin * 4 + 3] += a * triangles.nz[t];
+        }
+        std::vector<std::pair<double, int>> byArea;
+        for (int b = 0; b < 6 * kNormalBins * kNormalBins; b++) {
+            if (bins[b * 4] > totalArea * 1e-3) byArea.push_back({bins[b * 4], b});
+        }
+        std::sort(byArea.begin(), byArea.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+        for (size_t i = 0; i < std::min(kPlaneCandidates, byArea.size()); i++) {
+            int b = byArea[i].second;
+            addDirection(bins[b * 4 + 1], bins[b * 4 + 2], bins[b * 4 + 3]);
+        }
+    }
+    const double goldenAngle = kPi * (3.0 - std::sqrt(5.0));
+    for (int i = 0; i < options.samples; i++) {
+        double z = 1.0 - 2.0 * (i + 0.5) / options.samples;
+        double r = std::sqrt(std::max(0.0, 1.0 - z * z));
+        addDirection(r * std::cos(goldenAngle * i), r * std::sin(goldenAngle * i), z);
+    }
+    size_t candidateCount = candidates.size();
+
+    // 후보별 높이 범위 (up = -down 방향 정점 투영의 최소/최대, 경계 구로 블록 건너뜀)
+    std::vector<float> minHeight(candidateCount), maxHeight(candidateCount);
+    forEach(pool, candidateCount, [&](size_t k) {
+        float ux = float(-candidates[k].downX), uy = float(-candidates[k].downY), uz = float(-candidates[k].downZ);
+        float lo = std::numeric_limits<float>::max(), hi = std::numeric_limits<float>::lowest();
+        for (size_t b = 0; b < vertexBlocks; b++) {
+            const float* s = &vertices.sphere[b * 4];
+            float c = s[0] * ux + s[1] * uy + s[2] * uz;
+            if (c - s[3] >= lo && c + s[3] <= hi) continue;
+            size_t begin = b * kVertexBlock, end = std::min(vertexCount, begin + kVertexBlock);
+            for (size_t i = begin; i < end; i++) {
+                float h = vertices.x[i] * ux + vertices.y[i] * uy + vertices.z[i] * uz;
+                lo = std::min(lo, h);
+                hi = std::max(hi, h);
+            }
+        }
+        minHeight[k] = lo;
+        maxHeight[k] = hi;
+    });
+
+    // 삼각형 블록 x 모든 후보 (블록 SoA 가 캐시에 있는 동안 후보를 돌린다)
+    const float overhangCos = float(std::cos(options.overhangAngle * kPi / 180.0));
+    const float tolerance = float(options.contactTolerance);
+    std::vector<Sums> blockSums(triangleBlocks * candidateCount);
+    forEach(pool, triangleBlocks, [&](size_t b) {
+        size_t begin = b * kTriangleBlock, end = std::min(triangleCount, begin + kTriangleBlock);
+        const float* nx = triangles.nx.data();
+        const float* ny = triangles.ny.data();
+        const float* nz = triangles.nz.data();
+        const float* area = triangles.area.data();
+        const float* cx = triangles.cx.data();
+        const float* cy = triangles.cy.data();
+        const float* cz = triangles.cz.data();
+        for (size_t k = 0; k < candidateCount; k++) {
+            const float dx = float(candidates[k].downX), dy = float(candidates[k].downY),
+                        dz = float(candidates[k].downZ);
+            const float contactBelow = -minHeight[k] - tolerance;  // h = -(c . d) 이므로 c . d >= 이 값이면 접촉
+            float overhang[kLanes] = {}, projected[kLanes] = {}, projectedHeight[kLanes] = {}, contact[kLanes] = {};
+
+            size_t t = begin;
+            for (; t + kLanes <= end; t += kLanes) {
+                for (size_t l = 0; l < kLanes; l++) {
+                    size_t i = t + l;
+                    float dn = nx[i] * dx + ny[i] * dy + nz[i] * dz;
+                    float depth = cx[i] * dx + cy[i] * dy + cz[i] * dz;
+                    bool down = dn > overhangCos;
+                    bool touching = down && depth >= contactBelow;
+                    bool support = down && !touching;
+                    float a = area[i];
+                    overhang[l] += support ? a : 0.0f;
+                    projected[l] += support ? a * dn : 0.0f;
+                    projectedHeight[l] += support ? -a * dn * depth : 0.0f;
+                    contact[l] += touching ? a : 0.0f;
+                }
+            }
+            Sums& sums = blockSums[b * candidateCount + k];
+            for (; t < end; t++) {
+                float dn = nx[t] * dx + ny[t] * dy + nz[t] * dz;
+                float depth = cx[t] * dx + cy[t] * dy + cz[t] * dz;
+                if (dn <= overhangCos) continue;
+                if (depth >= contactBelow) {
+                    sums.contactArea += area[t];
+                } else {
+                    sums.overhangArea += area[t];
+                    sums.projected += area[t] * dn;
+                    sums.projectedHeight += -area[t] * dn * depth;
+                }
+            }
+            for (size_t l = 0; l < kLanes; l++) {
+                sums.overhangArea += overhang[l];
+                sums.projected += projected[l];
+                sums.projectedHeight += projectedHeight[l];
+                sums.contactArea += contact[l];
+            }
+        }
+    });
+
+    // 블록 순서대로 합쳐 점수 계산
+    double diagonal = 0.0;
+    {
+        double lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+        for (size_t b = 0; b < vertexBlocks; b++) {
+            for (int a = 0; a < 3; a++) {
+                double c = vertices.sphere[b * 4 + a], r = vertices.sphere[b * 4 + 3];
+                lo[a] = std::min(lo[a], c - r);
+                hi[a] = std::max(hi[a], c + r);
+            }
+        }
+        diagonal = std::sqrt((hi[0] - lo[0]) * (hi[0] - lo[0]) + (hi[1] - lo[1]) * (hi[1] - lo[1]) +
+                             (hi[2] - lo[2]) * (hi[2] - lo[2]));
+    }
+    diagonal = std::max(diagonal, 1e-9);
+    totalArea = std::max(totalArea, 1e-12);
+
+    for (size_t k = 0; k < candidateCount; k++) {
+        Sums total;
+        for (size_t b = 0; b < triangleBlocks; b++) {
+            const Sums& s = blockSums[b * candidateCount + k];
+            total.overhangArea += s.overhangArea;
+            total.projected += s.projected;
+            total.projectedHeight += s.projectedHeight;
+            total.contactArea += s.contactArea;
+        }
+        OrientCandidate& c = candidates[k];
+        c.overhangArea = total.overhangArea;
+        c.supportVolume = std::max(0.0, total.projectedHeight - minHeight[k] * total.projected);
+        c.contactArea = total.contactArea;
+        c.height = double(maxHeight[k]) - double(minHeight[k]);
+        c.score = options.supportWeight * c.supportVolume / (diagonal * diagonal * diagonal) +
+                  options.overhangWeight * c.overhangArea / totalArea -
+                  options.contactWeight * c.contactArea / totalArea + options.heightWeight * c.height / diagonal;
+        if (options.minContactArea > 0.0 && c.contactArea < options.minContactArea) {
+            c.score += options.stabilityWeight * (1.0 - c.contactArea / options.minContactArea);
+        }
+        quaternionToDown(c);
+    }
+
+    std::vector<size_t> order(candidateCount);
+    for (size_t k = 0; k < candidateCount; k++) order[k] = k;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return candidates[a].score < candidates[b].score; });
+
+    // 거의 같은 방향 (1 도 이내) 은 하나만
+    std::vector<OrientCandidate> result;
+    const double sameDirection = std::cos(kPi / 180.0);
+    for (size_t k : order) {
+        if (result.size() >= static_cast<size_t>(std::max(0, options.topCount))) break;
+        const OrientCandidate& c = candidates[k];
+        bool duplicate = false;
+        for (const OrientCandidate& r : result) {
+            if (c.downX * r.downX + c.downY * r.downY + c.downZ * r.downZ > sameDirection) duplicate = true;
+        }
+        if (!duplicate) result.push_back(c);
+    }
+    return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mesh.h"
+#include "thread_pool.h"
+
+#include <vector>
+
+// 자동 방향 찾기
+// 구면 위의 후보 "아래" 방향마다 메시를 바닥 (-Z) 에 놓았다고 보고 점수를 매긴다 (낮을수록 좋음):
+//   서포트 부피 (아래를 보는 면의 투영 넓이 x 바닥에서의 높이), 오버행 넓이, 바닥 접촉 넓이 (감점), 높이,
+//   접촉 넓이가 minContactArea 보다 작은 자세 (모서리/꼭짓점으로 선 자세) 의 불안정 벌점.
+// 후보는 피보나치 구면 샘플 + 축 6 개 + 넓은 평면의 법선 (평면이 바닥에 닿는 방향) 이다.
+// 삼각형 법선/넓이/중심을 float SoA 로 한 번 만들어 두고, 삼각형 블록마다 모든 후보를 레인 8 개로 누적한다
+// (자동 벡터화). 블록은 ThreadPool 에서 병렬로, 합치는 순서는 고정이라 결과는 스레드 수와 무관하다.
+
+struct OrientOptions {
+    int samples = 256;              // 피보나치 구면 후보 수
+    int topCount = 5;               // 돌려줄 후보 수
+    double overhangAngle = 45.0;    // 수직에서 이 각도보다 더 누운 아래 방향 면은 서포트가 필요 (도)
+    double contactTolerance = 0.2;  // 바닥에서 이 높이 안의 아래 방향 면은 바닥 접촉 (mm)
+    double minContactArea = 1.0;    // 이보다 좁게 바닥에 닿으면 설 수 없는 자세로 본다 (mm^2)
+
+    // 점수 가중치 (서포트 부피 / 대각선^3, 오버행과 접촉 넓이 / 전체 넓이, 높이 / 대각선 에 곱한다)
+    double supportWeight = 2.0;
+    double overhangWeight = 1.0;
+    double contactWeight = 1.0;
+    double heightWeight = 0.25;
+    // 접촉이 minContactArea 보다 부족한 비율에 곱한다 (접촉 0 이면 전부). 다른 항의 합보다 커서
+    // 면으로 설 수 있는 자세가 있으면 그쪽이 먼저 온다.
+    double stabilityWeight = 10.0;
+};
+
+struct OrientCandidate {
+    double downX = 0.0, downY = 0.0, downZ = -1.0;  // 모델 좌표에서 바닥으로 보낼 방향 (단위 벡터)
+    double qx = 0.0, qy = 0.0, qz = 0.0, qw = 1.0;  // down -> (0, 0, -1) 회전 쿼터니언
+    double score = 0.0;
+    double overhangArea = 0.0;   // mm^2
+    double supportVolume = 0.0;  // mm^3 (추정)
+    double contactArea = 0.0;    // mm^2
+    double height = 0.0;         // mm
+};
+
+// 점수가 낮은 순으로 최대 topCount 개. 메시가 비어 있으면 빈 배열.
+std::vector<OrientCandidate> findOrientations(const Mesh& mesh, const OrientOptions& options = OrientOptions(),
+                                              ThreadPool* pool = nullptr);
@@ -0,0 +1,516 @@
+#include "simple_slicer.h"
+
+#include "gcode_writer.h"
+#include "mesh_generator.h"
+#include "slice_kernels.h"
+#include "slicer_stats.h"
+#include "stl_reader.h"
+#include "threemf_reader.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <sstream>
+
+bool SimpleSlicer::parseSTL(const std::string& stlData) {
+    if (loadSTL(reinterpret_cast<const unsigned char*>(stlData.data()), stlData.size())) return true;
+
+    // STL 이 아닌 입력(테스트 호출)은 기존처럼 테스트 큐브로 대체
+    mesh.clear();
+    createTestCube();
+    return true;
+}
+
+bool SimpleSlicer::loadSTL(std::istream& in) {
+    SLICER_TRACE_SCOPE("parse");
+    StageTimer timer;
+    mesh.clear();
+    invalidatePickCache();
+    bool ok = ::loadSTL(in, mesh);
+    recordMeshLoaded(timer.elapsedMs());
+    return ok;
+}
+
+bool SimpleSlicer::loadSTL(const unsigned char* data, size_t size) {
+    SLICER_TRACE_SCOPE_ARG("parse", "bytes", size);
+    StageTimer timer;
+    mesh.clear();
+    invalidatePickCache();
+    bool ok = ::loadSTL(data, size, mesh);
+    recordMeshLoaded(timer.elapsedMs());
+    return ok;
+}
+
+bool SimpleSlicer::load3MF(const unsigned char* data, size_t size) {
+    SLICER_TRACE_SCOPE_ARG("parse_3mf", "bytes", size);
+    StageTimer timer;
+    invalidatePickCache();
+    lastLoadError.clear();
+    bool ok = ::load3MF(data, size, mesh, &lastLoadError, slicePool());
+    recordMeshLoaded(timer.elapsedMs());
+    return ok;
+}
+
+bool SimpleSlicer::loadMesh(const unsigned char* data, size_t size) {
+    if (isZipArchive(data, size)) return load3MF(data, size);
+    lastLoadError.clear();
+    bool ok = loadSTL(data, size);
+    if (!ok) lastLoadError = "not a valid STL file";
+    return ok;
+}
+
+void SimpleSlicer::recordMeshLoaded(double ms) {
+    stats.trianglesParsed = static_cast<double>(mesh.triangleCount());
+    stats.vertices = static_cast<double>(mesh.vertexCount());
+    stats.meshBytes = static_cast<double>(mesh.memoryBytes());
+    stats.parseMs = ms;
+    sampleHeapUsage(stats);
+    meshHashValid = false;
+    meshBvhValid = false;
+}
+
+void SimpleSlicer::createTestCube() {
+    meshHashValid = false;
+    meshBvhValid = false;
+    double size = 10.0;
+    double h = size / 2;
+    mesh.reserve(8, 12);
+    MeshIndex p1 = mesh.addVertex(-h, -h, -h);
+    MeshIndex p2 = mesh.addVertex(h, -h, -h);
+    MeshIndex p3 = mesh.addVertex(h, h, -h);
+    MeshIndex p4 = mesh.addVertex(-h, h, -h);
+    MeshIndex p5 = mesh.addVertex(-h, -h, h);
+    MeshIndex p6 = mesh.addVertex(h, -h, h);
+    MeshIndex p7 = mesh.addVertex(h, h, h);
+    MeshIndex p8 = mesh.addVertex(-h, h, h);
+
+    // 큐브의 12개 삼각형
+    mesh.addTriangle(p1, p2, p3); mesh.addTriangle(p1, p3, p4); // 아래면
+    mesh.addTriangle(p5, p6, p7); mesh.addTriangle(p5, p7, p8); // 위면
+    mesh.addTriangle(p1, p2, p6); mesh.addTriangle(p1, p6, p5); // 앞면
+    mesh.addTriangle(p3, p4, p8); mesh.addTriangle(p3, p8, p7); // 뒷면
+    mesh.addTriangle(p2, p3, p7); mesh.addTriangle(p2, p7, p6); // 오른쪽면
+    mesh.addTriangle(p1, p4, p8); mesh.addTriangle(p1, p8, p5); // 왼쪽면
+}
+
+bool SimpleSlicer::loadTestMesh(const std::string& shape, double triangles, int islands, double complexity,
+                                double seed) {
+    TestMeshOptions options;
+    if (!parseTestMeshShape(shape, options.shape)) return false;
+    options.triangles = static_cast<size_t>(std::max(1.0, triangles));
+    options.islands = static_cast<uint32_t>(std::max(1, islands));
+    options.complexity = complexity;
+    options.seed = static_cast<uint64_t>(std::max(0.0, seed));
+
+    invalidatePickCache();
+    SLICER_TRACE_SCOPE("generate_test_mesh");
+    StageTimer timer;
+    generateTestMesh(mesh, options);
+    recordMeshLoaded(timer.elapsedMs());
+    return !mesh.empty();
+}
+
+MeshAnalysis SimpleSlicer::analyzeMesh() {
+    SLICER_TRACE_SCOPE("analyze_mesh");
+    return ::analyzeMesh(mesh, slicePool());
+}
+
+std::vector<double> SimpleSlicer::getBoundingBox() {
+    return computeBoundingBox(mesh);
+}
+
+namespace {
+
+// 레이어 구간 하나의 슬라이스 통계 (구간마다 따로 모은 뒤 합친다)
+struct LayerRangeStats {
+    ArenaStageStats alloc[static_cast<size_t>(SliceStage::Count)];
+    size_t arenaPeak = 0;
+    size_t arenaReserved = 0;
+    double intersectMs = 0, contourMs = 0, infillMs = 0;
+    uint64_t hits = 0;
+};
+
+// heights[begin, end) 레이어를 out 에 슬라이스한다.
+// 임시 데이터는 실행 스레드의 아레나에서 받고, 레이어마다 되감은 뒤 구간 끝에 시작 위치로 되돌린다.
+// 호출 스레드도 구간을 실행하므로 reset() 하지 않는다 (그 아레나에 slice() 의 Setup 데이터가 있다).
+void sliceLayerRange(const Mesh& mesh, const ArenaVector<double>& heights, size_t begin, size_t end,
+                     const std::vector<double>& bbox, double infillDensity, LayerStore& out,
+                     LayerRangeStats& result) {
+    Arena& arena = Arena::local();
+    Arena::Marker rangeStart = arena.mark();
+    ArenaStageStats before[static_cast<size_t>(SliceStage::Count)];
+    for (size_t i = 0; i < static_cast<size_t>(SliceStage::Count); i++) {
+        before[i] = arena.stageStats(static_cast<SliceStage>(i));
+    }
+    arena.resetHighWaterMark();
+
+    for (size_t i = begin; i < end; i++) {
+        SLICER_TRACE_SCOPE_ARG("layer", "index", i);
+        double z = heights[i];
+        out.beginLayer(z);
+        Arena::Marker layerStart = arena.mark();
+
+        // 현재 레이어에서 삼각형과의 교차점 계산
+        ArenaVector<Vector3> intersections{ArenaAllocator<Vector3>(arena)};
+        {
+            ArenaStageScope stage(arena, SliceStage::Intersect);
+            SLICER_TRACE_SCOPE("intersect");
+            StageTimer timer;
+            intersectLayer(mesh, z, intersections);
+            result.intersectMs += timer.elapsedMs();
+            result.hits += intersections.size();
+        }
+
+        // 교차점들을 윤곽선으로 구성 (결과 저장소에 바로 쓴다)
+        if (!intersections.empty()) {
+            {
+                SLICER_TRACE_SCOPE("contour");
+                StageTimer timer;
+                buildContours(intersections, out.contours());
+                result.contourMs += timer.elapsedMs();
+            }
+
+            // 인필 패턴 생성
+            SLICER_TRACE_SCOPE("infill");
+            StageTimer timer;
+            generateInfill(out.infill(), bbox, infillDensity);
+            result.infillMs += timer.elapsedMs();
+        }
+
+        arena.rewind(layerStart);
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(SliceStage::Count); i++) {
+        const ArenaStageStats& after = arena.stageStats(static_cast<SliceStage>(i));
+        result.alloc[i].allocations = after.allocations - before[i].allocations;
+        result.alloc[i].bytes = after.bytes - before[i].bytes;
+    }
+    result.arenaPeak = arena.highWaterMark();
+    result.arenaReserved = arena.bytesReserved();
+    arena.rewind(rangeStart);
+}
+
+} // namespace
+
+void SimpleSlicer::setThreadCount(int threads) {
+    threadCount = static_cast<size_t>(std::max(0, threads));
+    ownedPool.reset(threadCount > 1 ? new ThreadPool(threadCount) : nullptr);
+}
+
+int SimpleSlicer::getThreadCount() {
+    ThreadPool* pool = slicePool();
+    return pool ? static_cast<int>(pool->size()) : 1;
+}
+
+ThreadPool* SimpleSlicer::slicePool() {
+    if (threadCount == 1) return nullptr;
+    return ownedPool ? ownedPool.get() : &ThreadPool::shared();
+}
+
+bool SimpleSlicer::checkSlice(std::string* error) {
+    return checkSliceRange(getBoundingBox(), layerHeight, infillDensity, error);
+}
+
+// 레이어 높이는 기존처럼 누적 덧셈으로 먼저 정해 두고, 연속된 레이어 구간을 스레드에 나눠 자른다.
+// 구간 결과를 순서대로 이어 붙이므로 출력은 순차 실행과 바이트 단위로 같다.
+const LayerStore& SimpleSlicer::slice() {
+    SLICER_TRACE_SCOPE("slice");
+    StageTimer sliceTimer;
+
+    layerStore.clear();
+    std::vector<double> bbox;
+    {
+        SLICER_TRACE_SCOPE("bbox");
+        StageTimer timer;
+        bbox = getBoundingBox();
+        stats.bboxMs = timer.elapsedMs();
+    }
+    lastSliceError.clear();
+    if (!checkSliceRange(bbox, layerHeight, infillDensity, &lastSliceError)) {
+        stats.layers = 0;
+        stats.sliceMs = sliceTimer.elapsedMs();
+        return layerStore;
+    }
+    double minZ = bbox[2];
+    double maxZ = bbox[5];
+
+    // 슬라이스 한 번의 임시 데이터 (레이어 높이 목록, 구간별 통계) 는 호출 스레드의 아레나에서
+    Arena& arena = Arena::local();
+    arena.reset();
+    arena.resetStats();
+    ArenaStageScope setupStage(arena, SliceStage::Setup);
+
+    // 레이어 높이 목록 (레이어 수는 위에서 상한 안으로 확인했다)
+    ArenaVector<double> heights{ArenaAllocator<double>(arena)};
+    heights.reserve(static_cast<size_t>((maxZ - minZ) / layerHeight) + 2);
+    for (double z = minZ; z <= maxZ; z += layerHeight) {
+        heights.push_back(z);
+    }
+
+    // 스레드당 4구간 정도로 나눠 레이어마다 다른 작업량을 고르게 한다
+    ThreadPool* pool = slicePool();
+    size_t workers = pool ? pool->size() : 1;
+    size_t rangeCount = workers > 1 ? std::min(heights.size(), workers * 4) : 1;
+    size_t rangeSize = rangeCount > 0 ? (heights.size() + rangeCount - 1) / rangeCount : 0;
+    if (rangeSize > 0) rangeCount = (heights.size() + rangeSize - 1) / rangeSize;
+
+    ArenaVector<LayerRangeStats> rangeStats(std::max<size_t>(rangeCount, 1), LayerRangeStats(),
+                                            ArenaAllocator<LayerRangeStats>(arena));
+    ArenaStageStats setupAlloc = arena.stageStats(SliceStage::Setup);
+    size_t setupPeak = arena.highWaterMark();
+
+    if (rangeCount <= 1) {
+        sliceLayerRange(mesh, heights, 0, heights.size(), bbox, infillDensity, layerStore, rangeStats[0]);
+    } else {
+        if (chunkStores.size() < rangeCount) chunkStores.resize(rangeCount);
+        pool->parallelFor(rangeCount, [&](size_t r) {
+            size_t begin = r * rangeSize;
+            size_t end = std::min(heights.size(), begin + rangeSize);
+            chunkStores[r].clear();
+            sliceLayerRange(mesh, heights, begin, end, bbox, infillDensity, chunkStores[r], rangeStats[r]);
+        });
+        SLICER_TRACE_SCOPE("merge");
+        for (size_t r = 0; r < rangeCount; r++) layerStore.append(chunkStores[r]);
+    }
+
+    // 단계 시간은 스레드별 시간의 합, 아레나 최대 사용량은 Setup 과 구간 중 가장 큰 값
+    double intersectMs = 0, contourMs = 0, infillMs = 0;
+    uint64_t hits = 0;
+    for (ArenaStageStats& stage : sliceAllocStats) stage = ArenaStageStats();
+    sliceAllocStats[static_cast<size_t>(SliceStage::Setup)] = setupAlloc;
+    sliceArenaPeak = setupPeak;
+    sliceArenaReserved = arena.bytesReserved();
+    for (const LayerRangeStats& range : rangeStats) {
+        for (size_t i = 0; i < static_cast<size_t>(SliceStage::Count); i++) {
+            sliceAllocStats[i].allocations += range.alloc[i].allocations;
+            sliceAllocStats[i].bytes += range.alloc[i].bytes;
+        }
+        sliceArenaPeak = std::max(sliceArenaPeak, range.arenaPeak);
+        sliceArenaReserved = std::max(sliceArenaReserved, range.arenaReserved);
+        intersectMs += range.intersectMs;
+        contourMs += range.contourMs;
+        infillMs += range.infillMs;
+        hits += range.hits;
+    }
+
+    const PolylineBuffer& contours = layerStore.contours();
+    const PolylineBuffer& infill = layerStore.infill();
+    stats.layers = static_cast<double>(layerStore.layerCount());
+    stats.contourSegments = static_cast<double>(contours.pointCount() - contours.polylineCount());
+    stats.infillSegments = static_cast<double>(infill.pointCount() - infill.polylineCount());
+    stats.intersectionsTested = static_cast<double>(mesh.triangleCount()) * layerStore.layerCount();
+    stats.intersectionsHit = static_cast<double>(hits);
+    stats.allocations = 0;
+    for (const ArenaStageStats& stage : sliceAllocStats) stats.allocations += stage.allocations;
+    stats.arenaPeakBytes = static_cast<double>(sliceArenaPeak);
+    stats.intersectMs = intersectMs;
+    stats.contourMs = contourMs;
+    stats.infillMs = infillMs;
+    stats.sliceMs = sliceTimer.elapsedMs();
+    sampleHeapUsage(stats);
+
+    return layerStore;
+}
+
+std::string SimpleSlicer::generateGCode() {
+    std::stringstream gcode;
+    writeGCode(gcode);
+    return gcode.str();
+}
+
+void SimpleSlicer::writeGCode(std::ostream& gcode) {
+    const LayerStore& layers = slice();
+    stats.cacheHit = 0;
+    SLICER_TRACE_SCOPE("gcode");
+    StageTimer timer;
+    GCodeWriter writer(gcode, layerHeight, infillDensity);
+    writer.begin();
+    for (size_t i = 0; i < layers.layerCount(); i++) {
+        SLICER_TRACE_SCOPE_ARG("gcode_layer", "index", i);
+        writer.writeLayer(i, layers.layer(i));
+    }
+    writer.end();
+    stats.gcodeBytes = static_cast<double>(writer.bytesWritten());
+    stats.gcodeMs = timer.elapsedMs();
+    sampleHeapUsage(stats);
+}
+
+uint64_t SimpleSlicer::meshHash() {
+    if (!meshHashValid) {
+        SLICER_TRACE_SCOPE("mesh_hash");
+        StageTimer timer;
+        meshHashValue = hashMesh(mesh);
+        meshHashValid = true;
+        stats.hashMs = timer.elapsedMs();
+    }
+    return meshHashValue;
+}
+
+std::string SimpleSlicer::getSliceCacheKey() {
+    SlicerSettings settings;
+    settings.layerHeight = layerHeight;
+    settings.infillDensity = infillDensity;
+    return sliceCacheKey(meshHash(), settings);
+}
+
+bool SimpleSlicer::writeGCodeCached(std::ostream& out, SliceCache& cache) {
+    std::string key = getSliceCacheKey();
+    std::string blob;
+    {
+        SLICER_TRACE_SCOPE("slice_cache_load");
+        if (cache.load(key, blob)) {
+            out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            stats.gcodeBytes = static_cast<double>(blob.size());
+            stats.cacheHit = 1;
+            return true;
+        }
+    }
+
+    std::ostringstream gcode;
+    writeGCode(gcode);
+    blob = gcode.str();
+    out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+    SLICER_TRACE_SCOPE("slice_cache_store");
+    cache.store(key, blob);
+    return false;
+}
+
+bool SimpleSlicer::writeGCode3MF(std::ostream& out, const GCode3MFPlate& plate, std::string* error) {
+    SLICER_TRACE_SCOPE("gcode_3mf");
+    if (!checkSlice(error)) return false;
+    SlicerSettings settings;
+    settings.layerHeight = layerHeight;
+    settings.infillDensity = infillDensity;
+    return ::writeGCode3MF(out, plate, settings, [this](std::ostream& gcode) { writeGCode(gcode); }, error,
+                          slicePool());
+}
+
+bool SimpleSlicer::writeBGCode(std::ostream& out, const BGCodePlate& plate, std::string* error,
+                               const BGCodeOptions& options) {
+    SLICER_TRACE_SCOPE("bgcode");
+    if (!checkSlice(error)) return false;
+    SlicerSettings settings;
+    settings.layerHeight = layerHeight;
+    settings.infillDensity = infillDensity;
+    return ::writeBGCode(out, plate, settings, [this](std::ostream& gcode) { writeGCode(gcode); }, error, options);
+}
+
+std::vector<double> SimpleSlicer::pickSegment(int layerIndex, double x, double y, double radius) {
+    if (!pickCacheValid) {
+        slice();
+        pickGrids.assign(layerStore.layerCount(), SegmentGrid());
+        pickCacheValid = true;
+    }
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(pickGrids.size())) return {};
+
+    // 같은 모델/설정이면 slice() 결과가 동일하므로 layerStore 를 그대로 쓴다
+    SegmentGrid& grid = pickGrids[layerIndex];
+    if (!grid.isBuilt()) grid.build(layerStore.layer(layerIndex));
+
+    double distance = 0;
+    int64_t hit = grid.nearestSegment(x, y, radius, &distance);
+    if (hit < 0) return {};
+
+    const Segment2& s = grid.segment(static_cast<size_t>(hit));
+    return {static_cast<double>(s.kind), static_cast<double>(s.polyline),
+            s.x0, s.y0, s.x1, s.y1, distance};
+}
+
+void SimpleSlicer::invalidatePickCache() {
+    pickGrids.clear();
+    pickCacheValid = false;
+}
+
+const MeshBvh& SimpleSlicer::bvh() {
+    if (!meshBvhValid) {
+        SLICER_TRACE_SCOPE("build_bvh");
+        meshBvh.build(mesh, slicePool());
+        meshBvhValid = true;
+    }
+    return meshBvh;
+}
+
+std::vector<double> SimpleSlicer::raycast(const std::vector<double>& rays, double maxDistance) {
+    size_t count = rays.size() / 6;
+    std::vector<double> out(count * kBvhHitStride);
+    bvh().raycastBatch(rays.data(), count, maxDistance, out.data(), slicePool());
+    return out;
+}
+
+std::vector<double> SimpleSlicer::closestPoints(const std::vector<double>& points, double maxDistance) {
+    size_t count = points.size() / 3;
+    std::vector<double> out(count * kBvhHitStride);
+    bvh().closestPointBatch(points.data(), count, maxDistance, out.data(), slicePool());
+    return out;
+}
+
+double SimpleSlicer::getMeshMemoryBytes() {
+    return static_cast<double>(mesh.memoryBytes());
+}
+
+std::string SimpleSlicer::getAllocationStats() {
+    std::stringstream json;
+    json << "{\n";
+    json << "  \"arenaPeakBytes\": " << sliceArenaPeak << ",\n";
+    json << "  \"arenaReservedBytes\": " << sliceArenaReserved << ",\n";
+    json << "  \"stages\": [\n";
+    for (size_t i = 0; i < static_cast<size_t>(SliceStage::Count); i++) {
+        if (i > 0) json << ",\n";
+        json << "    { \"name\": \"" << sliceStageName(static_cast<SliceStage>(i)) << "\", "
+             << "\"allocations\": " << sliceAllocStats[i].allocations << ", "
+             << "\"bytes\": " << sliceAllocStats[i].bytes << " }";
+    }
+    json << "\n  ]\n";
+    json << "}";
+    return json.str();
+}
+
+std::string SimpleSlicer::getLayerInfo() {
+    slice();
+    return formatLayerInfo();
+}
+
+std::string SimpleSlicer::formatLayerInfo() {
+    SLICER_TRACE_SCOPE("layer_info_json");
+    StageTimer timer;
+    const LayerStore& layers = layerStore;
+    std::stringstream json;
+
+    json << "{\n";
+    json << "  \"layerHeight\": " << layerHeight << ",\n";
+    json << "  \"infillDensity\": " << infillDensity << ",\n";
+    json << "  \"totalLayers\": " << layers.layerCount() << ",\n";
+    json << "  \"boundingBox\": [";
+
+    auto bbox = getBoundingBox();
+    for (size_t i = 0; i < bbox.size(); i++) {
+        if (i > 0) json << ", ";
+        json << bbox[i];
+    }
+    json << "],\n";
+    json << "  \"layers\": [\n";
+
+    for (size_t i = 0; i < layers.layerCount(); i++) {
+        LayerView layer = layers.layer(i);
+        if (i > 0) json << ",\n";
+        json << "    {\n";
+        json << "      \"height\": " << layer.height << ",\n";
+        json << "      \"contourCount\": " << layer.contourCount() << ",\n";
+        json << "      \"infillCount\": " << layer.infillCount() << "\n";
+        json << "    }";
+    }
+
+    json << "\n  ]\n";
+    json << "}";
+
+    std::string result = json.str();
+    stats.layerInfoMs = timer.elapsedMs();
+    return result;
+}
+
+std::string SimpleSlicer::getTraceJson() {
+    return TraceRecorder::global().toJson();
+}
+
+void SimpleSlicer::clearTrace() {
+    TraceRecorder::global().clear();
+}
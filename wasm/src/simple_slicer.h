@@ -0,0 +1,166 @@
+#pragma once
+
+#include "arena.h"
+#include "bgcode_writer.h"
+#include "bvh.h"
+#include "gcode_3mf_writer.h"
+#include "layer_store.h"
+#include "mesh_analysis.h"
+#include "mesh.h"
+#include "slice_cache.h"
+#include "slicer_stats.h"
+#include "spatial_grid.h"
+#include "thread_pool.h"
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 간단한 3D 슬라이서 클래스
+// 브라우저(embind, slicer.cpp) 와 네이티브 CLI(slicer_cli.cpp) 가 같은 코어를 쓴다.
+class SimpleSlicer {
+private:
+    Mesh mesh;
+    double layerHeight;
+    double infillDensity;
+
+    // 슬라이스 결과 (slice() 호출마다 비우고 다시 채우며, 버퍼 용량은 재사용)
+    LayerStore layerStore;
+
+    // 병렬 슬라이스: 레이어 구간별 중간 결과 (순서대로 layerStore 에 병합, 용량 재사용)
+    std::vector<LayerStore> chunkStores;
+    size_t threadCount = 0;                // 0 = 공용 풀, 1 = 순차
+    std::unique_ptr<ThreadPool> ownedPool;  // setThreadCount(n > 1) 로 만든 전용 풀
+
+    ThreadPool* slicePool();
+
+    // 마지막 slice() 의 단계별 임시 할당 통계
+    ArenaStageStats sliceAllocStats[static_cast<size_t>(SliceStage::Count)];
+    size_t sliceArenaPeak = 0;
+    size_t sliceArenaReserved = 0;
+
+    // 피킹용 격자 캐시 (설정이나 모델이 바뀌면 무효화)
+    std::vector<SegmentGrid> pickGrids;
+    bool pickCacheValid = false;
+
+    // 단계별 실행 통계 (getStats)
+    SlicerStats stats;
+
+    // 광선/최근접점 질의용 BVH (처음 질의할 때 만들고, 메시가 바뀌면 다시 만든다)
+    MeshBvh meshBvh;
+    bool meshBvhValid = false;
+
+    // 메시 해시 (슬라이스 캐시 키, 메시가 바뀌면 다시 계산)
+    uint64_t meshHashValue = 0;
+    bool meshHashValid = false;
+
+    std::string lastLoadError;
+    std::string lastSliceError;
+
+    void recordMeshLoaded(double ms);
+
+public:
+    SimpleSlicer() : layerHeight(0.2), infillDensity(20.0) {}
+
+    // 설정 메서드
+    void setLayerHeight(double height) { layerHeight = height; invalidatePickCache(); }
+    void setInfillDensity(double density) { infillDensity = density; invalidatePickCache(); }
+    double getLayerHeight() const { return layerHeight; }
+    double getInfillDensity() const { return infillDensity; }
+
+    // 슬라이스 스레드 수 (0 = 공용 풀 크기, 1 = 순차). 결과는 스레드 수와 무관하게 같다.
+    void setThreadCount(int threads);
+    int getThreadCount();
+
+    // STL 파일 파싱 (바이너리 / ASCII)
+    bool parseSTL(const std::string& stlData);
+
+    // 스트림/메모리 버퍼에서 STL 읽기 (CLI 용, 실패 시 테스트 큐브로 대체하지 않고 false)
+    // 버퍼는 읽는 동안만 유효하면 된다 (메시로 변환한 뒤에는 참조하지 않는다).
+    bool loadSTL(std::istream& in);
+    bool loadSTL(const unsigned char* data, size_t size);
+
+    // 3MF 패키지 (빌드 항목 전체를 한 메시로). 실패하면 false 이고 loadError() 에 이유.
+    bool load3MF(const unsigned char* data, size_t size);
+
+    // zip 서명이면 3MF, 아니면 STL 로 읽는다
+    bool loadMesh(const unsigned char* data, size_t size);
+    const std::string& loadError() const { return lastLoadError; }
+
+    // 테스트용 큐브 생성
+    void createTestCube();
+
+    // 절차적 테스트 메시 로드 (shape: sphere, torus, menger, vase, gyroid). 모르는 모양이면 false.
+    bool loadTestMesh(const std::string& shape, double triangles, int islands, double complexity, double seed);
+
+    const Mesh& getMesh() const { return mesh; }
+
+    // 부피/넓이/무게중심/바운딩 박스/메시 결함 수 (모델 정보, 견적)
+    MeshAnalysis analyzeMesh();
+
+    // 모델의 바운딩 박스 계산
+    std::vector<double> getBoundingBox();
+
+    // 현재 메시와 설정으로 자를 수 있는지 (좌표가 유한하고 레이어/인필 선 수가 상한 안인지)
+    bool checkSlice(std::string* error = nullptr);
+
+    // 레이어별 슬라이싱. checkSlice() 를 통과하지 못하면 레이어 없이 돌아오고 sliceError() 에 이유.
+    const LayerStore& slice();
+    const std::string& sliceError() const { return lastSliceError; }
+    const LayerStore& getLayers() const { return layerStore; }
+
+    // G-code 생성
+    std::string generateGCode();
+    void writeGCode(std::ostream& out);
+
+    // 메시 해시 + 현재 설정으로 만든 슬라이스 캐시 키 (32자리 16진수)
+    uint64_t meshHash();
+    std::string getSliceCacheKey();
+
+    // 캐시에 같은 키의 G-code 가 있으면 slice() 없이 그대로 쓰고 true.
+    // 없으면 슬라이스해서 쓰고 캐시에 저장한 뒤 false.
+    bool writeGCodeCached(std::ostream& out, SliceCache& cache);
+
+    // 슬라이스해서 Bambu 프린터용 .gcode.3mf 로 쓴다 (G-code 는 zip 엔트리로 바로 스트리밍)
+    bool writeGCode3MF(std::ostream& out, const GCode3MFPlate& plate, std::string* error = nullptr);
+
+    // 슬라이스해서 바이너리 G-code (.bgcode) 로 쓴다 (G-code 는 64KB 블록마다 MeatPack + heatshrink)
+    bool writeBGCode(std::ostream& out, const BGCodePlate& plate, std::string* error = nullptr,
+                     const BGCodeOptions& options = BGCodeOptions());
+
+    // 지정 레이어에서 (x, y) 반경 내 가장 가까운 선분 찾기 (시각화 피킹)
+    // 반환: [종류(1=윤곽선, 2=인필), 폴리라인 번호, x0, y0, x1, y1, 거리], 없으면 빈 배열
+    std::vector<double> pickSegment(int layerIndex, double x, double y, double radius);
+    void invalidatePickCache();
+
+    // 메시 BVH (없거나 메시가 바뀌었으면 지금 만든다)
+    const MeshBvh& bvh();
+
+    // 일괄 광선 질의: rays 는 [ox, oy, oz, dx, dy, dz] 반복, 결과는 광선마다
+    // [거리, 삼각형 번호, x, y, z, nx, ny, nz] (못 맞히면 거리/번호 -1). maxDistance <= 0 이면 제한 없음.
+    std::vector<double> raycast(const std::vector<double>& rays, double maxDistance);
+
+    // 일괄 최근접점 질의: points 는 [x, y, z] 반복, 결과 형식은 raycast 와 같다
+    std::vector<double> closestPoints(const std::vector<double>& points, double maxDistance);
+
+    // 메시 좌표/인덱스 버퍼 크기 (바이트)
+    double getMeshMemoryBytes();
+
+    // 마지막 slice() 의 단계별 임시 할당 통계 (JSON)
+    std::string getAllocationStats();
+
+    // JSON 형태로 레이어 정보 반환
+    std::string getLayerInfo();
+
+    // 마지막 slice() 결과를 다시 자르지 않고 JSON 으로 (벤치마크에서 단계별 측정용)
+    std::string formatLayerInfo();
+
+    // 카운터/단계 시간/힙 사용량 (마지막 실행 기준)
+    SlicerStats getStats() { sampleHeapUsage(stats); return stats; }
+
+    // 단계/레이어별 Chrome Trace Event JSON (SLICER_TRACE 빌드가 아니면 빈 트레이스)
+    std::string getTraceJson();
+    void clearTrace();
+};
@@ -0,0 +1,103 @@
+#include "slice_cache.h"
+
+#include "xxhash64.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+uint64_t hashMesh(const Mesh& mesh) {
+    const uint32_t layout[] = {static_cast<uint32_t>(sizeof(*mesh.xData())),
+                               static_cast<uint32_t>(sizeof(MeshIndex))};
+    const uint64_t counts[] = {mesh.vertexCount(), mesh.triangleCount()};
+
+    XXHash64 hash;
+    hash.update(layout, sizeof(layout));
+    hash.update(counts, sizeof(counts));
+    size_t coordBytes = mesh.vertexCount() * sizeof(*mesh.xData());
+    hash.update(mesh.xData(), coordBytes);
+    hash.update(mesh.yData(), coordBytes);
+    hash.update(mesh.zData(), coordBytes);
+    hash.update(mesh.indexData(), mesh.triangleCount() * 3 * sizeof(MeshIndex));
+    return hash.digest();
+}
+
+std::string sliceCacheKey(uint64_t meshHash, const SlicerSettings& settings) {
+    uint64_t settingsHash = hashSlicerSettings(settings);
+    uint64_t versioned[] = {settingsHash, kSliceCacheVersion};
+    return toHex64(meshHash) + toHex64(xxHash64(versioned, sizeof(versioned)));
+}
+
+bool MemorySliceCache::load(const std::string& key, std::string& blob) {
+    auto it = index.find(key);
+    if (it == index.end()) return false;
+    entries.splice(entries.begin(), entries, it->second);
+    blob = it->second->second;
+    return true;
+}
+
+bool MemorySliceCache::store(const std::string& key, const std::string& blob) {
+    if (blob.size() > maxBytes) return false;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        totalBytes -= it->second->second.size();
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    entries.emplace_front(key, blob);
+    index[key] = entries.begin();
+    totalBytes += blob.size();
+
+    // 오래된 항목부터 비운다
+    while (totalBytes > maxBytes) {
+        Entry& oldest = entries.back();
+        totalBytes -= oldest.second.size();
+        index.erase(oldest.first);
+        entries.pop_back();
+    }
+    return true;
+}
+
+std::string DiskSliceCache::pathFor(const std::string& key) const {
+    std::filesystem::path path(directory);
+    path /= key.substr(0, 2);
+    path /= key + ".gcode";
+    return path.string();
+}
+
+bool DiskSliceCache::load(const std::string& key, std::string& blob) {
+    std::ifstream in(pathFor(key), std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    if (!in && !in.eof()) return false;
+    blob = buffer.str();
+    return true;
+}
+
+bool DiskSliceCache::store(const std::string& key, const std::string& blob) {
+    std::filesystem::path path(pathFor(key));
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    if (error) return false;
+
+    // 같은 디렉터리의 임시 파일에 다 쓴 뒤 교체
+    std::filesystem::path temp(path.string() + ".tmp" + toHex64((uint64_t(std::random_device()()) << 32) ^ blob.size()));
+    {
+        std::ofstream out(temp, std::ios::binary);
+        out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!out) {
+            std::filesystem::remove(temp, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temp, path, error);
+    if (error) {
+        std::filesystem::remove(temp, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "mesh.h"
+#include "slicer_settings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// 슬라이스 결과 캐시 키 형식 버전 (G-code 출력이 바뀌면 올려서 이전 항목을 무효화)
+constexpr uint32_t kSliceCacheVersion = 1;
+
+// 파싱된 메시(좌표 + 인덱스 버퍼)의 xxHash64
+// 좌표/인덱스 타입 크기도 섞으므로 float32/64비트 인덱스 빌드끼리는 키가 겹치지 않는다.
+uint64_t hashMesh(const Mesh& mesh);
+
+// 메시 해시 + 설정 해시 + 형식 버전 → 32자리 16진수 키
+std::string sliceCacheKey(uint64_t meshHash, const SlicerSettings& settings);
+
+// 키 → G-code 저장소
+// 네이티브 CLI 는 디스크, 브라우저는 JS 쪽(IndexedDB 등) 저장소를 쓴다 (app/shared/lib/slice-cache.ts).
+class SliceCache {
+public:
+    virtual ~SliceCache() = default;
+
+    // 있으면 blob 을 채우고 true
+    virtual bool load(const std::string& key, std::string& blob) = 0;
+    virtual bool store(const std::string& key, const std::string& blob) = 0;
+};
+
+// 프로세스 안 캐시 (최근 사용 순으로 maxBytes 까지)
+class MemorySliceCache : public SliceCache {
+public:
+    explicit MemorySliceCache(size_t maxBytes = 256u << 20) : maxBytes(maxBytes) {}
+
+    bool load(const std::string& key, std::string& blob) override;
+    bool store(const std::string& key, const std::string& blob) override;
+
+    size_t bytes() const { return totalBytes; }
+
+private:
+    using Entry = std::pair<std::string, std::string>;
+
+    size_t maxBytes;
+    size_t totalBytes = 0;
+    std::list<Entry> entries;  // 앞쪽이 최근 사용
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+// 디렉터리 캐시: <dir>/<키 앞 2자리>/<키>.gcode
+// 임시 파일에 쓴 뒤 rename 하므로 동시에 여러 프로세스가 써도 반쯤 쓴 파일을 읽지 않는다.
+class DiskSliceCache : public SliceCache {
+public:
+    explicit DiskSliceCache(std::string directory) : directory(std::move(directory)) {}
+
+    bool load(const std::string& key, std::string& blob) override;
+    bool store(const std::string& key, const std::string& blob) override;
+
+    std::string pathFor(const std::string& key) const;
+
+private:
+    std::string directory;
+};
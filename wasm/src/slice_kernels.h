@@ -0,0 +1,147 @@
+#pragma once
+
+#include "geometry.h"
+#include "layer_store.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// 슬라이싱 핵심 루틴 (메시 저장 타입에 대해 템플릿)
+// 좌표는 저장 타입으로 읽고, 비교와 보간은 double 로 한다.
+
+// 바운딩 박스 [minX, minY, minZ, maxX, maxY, maxZ]
+template <typename Scalar>
+std::vector<double> computeBoundingBox(const MeshT<Scalar>& mesh) {
+    if (mesh.empty()) return {0, 0, 0, 0, 0, 0};
+
+    const Scalar* xs = mesh.xData();
+    const Scalar* ys = mesh.yData();
+    const Scalar* zs = mesh.zData();
+
+    Scalar minX = xs[0], maxX = xs[0];
+    Scalar minY = ys[0], maxY = ys[0];
+    Scalar minZ = zs[0], maxZ = zs[0];
+
+    // 축별 배열을 따로 훑어 컴파일러가 벡터화할 수 있게 한다
+    size_t n = mesh.vertexCount();
+    for (size_t i = 1; i < n; i++) {
+        minX = std::min(minX, xs[i]);
+        maxX = std::max(maxX, xs[i]);
+    }
+    for (size_t i = 1; i < n; i++) {
+        minY = std::min(minY, ys[i]);
+        maxY = std::max(maxY, ys[i]);
+    }
+    for (size_t i = 1; i < n; i++) {
+        minZ = std::min(minZ, zs[i]);
+        maxZ = std::max(maxZ, zs[i]);
+    }
+
+    return {static_cast<double>(minX), static_cast<double>(minY), static_cast<double>(minZ),
+            static_cast<double>(maxX), static_cast<double>(maxY), static_cast<double>(maxZ)};
+}
+
+// 삼각형과 평면의 교차점 계산
+inline Vector3 calculateIntersection(const Triangle& tri, double z) {
+    // 간단한 선형 보간
+    double t1 = (z - tri.v1.z) / (tri.v2.z - tri.v1.z);
+    double t2 = (z - tri.v2.z) / (tri.v3.z - tri.v2.z);
+
+    Vector3 p1(tri.v1.x + t1 * (tri.v2.x - tri.v1.x),
+               tri.v1.y + t1 * (tri.v2.y - tri.v1.y),
+               z);
+
+    Vector3 p2(tri.v2.x + t2 * (tri.v3.x - tri.v2.x),
+               tri.v2.y + t2 * (tri.v3.y - tri.v2.y),
+               z);
+
+    return Vector3((p1.x + p2.x) / 2, (p1.y + p2.y) / 2, z);
+}
+
+// 삼각형이 높이 z 평면과 만나는지
+inline bool triangleSpansZ(double z1, double z2, double z3, double z) {
+    return (z1 <= z && z <= z2) ||
+           (z2 <= z && z <= z3) ||
+           (z3 <= z && z <= z1);
+}
+
+// 한 레이어 높이 z 와 교차하는 삼각형의 교차점 수집
+template <typename Scalar, typename Output>
+void intersectLayer(const MeshT<Scalar>& mesh, double z, Output& intersections) {
+    const Scalar* zs = mesh.zData();
+    const MeshIndex* idx = mesh.indexData();
+    size_t count = mesh.triangleCount();
+
+    for (size_t t = 0; t < count; t++) {
+        const MeshIndex* tri = idx + t * 3;
+        // z 만 먼저 읽어 걸러내고, 교차하는 삼각형만 전체 좌표를 읽는다
+        if (triangleSpansZ(zs[tri[0]], zs[tri[1]], zs[tri[2]], z)) {
+            intersections.push_back(calculateIntersection(mesh.triangle(t), z));
+        }
+    }
+}
+
+// 교차점을 윤곽선 폴리라인으로 기록
+template <typename Points>
+void buildContours(const Points& intersections, PolylineBuffer& contours) {
+    for (const auto& p : intersections) {
+        contours.addPoint(p.x, p.y);
+    }
+    contours.endPolyline();
+}
+
+// 인필 선 사이 x 간격 (밀도 100% 에서 2mm)
+inline double infillStep(double infillDensity) {
+    double spacing = 2.0; // 인필 간격
+    double density = infillDensity / 100.0;
+    return spacing / density;
+}
+
+// 인필 패턴 생성 (바운딩 박스 전체에 걸친 간단한 직선 인필)
+inline void generateInfill(PolylineBuffer& infill, const std::vector<double>& bbox, double infillDensity) {
+    double minX = bbox[0], maxX = bbox[3];
+    double minY = bbox[1], maxY = bbox[4];
+
+    for (double x = minX; x <= maxX; x += infillStep(infillDensity)) {
+        infill.addPoint(x, minY);
+        infill.addPoint(x, maxY);
+        infill.endPolyline();
+    }
+}
+
+// 레이어 수/레이어당 인필 선 수 상한 (0.2mm 레이어로 높이 200m, 20% 인필로 폭 650m)
+// 이보다 크면 좌표가 잘못된 입력으로 보고 자르지 않는다.
+const double kMaxSliceLayers = 1 << 20;
+const double kMaxInfillLines = 1 << 16;
+
+// 높이/간격을 누적 덧셈하는 레이어, 인필 루프가 유한하고 상한 안에서 끝나는지 미리 확인한다.
+// 좌표가 아주 크면 z += layerHeight 가 z 를 바꾸지 못해 루프가 끝나지 않으므로 그것도 거부한다.
+inline bool checkSliceRange(const std::vector<double>& bbox, double layerHeight, double infillDensity,
+                            std::string* error) {
+    auto fail = [error](const char* message) {
+        if (error) *error = message;
+        return false;
+    };
+    for (double c : bbox) {
+        if (!std::isfinite(c)) return fail("mesh has non-finite coordinates");
+    }
+    if (!(layerHeight > 0) || !std::isfinite(layerHeight)) return fail("layerHeight must be positive");
+    if (!(infillDensity >= 0) || !std::isfinite(infillDensity)) return fail("infillDensity must not be negative");
+
+    double minZ = bbox[2], maxZ = bbox[5];
+    double topZ = std::max(std::fabs(minZ), std::fabs(maxZ));
+    if ((maxZ - minZ) / layerHeight > kMaxSliceLayers || topZ + layerHeight == topZ) {
+        return fail("too many layers (model too tall for the layer height)");
+    }
+
+    double step = infillStep(infillDensity);
+    double minX = bbox[0], maxX = bbox[3];
+    double topX = std::max(std::fabs(minX), std::fabs(maxX));
+    if ((maxX - minX) / step > kMaxInfillLines || topX + step == topX) {
+        return fail("too many infill lines (model too wide for the infill density)");
+    }
+    return true;
+}
@@ -1,265 +1,256 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include <string>
-#include <vector>
-#include <cmath>
-#include <sstream>
 
-using namespace emscripten;
+#include "arrange.h"
+#include "footprint.h"
+#include "geometry.h"
+#include "orient.h"
+#include "simple_slicer.h"
 
-// 3D 벡터 구조체
-struct Vector3 {
-    double x, y, z;
-    Vector3(double x = 0, double y = 0, double z = 0) : x(x), y(y), z(z) {}
-};
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <vector>
 
-// 삼각형 구조체
-struct Triangle {
-    Vector3 v1, v2, v3;
-    Triangle(Vector3 v1, Vector3 v2, Vector3 v3) : v1(v1), v2(v2), v3(v3) {}
-};
+using namespace emscripten;
 
-// 레이어 구조체
-struct Layer {
-    double height;
-    std::vector<std::vector<Vector3>> contours;
-    std::vector<std::vector<Vector3>> infill;
-    
-    Layer(double h) : height(h) {}
-};
+namespace {
 
-// 간단한 3D 슬라이서 클래스
-class SimpleSlicer {
-private:
-    std::vector<Triangle> triangles;
-    double layerHeight;
-    double infillDensity;
-    
+// 고정 크기 버퍼가 찰 때마다 JS 콜백에 힙 뷰를 넘기는 출력 버퍼
+// 뷰는 콜백 안에서만 유효하다 (worker 가 잘라 내 전송 버퍼로 옮긴다).
+class ChunkCallbackBuf : public std::streambuf {
 public:
-    SimpleSlicer() : layerHeight(0.2), infillDensity(20.0) {}
-    
-    // 설정 메서드
-    void setLayerHeight(double height) { layerHeight = height; }
-    void setInfillDensity(double density) { infillDensity = density; }
-    
-    // STL 파일 파싱 (간단한 버전)
-    bool parseSTL(const std::string& stlData) {
-        // 실제 구현에서는 STL 바이너리/ASCII 파싱
-        // 여기서는 간단한 예시만 구현
-        triangles.clear();
-        
-        // 간단한 큐브 모델 생성 (테스트용)
-        createTestCube();
-        return true;
+    ChunkCallbackBuf(val callback, size_t chunkBytes) : callback(callback), buffer(chunkBytes) {
+        setp(buffer.data(), buffer.data() + buffer.size());
     }
-    
-    // 테스트용 큐브 생성
-    void createTestCube() {
-        double size = 10.0;
-        Vector3 p1(-size/2, -size/2, -size/2);
-        Vector3 p2(size/2, -size/2, -size/2);
-        Vector3 p3(size/2, size/2, -size/2);
-        Vector3 p4(-size/2, size/2, -size/2);
-        Vector3 p5(-size/2, -size/2, size/2);
-        Vector3 p6(size/2, -size/2, size/2);
-        Vector3 p7(size/2, size/2, size/2);
-        Vector3 p8(-size/2, size/2, size/2);
-        
-        // 큐브의 12개 삼각형
-        triangles = {
-            Triangle(p1, p2, p3), Triangle(p1, p3, p4), // 아래면
-            Triangle(p5, p6, p7), Triangle(p5, p7, p8), // 위면
-            Triangle(p1, p2, p6), Triangle(p1, p6, p5), // 앞면
-            Triangle(p3, p4, p8), Triangle(p3, p8, p7), // 뒷면
-            Triangle(p2, p3, p7), Triangle(p2, p7, p6), // 오른쪽면
-            Triangle(p1, p4, p8), Triangle(p1, p8, p5)  // 왼쪽면
-        };
-    }
-    
-    // 모델의 바운딩 박스 계산
-    std::vector<double> getBoundingBox() {
-        if (triangles.empty()) return {0, 0, 0, 0, 0, 0};
-        
-        double minX = triangles[0].v1.x, maxX = triangles[0].v1.x;
-        double minY = triangles[0].v1.y, maxY = triangles[0].v1.y;
-        double minZ = triangles[0].v1.z, maxZ = triangles[0].v1.z;
-        
-        for (const auto& tri : triangles) {
-            minX = std::min(minX, std::min(tri.v1.x, std::min(tri.v2.x, tri.v3.x)));
-            maxX = std::max(maxX, std::max(tri.v1.x, std::max(tri.v2.x, tri.v3.x)));
-            minY = std::min(minY, std::min(tri.v1.y, std::min(tri.v2.y, tri.v3.y)));
-            maxY = std::max(maxY, std::max(tri.v1.y, std::max(tri.v2.y, tri.v3.y)));
-            minZ = std::min(minZ, std::min(tri.v1.z, std::min(tri.v2.z, tri.v3.z)));
-            maxZ = std::max(maxZ, std::max(tri.v1.z, std::max(tri.v2.z, tri.v3.z)));
+
+    ~ChunkCallbackBuf() override { sync(); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        flushChunk();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
         }
-        
-        return {minX, minY, minZ, maxX, maxY, maxZ};
+        return traits_type::not_eof(ch);
     }
-    
-    // 레이어별 슬라이싱
-    std::vector<Layer> slice() {
-        std::vector<Layer> layers;
-        auto bbox = getBoundingBox();
-        double minZ = bbox[2];
-        double maxZ = bbox[5];
-        
-        // 레이어 높이별로 슬라이싱
-        for (double z = minZ; z <= maxZ; z += layerHeight) {
-            Layer layer(z);
-            
-            // 현재 레이어에서 삼각형과의 교차점 계산
-            std::vector<Vector3> intersections;
-            
-            for (const auto& tri : triangles) {
-                // 삼각형이 현재 레이어와 교차하는지 확인
-                if ((tri.v1.z <= z && z <= tri.v2.z) || 
-                    (tri.v2.z <= z && z <= tri.v3.z) || 
-                    (tri.v3.z <= z && z <= tri.v1.z)) {
-                    
-                    // 교차점 계산 (간단한 선형 보간)
-                    Vector3 intersection = calculateIntersection(tri, z);
-                    intersections.push_back(intersection);
-                }
-            }
-            
-            // 교차점들을 윤곽선으로 구성
-            if (!intersections.empty()) {
-                layer.contours.push_back(intersections);
-                
-                // 인필 패턴 생성
-                layer.infill = generateInfill(intersections, z);
-            }
-            
-            layers.push_back(layer);
-        }
-        
-        return layers;
+
+    int sync() override {
+        flushChunk();
+        return 0;
     }
-    
-    // 삼각형과 평면의 교차점 계산
-    Vector3 calculateIntersection(const Triangle& tri, double z) {
-        // 간단한 선형 보간
-        double t1 = (z - tri.v1.z) / (tri.v2.z - tri.v1.z);
-        double t2 = (z - tri.v2.z) / (tri.v3.z - tri.v2.z);
-        
-        Vector3 p1(tri.v1.x + t1 * (tri.v2.x - tri.v1.x),
-                   tri.v1.y + t1 * (tri.v2.y - tri.v1.y),
-                   z);
-        
-        Vector3 p2(tri.v2.x + t2 * (tri.v3.x - tri.v2.x),
-                   tri.v2.y + t2 * (tri.v3.y - tri.v2.y),
-                   z);
-        
-        return Vector3((p1.x + p2.x) / 2, (p1.y + p2.y) / 2, z);
+
+    // tellp() 용 (G-code 크기 통계)
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out)) return pos_type(off_type(-1));
+        return pos_type(static_cast<off_type>(flushed + (pptr() - pbase())));
     }
-    
-    // 인필 패턴 생성
-    std::vector<std::vector<Vector3>> generateInfill(const std::vector<Vector3>& contour, double z) {
-        std::vector<std::vector<Vector3>> infill;
-        
-        // 간단한 직선 인필 패턴
-        auto bbox = getBoundingBox();
-        double minX = bbox[0], maxX = bbox[3];
-        double minY = bbox[1], maxY = bbox[4];
-        
-        double spacing = 2.0; // 인필 간격
-        double density = infillDensity / 100.0;
-        
-        for (double x = minX; x <= maxX; x += spacing / density) {
-            std::vector<Vector3> line;
-            line.push_back(Vector3(x, minY, z));
-            line.push_back(Vector3(x, maxY, z));
-            infill.push_back(line);
-        }
-        
-        return infill;
+
+private:
+    void flushChunk() {
+        size_t size = static_cast<size_t>(pptr() - pbase());
+        if (size == 0) return;
+        callback(val(typed_memory_view(size, reinterpret_cast<const uint8_t*>(pbase()))));
+        flushed += size;
+        setp(buffer.data(), buffer.data() + buffer.size());
     }
-    
-    // G-code 생성
-    std::string generateGCode() {
-        auto layers = slice();
-        std::stringstream gcode;
-        
-        gcode << "; Generated by WASM Slicer\n";
-        gcode << "; Layer height: " << layerHeight << "mm\n";
-        gcode << "; Infill density: " << infillDensity << "%\n\n";
-        
-        gcode << "G21 ; Set units to mm\n";
-        gcode << "G90 ; Absolute positioning\n";
-        gcode << "M82 ; Extruder absolute mode\n\n";
-        
-        double e = 0.0; // 압출량
-        
-        for (size_t i = 0; i < layers.size(); i++) {
-            const auto& layer = layers[i];
-            
-            gcode << "; Layer " << i << " at Z=" << layer.height << "\n";
-            
-            // 윤곽선 출력
-            for (const auto& contour : layer.contours) {
-                if (contour.empty()) continue;
-                
-                gcode << "G0 Z" << layer.height << " F1200\n";
-                gcode << "G0 X" << contour[0].x << " Y" << contour[0].y << " F3000\n";
-                
-                for (size_t j = 1; j < contour.size(); j++) {
-                    e += 0.1; // 간단한 압출량 계산
-                    gcode << "G1 X" << contour[j].x << " Y" << contour[j].y << " E" << e << " F1800\n";
-                }
-            }
-            
-            // 인필 출력
-            for (const auto& infillLine : layer.infill) {
-                if (infillLine.size() < 2) continue;
-                
-                gcode << "G0 Z" << layer.height << " F1200\n";
-                gcode << "G0 X" << infillLine[0].x << " Y" << infillLine[0].y << " F3000\n";
-                
-                e += 0.05;
-                gcode << "G1 X" << infillLine[1].x << " Y" << infillLine[1].y << " E" << e << " F1800\n";
-            }
-        }
-        
-        gcode << "\nG0 Z" << (layers.back().height + 10) << " F1200\n";
-        gcode << "M84 ; Disable steppers\n";
-        
-        return gcode.str();
+
+    val callback;
+    std::vector<char> buffer;
+    size_t flushed = 0;
+};
+
+// worker 가 malloc 한 힙 영역(SharedArrayBuffer 에서 복사한 STL/3MF 바이트)에서 메시 로드
+bool loadMeshFromHeap(SimpleSlicer& slicer, double address, double size) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(static_cast<uintptr_t>(address));
+    return slicer.loadMesh(data, static_cast<size_t>(size));
+}
+
+std::string getLoadError(SimpleSlicer& slicer) {
+    return slicer.loadError();
+}
+
+// 현재 메시/설정으로 자를 수 없으면 이유, 자를 수 있으면 빈 문자열
+std::string checkSlice(SimpleSlicer& slicer) {
+    std::string error;
+    slicer.checkSlice(&error);
+    return error;
+}
+
+// G-code 를 chunkBytes 단위 Uint8Array 뷰로 나눠 onChunk 에 넘긴다 (전체 문자열을 만들지 않음)
+void writeGCodeChunks(SimpleSlicer& slicer, val onChunk, int chunkBytes) {
+    ChunkCallbackBuf buffer(onChunk, static_cast<size_t>(std::max(4096, chunkBytes)));
+    std::ostream out(&buffer);
+    slicer.writeGCode(out);
+    out.flush();
+}
+
+// .gcode.3mf 패키지를 chunkBytes 단위로 onChunk 에 넘긴다 (PNG 는 Uint8Array 그대로 받음)
+// 성공하면 빈 문자열, 실패하면 이유
+std::string writeGCode3MFChunks(SimpleSlicer& slicer, const std::string& thumbnailPng,
+                                const std::string& smallThumbnailPng, const std::string& projectSettings,
+                                val onChunk, int chunkBytes) {
+    GCode3MFPlate plate;
+    plate.thumbnailPng = thumbnailPng;
+    plate.smallThumbnailPng = smallThumbnailPng;
+    plate.projectSettings = projectSettings;
+
+    ChunkCallbackBuf buffer(onChunk, static_cast<size_t>(std::max(4096, chunkBytes)));
+    std::ostream out(&buffer);
+    std::string error;
+    if (!slicer.writeGCode3MF(out, plate, &error)) return error.empty() ? "write failed" : error;
+    out.flush();
+    return std::string();
+}
+
+// 바이너리 G-code (.bgcode) 를 chunkBytes 단위로 onChunk 에 넘긴다. 썸네일은 PNG (없으면 빈 배열).
+// printerModel 은 프린터 메타데이터의 printer_model (비어 있으면 넣지 않음). 성공하면 빈 문자열, 실패하면 이유
+std::string writeBGCodeChunks(SimpleSlicer& slicer, const std::string& thumbnailPng, const std::string& printerModel,
+                              bool keepComments, val onChunk, int chunkBytes) {
+    BGCodePlate plate;
+    if (!thumbnailPng.empty()) plate.thumbnailsPng.push_back(thumbnailPng);
+    if (!printerModel.empty()) plate.printerMetadata.push_back({"printer_model", printerModel});
+    BGCodeOptions options;
+    options.keepComments = keepComments;
+
+    ChunkCallbackBuf buffer(onChunk, static_cast<size_t>(std::max(4096, chunkBytes)));
+    std::ostream out(&buffer);
+    std::string error;
+    if (!slicer.writeBGCode(out, plate, &error, options)) return error.empty() ? "write failed" : error;
+    out.flush();
+    return std::string();
+}
+
+// 마지막 slice() 결과를 힙 위의 typed array 뷰로 (다음 slice() 전까지 유효)
+// 점: [x0, y0, x1, y1, ...], 오프셋: 폴리라인 시작 점 번호 (+ 끝), 레이어: 높이와 첫 폴리라인 번호
+val getToolpathViews(SimpleSlicer& slicer) {
+    const LayerStore& layers = slicer.getLayers();
+    const PolylineBuffer& contours = layers.contours();
+    const PolylineBuffer& infill = layers.infill();
+
+    val views = val::object();
+    views.set("layerHeights", val(typed_memory_view(layers.layerCount(), layers.layerHeights().data())));
+    views.set("layerContourStart", val(typed_memory_view(layers.layerCount(), layers.layerContourStart().data())));
+    views.set("layerInfillStart", val(typed_memory_view(layers.layerCount(), layers.layerInfillStart().data())));
+    views.set("contourPoints", val(typed_memory_view(contours.pointCount() * 2, contours.pointData())));
+    views.set("contourOffsets", val(typed_memory_view(contours.polylineCount() + 1, contours.offsetData())));
+    views.set("infillPoints", val(typed_memory_view(infill.pointCount() * 2, infill.pointData())));
+    views.set("infillOffsets", val(typed_memory_view(infill.polylineCount() + 1, infill.offsetData())));
+    return views;
+}
+
+// 플레이트 자동 배치. points: [x0, y0, x1, y1, ...] (부품별 발자국, 모델 원점 기준),
+// offsets: 부품별 시작 점 번호 (+ 끝). 결과는 부품 순서대로 { placed, x, y, rotation }.
+val arrangeFootprints(val points, val offsets, const ArrangeSettings& settings) {
+    std::vector<double> xy = convertJSArrayToNumberVector<double>(points);
+    std::vector<double> starts = convertJSArrayToNumberVector<double>(offsets);
+    std::vector<ArrangePolygon> parts(starts.empty() ? 0 : starts.size() - 1);
+    for (size_t i = 0; i < parts.size(); i++) {
+        size_t begin = static_cast<size_t>(starts[i]), end = static_cast<size_t>(starts[i + 1]);
+        end = std::min(end, xy.size() / 2);
+        for (size_t k = begin; k < end; k++) parts[i].push_back({xy[k * 2], xy[k * 2 + 1]});
     }
-    
-    // JSON 형태로 레이어 정보 반환
-    std::string getLayerInfo() {
-        auto layers = slice();
-        std::stringstream json;
-        
-        json << "{\n";
-        json << "  \"layerHeight\": " << layerHeight << ",\n";
-        json << "  \"infillDensity\": " << infillDensity << ",\n";
-        json << "  \"totalLayers\": " << layers.size() << ",\n";
-        json << "  \"boundingBox\": [";
-        
-        auto bbox = getBoundingBox();
-        for (size_t i = 0; i < bbox.size(); i++) {
-            if (i > 0) json << ", ";
-            json << bbox[i];
+
+    std::vector<ArrangeResult> results = arrangeParts(parts, settings, &ThreadPool::shared());
+    val out = val::array();
+    for (size_t i = 0; i < results.size(); i++) {
+        val placement = val::object();
+        placement.set("placed", results[i].placed);
+        placement.set("x", results[i].x);
+        placement.set("y", results[i].y);
+        placement.set("rotation", results[i].rotation);
+        out.call<void>("push", placement);
+    }
+    return out;
+}
+
+// three.js BufferGeometry 의 position (xyz 반복) 과 index (없으면 빈 배열) 로 객체 메시 등록
+void setFootprintMesh(FootprintCache& cache, const std::string& id, val positions, val indices) {
+    std::vector<float> xyz = convertJSArrayToNumberVector<float>(positions);
+    std::vector<uint32_t> index = convertJSArrayToNumberVector<uint32_t>(indices);
+    size_t vertexCount = xyz.size() / 3;
+
+    Mesh mesh;
+    mesh.reserve(vertexCount, index.empty() ? vertexCount / 3 : index.size() / 3);
+    for (size_t i = 0; i < vertexCount; i++) mesh.addVertex(xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2]);
+    if (index.empty()) {
+        for (size_t t = 0; t + 2 < vertexCount; t += 3) {
+            mesh.addTriangle(static_cast<MeshIndex>(t), static_cast<MeshIndex>(t + 1), static_cast<MeshIndex>(t + 2));
         }
-        json << "],\n";
-        json << "  \"layers\": [\n";
-        
-        for (size_t i = 0; i < layers.size(); i++) {
-            if (i > 0) json << ",\n";
-            json << "    {\n";
-            json << "      \"height\": " << layers[i].height << ",\n";
-            json << "      \"contourCount\": " << layers[i].contours.size() << ",\n";
-            json << "      \"infillCount\": " << layers[i].infill.size() << "\n";
-            json << "    }";
+    } else {
+        for (size_t t = 0; t + 2 < index.size(); t += 3) {
+            if (index[t] >= vertexCount || index[t + 1] >= vertexCount || index[t + 2] >= vertexCount) continue;
+            mesh.addTriangle(index[t], index[t + 1], index[t + 2]);
         }
-        
-        json << "\n  ]\n";
-        json << "}";
-        
-        return json.str();
     }
-};
+    cache.setMesh(id, std::move(mesh));
+}
+
+val polygonArray(const ArrangePolygon& polygon) {
+    const double* data = reinterpret_cast<const double*>(polygon.data());
+    return val::global("Float64Array").new_(val(typed_memory_view(polygon.size() * 2, data)));
+}
+
+// matrix: Matrix4.elements (열 우선 16개). 메시를 등록하지 않았거나 메모리 상한으로 버린 id 면 null.
+// 결과: { hull, outlines: [...], area, minX, minY, maxX, maxY } (다각형은 [x0, y0, x1, y1, ...])
+val getFootprint(FootprintCache& cache, const std::string& id, val matrix) {
+    std::vector<double> elements = convertJSArrayToNumberVector<double>(matrix);
+    if (elements.size() != 16) return val::null();
+    const Footprint* footprint = cache.get(id, elements.data(), &ThreadPool::shared());
+    if (!footprint) return val::null();
+
+    val outlines = val::array();
+    for (const ArrangePolygon& outline : footprint->outlines) outlines.call<void>("push", polygonArray(outline));
+    val result = val::object();
+    result.set("hull", polygonArray(footprint->hull));
+    result.set("outlines", outlines);
+    result.set("area", footprint->area);
+    result.set("minX", footprint->minX);
+    result.set("minY", footprint->minY);
+    result.set("maxX", footprint->maxX);
+    result.set("maxY", footprint->maxY);
+    return result;
+}
+
+// 메시 BVH 일괄 질의 (rays: [ox, oy, oz, dx, dy, dz] 반복, points: [x, y, z] 반복)
+// 결과: Float64Array, 질의마다 [거리, 삼각형 번호, x, y, z, nx, ny, nz] (못 맞히면 거리/번호 -1)
+val raycastMesh(SimpleSlicer& slicer, val rays, double maxDistance) {
+    std::vector<double> hits = slicer.raycast(convertJSArrayToNumberVector<double>(rays), maxDistance);
+    return val::global("Float64Array").new_(val(typed_memory_view(hits.size(), hits.data())));
+}
+
+val closestPointsOnMesh(SimpleSlicer& slicer, val points, double maxDistance) {
+    std::vector<double> hits = slicer.closestPoints(convertJSArrayToNumberVector<double>(points), maxDistance);
+    return val::global("Float64Array").new_(val(typed_memory_view(hits.size(), hits.data())));
+}
+
+// 마지막으로 로드한 메시의 자동 방향 후보 (점수 낮은 순)
+// 결과: [{ downX, downY, downZ, qx, qy, qz, qw, score, overhangArea, supportVolume, contactArea, height }, ...]
+val findMeshOrientations(SimpleSlicer& slicer, const OrientOptions& options) {
+    std::vector<OrientCandidate> candidates = findOrientations(slicer.getMesh(), options, &ThreadPool::shared());
+    val out = val::array();
+    for (const OrientCandidate& c : candidates) {
+        val candidate = val::object();
+        candidate.set("downX", c.downX);
+        candidate.set("downY", c.downY);
+        candidate.set("downZ", c.downZ);
+        candidate.set("qx", c.qx);
+        candidate.set("qy", c.qy);
+        candidate.set("qz", c.qz);
+        candidate.set("qw", c.qw);
+        candidate.set("score", c.score);
+        candidate.set("overhangArea", c.overhangArea);
+        candidate.set("supportVolume", c.supportVolume);
+        candidate.set("contactArea", c.contactArea);
+        candidate.set("height", c.height);
+        out.call<void>("push", candidate);
+    }
+    return out;
+}
+
+} // namespace
 
 // Emscripten 바인딩
 EMSCRIPTEN_BINDINGS(slicer_module) {
@@ -269,12 +260,110 @@ EMSCRIPTEN_BINDINGS(slicer_module) {
         .property("y", &Vector3::y)
         .property("z", &Vector3::z);
     
+    value_object<SlicerStats>("SlicerStats")
+        .field("trianglesParsed", &SlicerStats::trianglesParsed)
+        .field("vertices", &SlicerStats::vertices)
+        .field("meshBytes", &SlicerStats::meshBytes)
+        .field("layers", &SlicerStats::layers)
+        .field("contourSegments", &SlicerStats::contourSegments)
+        .field("infillSegments", &SlicerStats::infillSegments)
+        .field("intersectionsTested", &SlicerStats::intersectionsTested)
+        .field("intersectionsHit", &SlicerStats::intersectionsHit)
+        .field("allocations", &SlicerStats::allocations)
+        .field("arenaPeakBytes", &SlicerStats::arenaPeakBytes)
+        .field("heapUsedBytes", &SlicerStats::heapUsedBytes)
+        .field("heapPeakBytes", &SlicerStats::heapPeakBytes)
+        .field("heapLimitBytes", &SlicerStats::heapLimitBytes)
+        .field("gcodeBytes", &SlicerStats::gcodeBytes)
+        .field("cacheHit", &SlicerStats::cacheHit)
+        .field("parseMs", &SlicerStats::parseMs)
+        .field("bboxMs", &SlicerStats::bboxMs)
+        .field("sliceMs", &SlicerStats::sliceMs)
+        .field("intersectMs", &SlicerStats::intersectMs)
+        .field("contourMs", &SlicerStats::contourMs)
+        .field("infillMs", &SlicerStats::infillMs)
+        .field("gcodeMs", &SlicerStats::gcodeMs)
+        .field("layerInfoMs", &SlicerStats::layerInfoMs)
+        .field("hashMs", &SlicerStats::hashMs);
+
+    value_object<MeshAnalysis>("MeshAnalysis")
+        .field("triangles", &MeshAnalysis::triangles)
+        .field("vertices", &MeshAnalysis::vertices)
+        .field("volume", &MeshAnalysis::volume)
+        .field("area", &MeshAnalysis::area)
+        .field("centroidX", &MeshAnalysis::centroidX)
+        .field("centroidY", &MeshAnalysis::centroidY)
+        .field("centroidZ", &MeshAnalysis::centroidZ)
+        .field("minX", &MeshAnalysis::minX)
+        .field("minY", &MeshAnalysis::minY)
+        .field("minZ", &MeshAnalysis::minZ)
+        .field("maxX", &MeshAnalysis::maxX)
+        .field("maxY", &MeshAnalysis::maxY)
+        .field("maxZ", &MeshAnalysis::maxZ)
+        .field("openEdges", &MeshAnalysis::openEdges)
+        .field("nonManifoldEdges", &MeshAnalysis::nonManifoldEdges)
+        .field("degenerateTriangles", &MeshAnalysis::degenerateTriangles)
+        .field("watertight", &MeshAnalysis::watertight);
+
+    value_object<ArrangeSettings>("ArrangeSettings")
+        .field("plateWidth", &ArrangeSettings::plateWidth)
+        .field("plateHeight", &ArrangeSettings::plateHeight)
+        .field("spacing", &ArrangeSettings::spacing)
+        .field("rotations", &ArrangeSettings::rotations)
+        .field("alignToCenter", &ArrangeSettings::alignToCenter);
+
+    function("arrangeFootprints", &arrangeFootprints);
+
+    class_<FootprintCache>("FootprintCache")
+        .constructor<>()
+        .function("setMesh", &setFootprintMesh)
+        .function("hasMesh", &FootprintCache::hasMesh)
+        .function("getFootprint", &getFootprint)
+        .function("remove", &FootprintCache::remove)
+        .function("clear", &FootprintCache::clear)
+        .function("setMemoryLimit", &FootprintCache::setMemoryLimit)
+        .function("memoryBytes", &FootprintCache::memoryBytes);
+
+    value_object<OrientOptions>("OrientOptions")
+        .field("samples", &OrientOptions::samples)
+        .field("topCount", &OrientOptions::topCount)
+        .field("overhangAngle", &OrientOptions::overhangAngle)
+        .field("contactTolerance", &OrientOptions::contactTolerance)
+        .field("minContactArea", &OrientOptions::minContactArea)
+        .field("supportWeight", &OrientOptions::supportWeight)
+        .field("overhangWeight", &OrientOptions::overhangWeight)
+        .field("contactWeight", &OrientOptions::contactWeight)
+        .field("heightWeight", &OrientOptions::heightWeight)
+        .field("stabilityWeight", &OrientOptions::stabilityWeight);
+
     class_<SimpleSlicer>("SimpleSlicer")
         .constructor<>()
         .function("setLayerHeight", &SimpleSlicer::setLayerHeight)
         .function("setInfillDensity", &SimpleSlicer::setInfillDensity)
         .function("parseSTL", &SimpleSlicer::parseSTL)
+        .function("loadTestMesh", &SimpleSlicer::loadTestMesh)
         .function("getBoundingBox", &SimpleSlicer::getBoundingBox)
+        .function("analyzeMesh", &SimpleSlicer::analyzeMesh)
         .function("generateGCode", &SimpleSlicer::generateGCode)
-        .function("getLayerInfo", &SimpleSlicer::getLayerInfo);
+        .function("loadMeshFromHeap", &loadMeshFromHeap)
+        .function("getLoadError", &getLoadError)
+        .function("checkSlice", &checkSlice)
+        .function("writeGCodeChunks", &writeGCodeChunks)
+        .function("writeGCode3MFChunks", &writeGCode3MFChunks)
+        .function("writeBGCodeChunks", &writeBGCodeChunks)
+        .function("getToolpathViews", &getToolpathViews)
+        .function("findOrientations", &findMeshOrientations)
+        .function("raycast", &raycastMesh)
+        .function("closestPoints", &closestPointsOnMesh)
+        .function("setThreadCount", &SimpleSlicer::setThreadCount)
+        .function("getThreadCount", &SimpleSlicer::getThreadCount)
+        .function("pickSegment", &SimpleSlicer::pickSegment)
+        .function("getAllocationStats", &SimpleSlicer::getAllocationStats)
+        .function("getMeshMemoryBytes", &SimpleSlicer::getMeshMemoryBytes)
+        .function("getLayerInfo", &SimpleSlicer::getLayerInfo)
+        .function("formatLayerInfo", &SimpleSlicer::formatLayerInfo)
+        .function("getSliceCacheKey", &SimpleSlicer::getSliceCacheKey)
+        .function("getStats", &SimpleSlicer::getStats)
+        .function("getTraceJson", &SimpleSlicer::getTraceJson)
+        .function("clearTrace", &SimpleSlicer::clearTrace);
 } 
\ No newline at end of file
@@ -0,0 +1,273 @@
+// 네이티브 배치 슬라이싱 CLI (브라우저 모듈과 같은 코어를 사용)
+//
+//   slicer-cli model.stl|model.3mf [-s settings.json] [-o out.gcode|out.gcode.3mf|out.bgcode] [--thumbnail plate.png]
+//              [--threads n] [--cache-dir dir] [--stream] [--info] [--trace trace.json]
+
+#include "bgcode_writer.h"
+#include "gcode_3mf_writer.h"
+#include "mapped_file.h"
+#include "simple_slicer.h"
+#include "slice_cache.h"
+#include "slicer_settings.h"
+#include "streaming_slicer.h"
+#include "thread_pool.h"
+#include "trace.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " <model.stl|model.3mf> [options]\n"
+              << "  -s, --settings <file>   settings JSON (layerHeight, infillDensity)\n"
+              << "  -o, --output <file>     G-code output (default: stdout); *.3mf writes a .gcode.3mf package,\n"
+              << "                          *.bgcode writes binary G-code (MeatPack + heatshrink)\n"
+              << "      --thumbnail <png>   plate thumbnail for the .gcode.3mf / .bgcode output\n"
+              << "  -j, --threads <n>       slicing threads (default: all cores, 1 = sequential)\n"
+              << "      --cache-dir <dir>   reuse G-code for the same mesh + settings\n"
+              << "      --stream            out-of-core slicing for meshes larger than memory\n"
+              << "      --run-triangles <n> triangles per sorted run with --stream\n"
+              << "      --info              print layer summary and stats JSON to stderr\n"
+              << "      --trace <file>      write a Chrome trace (needs a SLICER_TRACE build)\n"
+              << "  -h, --help              show this help\n";
+}
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string inputPath;
+    std::string settingsPath;
+    std::string outputPath;
+    std::string tracePath;
+    std::string cacheDir;
+    std::string thumbnailPath;
+    bool stream = false;
+    bool info = false;
+    int threads = 0;
+    size_t runTriangles = StreamingSliceOptions().runTriangles;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        auto value = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "error: " << name << " needs a value\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!std::strcmp(arg, "-s") || !std::strcmp(arg, "--settings")) {
+            settingsPath = value(arg);
+        } else if (!std::strcmp(arg, "-o") || !std::strcmp(arg, "--output")) {
+            outputPath = value(arg);
+        } else if (!std::strcmp(arg, "-j") || !std::strcmp(arg, "--threads")) {
+            threads = std::atoi(value(arg));
+            if (threads <= 0) {
+                std::cerr << "error: --threads must be positive\n";
+                return 2;
+            }
+        } else if (!std::strcmp(arg, "--thumbnail")) {
+            thumbnailPath = value(arg);
+        } else if (!std::strcmp(arg, "--cache-dir")) {
+            cacheDir = value(arg);
+        } else if (!std::strcmp(arg, "--stream")) {
+            stream = true;
+        } else if (!std::strcmp(arg, "--run-triangles")) {
+            runTriangles = std::strtoull(value(arg), nullptr, 10);
+            if (runTriangles == 0) {
+                std::cerr << "error: --run-triangles must be positive\n";
+                return 2;
+            }
+        } else if (!std::strcmp(arg, "--trace")) {
+            tracePath = value(arg);
+        } else if (!std::strcmp(arg, "--info")) {
+            info = true;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            std::cerr << "error: unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 2;
+        } else if (inputPath.empty()) {
+            inputPath = arg;
+        } else {
+            std::cerr << "error: more than one input mesh\n";
+            return 2;
+        }
+    }
+
+    if (inputPath.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+#ifndef SLICER_TRACE
+    if (!tracePath.empty()) {
+        std::cerr << "warning: built without SLICER_TRACE; the trace will be empty\n";
+    }
+#endif
+    TraceRecorder::global().setEnabled(!tracePath.empty());
+
+    SlicerSettings settings;
+    if (!settingsPath.empty()) {
+        std::string json, error;
+        if (!readFile(settingsPath, json)) {
+            std::cerr << "error: cannot read " << settingsPath << "\n";
+            return 1;
+        }
+        if (!parseSlicerSettings(json, settings, &error)) {
+            std::cerr << "error: " << settingsPath << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "error: cannot write " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    // *.3mf 출력이면 G-code 를 .gcode.3mf 패키지 엔트리로, *.bgcode 면 바이너리 G-code 블록으로 바로 압축해 쓴다
+    bool package = endsWith(outputPath, ".3mf");
+    bool binary = endsWith(outputPath, ".bgcode");
+    GCode3MFPlate plate;
+    BGCodePlate binaryPlate;
+    if (!thumbnailPath.empty()) {
+        if (!package && !binary) {
+            std::cerr << "warning: --thumbnail is only used with a .3mf or .bgcode output\n";
+        } else if (!readFile(thumbnailPath, plate.thumbnailPng)) {
+            std::cerr << "error: cannot read " << thumbnailPath << "\n";
+            return 1;
+        }
+        if (binary) binaryPlate.thumbnailsPng.push_back(plate.thumbnailPng);
+    }
+    auto writeOutput = [&](const std::function<void(std::ostream&)>& writeGCode) {
+        std::string error;
+        if (binary) {
+            if (!writeBGCode(out, binaryPlate, settings, writeGCode, &error)) {
+                std::cerr << "error: cannot write " << outputPath << ": " << error << "\n";
+                return false;
+            }
+            return true;
+        }
+        if (!package) {
+            writeGCode(out);
+            return true;
+        }
+        // 패키지 압축은 공용 풀에서 청크 병렬로 (-j 1 이면 순차)
+        if (!writeGCode3MF(out, plate, settings, writeGCode, &error, threads == 1 ? nullptr : &ThreadPool::shared())) {
+            std::cerr << "error: cannot write " << outputPath << ": " << error << "\n";
+            return false;
+        }
+        return true;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    if (stream) {
+        if (!cacheDir.empty()) {
+            std::cerr << "warning: --cache-dir is ignored with --stream\n";
+        }
+        StreamingSliceOptions options;
+        options.layerHeight = settings.layerHeight;
+        options.infillDensity = settings.infillDensity;
+        options.runTriangles = runTriangles;
+
+        StreamingSlicer slicer(options);
+        bool sliced = false;
+        if (!writeOutput([&](std::ostream& gcode) { sliced = slicer.sliceFile(inputPath, gcode); })) return 1;
+        if (!sliced) {
+            std::cerr << "error: failed to slice " << inputPath;
+            if (!slicer.error().empty()) std::cerr << ": " << slicer.error();
+            std::cerr << "\n";
+            return 1;
+        }
+        if (info) {
+            const StreamingSliceStats& stats = slicer.stats();
+            std::cerr << "{ \"triangles\": " << stats.triangles
+                      << ", \"runs\": " << stats.runs
+                      << ", \"layers\": " << stats.layers
+                      << ", \"peakBandTriangles\": " << stats.peakBandTriangles
+                      << ", \"elapsedMs\": " << elapsedMs() << " }\n";
+        }
+    } else {
+        // 입력은 매핑해 그 자리에서 파싱한다 (변환 후 바로 해제)
+        SimpleSlicer slicer;
+        slicer.setLayerHeight(settings.layerHeight);
+        slicer.setInfillDensity(settings.infillDensity);
+        if (threads > 0) slicer.setThreadCount(threads);
+        {
+            MappedFile input;
+            if (!input.open(inputPath) || !slicer.loadMesh(input.data(), input.size())) {
+                std::cerr << "error: cannot read mesh " << inputPath;
+                if (!slicer.loadError().empty()) std::cerr << ": " << slicer.loadError();
+                std::cerr << "\n";
+                return 1;
+            }
+        }
+        std::string sliceError;
+        if (!slicer.checkSlice(&sliceError)) {
+            std::cerr << "error: cannot slice " << inputPath << ": " << sliceError << "\n";
+            return 1;
+        }
+        DiskSliceCache cache(cacheDir);
+        bool written = writeOutput([&](std::ostream& gcode) {
+            if (cacheDir.empty()) {
+                slicer.writeGCode(gcode);
+            } else {
+                slicer.writeGCodeCached(gcode, cache);
+            }
+        });
+        if (!written) return 1;
+        if (info) {
+            double sliceMs = elapsedMs();
+            std::cerr << slicer.formatLayerInfo() << "\n"
+                      << slicerStatsToJson(slicer.getStats()) << "\n"
+                      << "{ \"elapsedMs\": " << sliceMs << " }\n";
+        }
+    }
+
+    out.flush();
+    if (!out) {
+        std::cerr << "error: failed writing G-code\n";
+        return 1;
+    }
+
+    if (!tracePath.empty()) {
+        std::ofstream trace(tracePath, std::ios::binary);
+        trace << TraceRecorder::global().toJson();
+        if (!trace) {
+            std::cerr << "error: cannot write " << tracePath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "slicer_settings.h"
+
+#include "xxhash64.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// 설정 파일용 최소 JSON 파서 (객체/배열/문자열/숫자/true/false/null)
+class JsonCursor {
+public:
+    explicit JsonCursor(const std::string& text) : text(text) {}
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool peek(char c) {
+        skipSpace();
+        return pos < text.size() && text[pos] == c;
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return pos >= text.size();
+    }
+
+    bool readString(std::string& out) {
+        if (!consume('"')) return false;
+        out.clear();
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') return true;
+            if (c == '\\') {
+                if (pos >= text.size()) return false;
+                char e = text[pos++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u':
+                        // 설정 키/값에 비 ASCII 는 쓰지 않으므로 코드 포인트는 버린다
+                        if (pos + 4 > text.size()) return false;
+                        pos += 4;
+                        break;
+                    default: out += e; break;
+                }
+            } else {
+                out += c;
+            }
+        }
+        return false;
+    }
+
+    bool readNumber(double& out) {
+        skipSpace();
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        out = std::strtod(begin, &end);
+        if (end == begin) return false;
+        pos += static_cast<size_t>(end - begin);
+        return true;
+    }
+
+    bool readLiteral(const char* word) {
+        skipSpace();
+        size_t n = 0;
+        while (word[n]) n++;
+        if (text.compare(pos, n, word) != 0) return false;
+        pos += n;
+        return true;
+    }
+
+    // 값 하나를 읽고 버린다
+    bool skipValue(int depth = 0) {
+        if (depth > 64) return false;
+        skipSpace();
+        if (pos >= text.size()) return false;
+        char c = text[pos];
+        if (c == '"') {
+            std::string ignored;
+            return readString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            pos++;
+            if (consume(close)) return true;
+            do {
+                if (c == '{') {
+                    std::string key;
+                    if (!readString(key) || !consume(':')) return false;
+                }
+                if (!skipValue(depth + 1)) return false;
+            } while (consume(','));
+            return consume(close);
+        }
+        if (c == 't') return readLiteral("true");
+        if (c == 'f') return readLiteral("false");
+        if (c == 'n') return readLiteral("null");
+        double ignored;
+        return readNumber(ignored);
+    }
+
+    size_t position() const { return pos; }
+
+private:
+    const std::string& text;
+    size_t pos = 0;
+};
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+bool parseSlicerSettings(const std::string& json, SlicerSettings& settings, std::string* error) {
+    JsonCursor cursor(json);
+    if (!cursor.consume('{')) return fail(error, "settings must be a JSON object");
+
+    SlicerSettings parsed = settings;
+    if (!cursor.consume('}')) {
+        do {
+            std::string key;
+            if (!cursor.readString(key) || !cursor.consume(':')) {
+                return fail(error, "malformed key at offset " + std::to_string(cursor.position()));
+            }
+
+            double* target = nullptr;
+            if (key == "layerHeight") target = &parsed.layerHeight;
+            else if (key == "infillDensity") target = &parsed.infillDensity;
+
+            if (target) {
+                if (!cursor.readNumber(*target)) return fail(error, "\"" + key + "\" must be a number");
+            } else if (!cursor.skipValue()) {
+                return fail(error, "malformed value for \"" + key + "\"");
+            }
+        } while (cursor.consume(','));
+
+        if (!cursor.consume('}')) return fail(error, "expected '}' at offset " + std::to_string(cursor.position()));
+    }
+    if (!cursor.atEnd()) return fail(error, "trailing data after settings object");
+
+    if (!(parsed.layerHeight > 0)) return fail(error, "layerHeight must be positive");
+    if (!(parsed.infillDensity > 0 && parsed.infillDensity <= 100)) {
+        return fail(error, "infillDensity must be in (0, 100]");
+    }
+
+    settings = parsed;
+    return true;
+}
+
+uint64_t hashSlicerSettings(const SlicerSettings& settings) {
+    // 이름=값 을 고정 순서로, 값은 왕복 가능한 정밀도로 적어 해시한다 (-0 은 0 으로)
+    auto field = [](std::string& out, const char* name, double value) {
+        char number[40];
+        std::snprintf(number, sizeof(number), "%.17g", value == 0 ? 0.0 : value);
+        out += name;
+        out += '=';
+        out += number;
+        out += ';';
+    };
+
+    std::string canonical;
+    field(canonical, "layerHeight", settings.layerHeight);
+    field(canonical, "infillDensity", settings.infillDensity);
+    return xxHash64(canonical.data(), canonical.size());
+}
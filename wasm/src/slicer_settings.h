@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// 슬라이싱 설정 (CLI 의 settings.json, 브라우저 설정과 같은 키 이름)
+struct SlicerSettings {
+    double layerHeight = 0.2;
+    double infillDensity = 20.0;
+};
+
+// 최상위 JSON 객체에서 알려진 키만 읽는다. 모르는 키와 중첩 값은 건너뛴다.
+// 형식이 잘못되었거나 값이 범위를 벗어나면 false 와 함께 error 에 이유를 적는다.
+bool parseSlicerSettings(const std::string& json, SlicerSettings& settings, std::string* error = nullptr);
+
+// 설정 값의 정규화된 해시 (JSON 키 순서, 공백, 숫자 표기와 무관). 슬라이스 캐시 키에 쓴다.
+uint64_t hashSlicerSettings(const SlicerSettings& settings);
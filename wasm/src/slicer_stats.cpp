@@ -0,0 +1,64 @@
+#include "slicer_stats.h"
+
+#include <algorithm>
+#include <sstream>
+
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/heap.h>
+#include <malloc.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+void sampleHeapUsage(SlicerStats& stats) {
+#if defined(__EMSCRIPTEN__)
+    // 사용 중인 malloc 바이트, 현재 선형 메모리 크기, 성장 한도
+    struct mallinfo info = mallinfo();
+    stats.heapUsedBytes = static_cast<double>(info.uordblks);
+    stats.heapLimitBytes = static_cast<double>(emscripten_get_heap_max());
+#elif defined(__unix__) || defined(__APPLE__)
+    // 네이티브에는 malloc 사용량을 싸게 얻을 이식 가능한 방법이 없어 최대 RSS 를 쓴다
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        stats.heapUsedBytes = static_cast<double>(usage.ru_maxrss);
+#else
+        stats.heapUsedBytes = static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+    }
+    stats.heapLimitBytes = 0;
+#endif
+    stats.heapPeakBytes = std::max(stats.heapPeakBytes, stats.heapUsedBytes);
+}
+
+std::string slicerStatsToJson(const SlicerStats& stats) {
+    std::stringstream json;
+    json.precision(15);
+    json << "{\n";
+    json << "  \"trianglesParsed\": " << stats.trianglesParsed << ",\n";
+    json << "  \"vertices\": " << stats.vertices << ",\n";
+    json << "  \"meshBytes\": " << stats.meshBytes << ",\n";
+    json << "  \"layers\": " << stats.layers << ",\n";
+    json << "  \"contourSegments\": " << stats.contourSegments << ",\n";
+    json << "  \"infillSegments\": " << stats.infillSegments << ",\n";
+    json << "  \"intersectionsTested\": " << stats.intersectionsTested << ",\n";
+    json << "  \"intersectionsHit\": " << stats.intersectionsHit << ",\n";
+    json << "  \"allocations\": " << stats.allocations << ",\n";
+    json << "  \"arenaPeakBytes\": " << stats.arenaPeakBytes << ",\n";
+    json << "  \"heapUsedBytes\": " << stats.heapUsedBytes << ",\n";
+    json << "  \"heapPeakBytes\": " << stats.heapPeakBytes << ",\n";
+    json << "  \"heapLimitBytes\": " << stats.heapLimitBytes << ",\n";
+    json << "  \"gcodeBytes\": " << stats.gcodeBytes << ",\n";
+    json << "  \"cacheHit\": " << stats.cacheHit << ",\n";
+    json << "  \"parseMs\": " << stats.parseMs << ",\n";
+    json << "  \"bboxMs\": " << stats.bboxMs << ",\n";
+    json << "  \"sliceMs\": " << stats.sliceMs << ",\n";
+    json << "  \"intersectMs\": " << stats.intersectMs << ",\n";
+    json << "  \"contourMs\": " << stats.contourMs << ",\n";
+    json << "  \"infillMs\": " << stats.infillMs << ",\n";
+    json << "  \"gcodeMs\": " << stats.gcodeMs << ",\n";
+    json << "  \"layerInfoMs\": " << stats.layerInfoMs << ",\n";
+    json << "  \"hashMs\": " << stats.hashMs << "\n";
+    json << "}";
+    return json.str();
+}
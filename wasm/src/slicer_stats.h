@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// 항상 켜져 있는 실행 통계 (embind value_object 로 그대로 JS 객체가 된다)
+// JS number 로 넘기기 위해 카운터도 double 로 둔다 (2^53 까지 정확).
+struct SlicerStats {
+    // 입력
+    double trianglesParsed = 0;
+    double vertices = 0;
+    double meshBytes = 0;
+
+    // 슬라이스
+    double layers = 0;
+    double contourSegments = 0;
+    double infillSegments = 0;
+    double intersectionsTested = 0;   // 레이어마다 검사한 삼각형 수의 합
+    double intersectionsHit = 0;      // 그중 평면과 만난 수
+
+    // 임시 메모리 (마지막 slice() 의 아레나)
+    double allocations = 0;
+    double arenaPeakBytes = 0;
+
+    // 프로세스 힙 (wasm: 선형 메모리, 네이티브: RSS)
+    double heapUsedBytes = 0;
+    double heapPeakBytes = 0;
+    double heapLimitBytes = 0;
+
+    // 출력
+    double gcodeBytes = 0;
+    double cacheHit = 0;              // 마지막 G-code 를 슬라이스 캐시에서 꺼냈으면 1
+
+    // 단계별 벽시계 시간 (ms, 마지막 실행 기준)
+    double parseMs = 0;
+    double bboxMs = 0;
+    double sliceMs = 0;
+    double intersectMs = 0;
+    double contourMs = 0;
+    double infillMs = 0;
+    double gcodeMs = 0;
+    double layerInfoMs = 0;
+    double hashMs = 0;                // 슬라이스 캐시 키용 메시 해시
+};
+
+// 현재 힙 정보를 stats 의 heap* 필드에 채운다 (peak 는 지금까지의 최대값 유지)
+void sampleHeapUsage(SlicerStats& stats);
+
+std::string slicerStatsToJson(const SlicerStats& stats);
+
+// 단계 시간 측정용 스톱워치
+class StageTimer {
+public:
+    StageTimer() : start(std::chrono::steady_clock::now()) {}
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,307 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 축당 최대 셀 수 (긴 선분이 많은 레이어에서 메모리 폭주 방지)
+const int kMaxCellsPerAxis = 1024;
+
+bool hasKind(SegmentKind kind, SegmentKind mask) {
+    return (static_cast<uint8_t>(kind) & static_cast<uint8_t>(mask)) != 0;
+}
+
+double cross(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+bool onSegment(double ax, double ay, double bx, double by, double px, double py) {
+    return std::min(ax, bx) <= px && px <= std::max(ax, bx) &&
+           std::min(ay, by) <= py && py <= std::max(ay, by);
+}
+
+// 두 선분의 교차 여부 (끝점 접촉 포함)
+bool segmentsIntersect(double ax, double ay, double bx, double by, const Segment2& s) {
+    double d1 = cross(s.x0, s.y0, s.x1, s.y1, ax, ay);
+    double d2 = cross(s.x0, s.y0, s.x1, s.y1, bx, by);
+    double d3 = cross(ax, ay, bx, by, s.x0, s.y0);
+    double d4 = cross(ax, ay, bx, by, s.x1, s.y1);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+        ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return true;
+    }
+
+    if (d1 == 0 && onSegment(s.x0, s.y0, s.x1, s.y1, ax, ay)) return true;
+    if (d2 == 0 && onSegment(s.x0, s.y0, s.x1, s.y1, bx, by)) return true;
+    if (d3 == 0 && onSegment(ax, ay, bx, by, s.x0, s.y0)) return true;
+    if (d4 == 0 && onSegment(ax, ay, bx, by, s.x1, s.y1)) return true;
+    return false;
+}
+
+double pointSegmentDistanceSq(double px, double py, const Segment2& s) {
+    double dx = s.x1 - s.x0;
+    double dy = s.y1 - s.y0;
+    double lengthSq = dx * dx + dy * dy;
+    double t = 0;
+    if (lengthSq > 0) {
+        t = ((px - s.x0) * dx + (py - s.y0) * dy) / lengthSq;
+        t = std::max(0.0, std::min(1.0, t));
+    }
+    double cx = s.x0 + t * dx - px;
+    double cy = s.y0 + t * dy - py;
+    return cx * cx + cy * cy;
+}
+
+} // namespace
+
+void SegmentGrid::clear() {
+    built = false;
+    cols = rows = 0;
+    segments.clear();
+    cellStart.clear();
+    cellItems.clear();
+    visitStamp.clear();
+    currentStamp = 0;
+}
+
+void SegmentGrid::addPolyline(const PolylineView& line, size_t index, SegmentKind kind) {
+    for (size_t i = 1; i < line.size(); i++) {
+        const Point2& a = line[i - 1];
+        const Point2& b = line[i];
+        // 퇴화된 교차점(NaN 등)은 인덱싱하지 않는다
+        if (!std::isfinite(a.x) || !std::isfinite(a.y) ||
+            !std::isfinite(b.x) || !std::isfinite(b.y)) {
+            continue;
+        }
+        segments.push_back({a.x, a.y, b.x, b.y, static_cast<uint32_t>(index), kind});
+    }
+}
+
+int SegmentGrid::cellX(double x) const {
+    double c = std::floor((x - originX) / cellSize);
+    if (!(c > 0)) return 0;
+    if (c >= cols - 1) return cols - 1;
+    return static_cast<int>(c);
+}
+
+int SegmentGrid::cellY(double y) const {
+    double c = std::floor((y - originY) / cellSize);
+    if (!(c > 0)) return 0;
+    if (c >= rows - 1) return rows - 1;
+    return static_cast<int>(c);
+}
+
+uint32_t SegmentGrid::nextStamp() const {
+    if (++currentStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        currentStamp = 1;
+    }
+    return currentStamp;
+}
+
+// 선분이 지나는 셀을 순서대로 방문 (Amanatides-Woo 방식)
+// fn 이 false 를 반환하면 중단한다.
+template <typename Fn>
+void SegmentGrid::walkCells(double x0, double y0, double x1, double y1, Fn&& fn) const {
+    int cx = cellX(x0), cy = cellY(y0);
+    int ex = cellX(x1), ey = cellY(y1);
+
+    double dx = x1 - x0;
+    double dy = y1 - y0;
+    int stepX = ex > cx ? 1 : (ex < cx ? -1 : 0);
+    int stepY = ey > cy ? 1 : (ey < cy ? -1 : 0);
+    int remainingX = std::abs(ex - cx);
+    int remainingY = std::abs(ey - cy);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    double tDeltaX = dx != 0 ? cellSize / std::abs(dx) : inf;
+    double tDeltaY = dy != 0 ? cellSize / std::abs(dy) : inf;
+    double tMaxX = dx != 0 ? (originX + (cx + (stepX > 0 ? 1 : 0)) * cellSize - x0) / dx : inf;
+    double tMaxY = dy != 0 ? (originY + (cy + (stepY > 0 ? 1 : 0)) * cellSize - y0) / dy : inf;
+
+    if (!fn(cx, cy)) return;
+    while (remainingX > 0 || remainingY > 0) {
+        if (remainingX > 0 && (remainingY == 0 || tMaxX < tMaxY)) {
+            cx += stepX;
+            tMaxX += tDeltaX;
+            remainingX--;
+        } else {
+            cy += stepY;
+            tMaxY += tDeltaY;
+            remainingY--;
+        }
+        if (!fn(cx, cy)) return;
+    }
+}
+
+void SegmentGrid::build(const LayerView& layer, double requestedCellSize) {
+    clear();
+    for (size_t i = 0; i < layer.contourCount(); i++) {
+        addPolyline(layer.contour(i), i, SegmentKind::Contour);
+    }
+    for (size_t i = 0; i < layer.infillCount(); i++) {
+        addPolyline(layer.infill(i), i, SegmentKind::Infill);
+    }
+    built = true;
+
+    if (segments.empty()) {
+        cellStart.assign(1, 0);
+        return;
+    }
+
+    double minX = segments[0].x0, maxX = segments[0].x0;
+    double minY = segments[0].y0, maxY = segments[0].y0;
+    for (const auto& s : segments) {
+        minX = std::min(minX, std::min(s.x0, s.x1));
+        maxX = std::max(maxX, std::max(s.x0, s.x1));
+        minY = std::min(minY, std::min(s.y0, s.y1));
+        maxY = std::max(maxY, std::max(s.y0, s.y1));
+    }
+
+    double width = maxX - minX;
+    double height = maxY - minY;
+    double extent = std::max(width, height);
+
+    // 기본값: 셀 수 ≈ 선분 수
+    if (requestedCellSize <= 0) {
+        double area = std::max(width, extent / kMaxCellsPerAxis) *
+                      std::max(height, extent / kMaxCellsPerAxis);
+        requestedCellSize = std::sqrt(area / segments.size());
+    }
+    cellSize = std::max(requestedCellSize, extent / kMaxCellsPerAxis);
+    if (!(cellSize > 0)) cellSize = 1.0;
+
+    originX = minX;
+    originY = minY;
+    cols = std::min(kMaxCellsPerAxis, static_cast<int>(width / cellSize) + 1);
+    rows = std::min(kMaxCellsPerAxis, static_cast<int>(height / cellSize) + 1);
+
+    // 1단계: 셀별 선분 수 집계
+    cellStart.assign(static_cast<size_t>(cols) * rows + 1, 0);
+    for (const auto& s : segments) {
+        walkCells(s.x0, s.y0, s.x1, s.y1, [&](int cx, int cy) {
+            cellStart[static_cast<size_t>(cy) * cols + cx + 1]++;
+            return true;
+        });
+    }
+    for (size_t i = 1; i < cellStart.size(); i++) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    // 2단계: 셀 목록 채우기
+    cellItems.resize(cellStart.back());
+    std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < segments.size(); i++) {
+        const auto& s = segments[i];
+        walkCells(s.x0, s.y0, s.x1, s.y1, [&](int cx, int cy) {
+            cellItems[cursor[static_cast<size_t>(cy) * cols + cx]++] = static_cast<uint32_t>(i);
+            return true;
+        });
+    }
+
+    visitStamp.assign(segments.size(), 0);
+}
+
+void SegmentGrid::queryRect(double minX, double minY, double maxX, double maxY,
+                            std::vector<uint32_t>& out, SegmentKind mask) const {
+    queryStats.queries++;
+    if (segments.empty()) return;
+
+    int x0 = cellX(minX), x1 = cellX(maxX);
+    int y0 = cellY(minY), y1 = cellY(maxY);
+    uint32_t stamp = nextStamp();
+
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            queryStats.cellsVisited++;
+            size_t cell = static_cast<size_t>(cy) * cols + cx;
+            for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                uint32_t id = cellItems[k];
+                if (visitStamp[id] == stamp) continue;
+                visitStamp[id] = stamp;
+
+                const Segment2& s = segments[id];
+                if (!hasKind(s.kind, mask)) continue;
+                queryStats.candidatesTested++;
+
+                if (std::max(s.x0, s.x1) < minX || std::min(s.x0, s.x1) > maxX ||
+                    std::max(s.y0, s.y1) < minY || std::min(s.y0, s.y1) > maxY) {
+                    continue;
+                }
+                queryStats.hits++;
+                out.push_back(id);
+            }
+        }
+    }
+}
+
+int64_t SegmentGrid::nearestSegment(double x, double y, double radius, double* distance,
+                                    SegmentKind mask) const {
+    thread_local std::vector<uint32_t> candidates;
+    candidates.clear();
+    queryRect(x - radius, y - radius, x + radius, y + radius, candidates, mask);
+
+    int64_t best = -1;
+    double bestDistSq = radius * radius;
+    for (uint32_t id : candidates) {
+        double d = pointSegmentDistanceSq(x, y, segments[id]);
+        if (d <= bestDistSq) {
+            bestDistSq = d;
+            best = id;
+        }
+    }
+
+    if (best >= 0 && distance) *distance = std::sqrt(bestDistSq);
+    return best;
+}
+
+bool SegmentGrid::crossesAny(double ax, double ay, double bx, double by, SegmentKind mask) const {
+    queryStats.queries++;
+    if (segments.empty()) return false;
+
+    // 격자 영역으로 클리핑 (Liang-Barsky) 후 셀을 따라간다
+    double t0 = 0, t1 = 1;
+    double dx = bx - ax, dy = by - ay;
+    const double p[4] = {-dx, dx, -dy, dy};
+    const double q[4] = {ax - originX, originX + cols * cellSize - ax,
+                         ay - originY, originY + rows * cellSize - ay};
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0) {
+            if (q[i] < 0) return false;
+            continue;
+        }
+        double r = q[i] / p[i];
+        if (p[i] < 0) t0 = std::max(t0, r);
+        else t1 = std::min(t1, r);
+    }
+    if (t0 > t1) return false;
+
+    uint32_t stamp = nextStamp();
+    bool found = false;
+
+    walkCells(ax + t0 * dx, ay + t0 * dy, ax + t1 * dx, ay + t1 * dy, [&](int cx, int cy) {
+        queryStats.cellsVisited++;
+        size_t cell = static_cast<size_t>(cy) * cols + cx;
+        for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+            uint32_t id = cellItems[k];
+            if (visitStamp[id] == stamp) continue;
+            visitStamp[id] = stamp;
+
+            const Segment2& s = segments[id];
+            if (!hasKind(s.kind, mask)) continue;
+            queryStats.candidatesTested++;
+
+            if (segmentsIntersect(ax, ay, bx, by, s)) {
+                found = true;
+                return false;
+            }
+        }
+        return true;
+    });
+
+    if (found) queryStats.hits++;
+    return found;
+}
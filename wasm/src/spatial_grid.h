@@ -0,0 +1,83 @@
+#pragma once
+
+#include "layer_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 선분 종류 (윤곽선 / 인필)
+enum class SegmentKind : uint8_t {
+    Contour = 1,
+    Infill = 2,
+    Any = Contour | Infill
+};
+
+// 레이어 평면 위의 툴패스 선분
+struct Segment2 {
+    double x0, y0, x1, y1;
+    uint32_t polyline;   // 레이어 내 폴리라인 번호 (종류별)
+    SegmentKind kind;
+};
+
+// 질의 통계 (벤치마크에서 적중률 계산용)
+struct GridQueryStats {
+    uint64_t queries = 0;
+    uint64_t cellsVisited = 0;
+    uint64_t candidatesTested = 0;
+    uint64_t hits = 0;
+};
+
+// 레이어별 균일 격자 인덱스
+// 셀 목록은 CSR 형태(cellStart + cellItems)로 연속 저장되며, 구축은 선분 수에 선형이다.
+// 질의는 내부 방문 표시를 갱신하므로 하나의 인덱스를 여러 스레드에서 동시에 질의하면 안 된다.
+class SegmentGrid {
+public:
+    // cellSize <= 0 이면 선분 수에 맞춰 자동 결정
+    void build(const LayerView& layer, double cellSize = 0);
+    void clear();
+
+    bool isBuilt() const { return built; }
+    size_t segmentCount() const { return segments.size(); }
+    const Segment2& segment(size_t index) const { return segments[index]; }
+    double getCellSize() const { return cellSize; }
+    int getColumns() const { return cols; }
+    int getRows() const { return rows; }
+
+    // 사각형과 바운딩 박스가 겹치는 선분 번호 수집 (infill 클리핑, 피킹 후보)
+    void queryRect(double minX, double minY, double maxX, double maxY,
+                   std::vector<uint32_t>& out, SegmentKind mask = SegmentKind::Any) const;
+
+    // 반경 내 가장 가까운 선분 번호, 없으면 -1 (시각화 피킹, 이동 최적화)
+    int64_t nearestSegment(double x, double y, double radius, double* distance = nullptr,
+                           SegmentKind mask = SegmentKind::Any) const;
+
+    // 이동 경로 a→b 가 선분과 교차하는지 (combing 의 외벽 통과 검사)
+    bool crossesAny(double ax, double ay, double bx, double by,
+                    SegmentKind mask = SegmentKind::Contour) const;
+
+    const GridQueryStats& stats() const { return queryStats; }
+    void resetStats() { queryStats = GridQueryStats(); }
+
+private:
+    void addPolyline(const PolylineView& line, size_t index, SegmentKind kind);
+    int cellX(double x) const;
+    int cellY(double y) const;
+    uint32_t nextStamp() const;
+
+    template <typename Fn>
+    void walkCells(double x0, double y0, double x1, double y1, Fn&& fn) const;
+
+    bool built = false;
+    double originX = 0, originY = 0;
+    double cellSize = 1;
+    int cols = 0, rows = 0;
+
+    std::vector<Segment2> segments;
+    std::vector<uint32_t> cellStart;   // cols * rows + 1
+    std::vector<uint32_t> cellItems;
+
+    mutable std::vector<uint32_t> visitStamp;
+    mutable uint32_t currentStamp = 0;
+    mutable GridQueryStats queryStats;
+};
@@ -0,0 +1,227 @@
+#include "stl_reader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+const size_t kBinaryHeaderSize = 84;
+const size_t kBinaryRecordSize = 50;
+
+uint32_t readUint32LE(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+float readFloatLE(const unsigned char* p) {
+    uint32_t bits = readUint32LE(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 정점 병합 키 (저장 타입 기준으로 완전히 같은 좌표만 병합)
+struct VertexKey {
+    MeshScalar x, y, z;
+    bool operator==(const VertexKey& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        std::hash<MeshScalar> h;
+        size_t seed = h(key.x);
+        seed ^= h(key.y) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        seed ^= h(key.z) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+// 복사 없이 메모리 버퍼를 읽는 스트림 버퍼 (StlReader 가 탐색하므로 seek 지원)
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const unsigned char* data, size_t size) {
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+        off_type base = dir == std::ios_base::beg ? 0
+                      : dir == std::ios_base::cur ? gptr() - eback()
+                      : egptr() - eback();
+        off_type target = base + off;
+        if (target < 0 || target > egptr() - eback()) return pos_type(off_type(-1));
+        setg(eback(), eback() + target, egptr());
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+// 삼각형을 하나씩 받아 정점을 병합하며 메시에 추가
+template <typename NextTriangle>
+bool buildWeldedMesh(Mesh& mesh, uint64_t declaredCount, NextTriangle next) {
+    mesh.clear();
+    if (declaredCount > 0) {
+        size_t count = static_cast<size_t>(declaredCount);
+        mesh.reserve(count / 2 + 3, count);
+    }
+
+    std::unordered_map<VertexKey, MeshIndex, VertexKeyHash> welded;
+    double tri[9];
+    while (next(tri)) {
+        MeshIndex idx[3];
+        for (int v = 0; v < 3; v++) {
+            VertexKey key{static_cast<MeshScalar>(tri[v * 3]),
+                          static_cast<MeshScalar>(tri[v * 3 + 1]),
+                          static_cast<MeshScalar>(tri[v * 3 + 2])};
+            // NaN/inf (저장 타입으로 넘친 값 포함) 은 STL 이 아닌 바이트를 읽은 것으로 보고 거부
+            if (!std::isfinite(key.x) || !std::isfinite(key.y) || !std::isfinite(key.z)) return false;
+            auto found = welded.find(key);
+            if (found != welded.end()) {
+                idx[v] = found->second;
+            } else {
+                if (mesh.vertexCount() >= Mesh::maxVertices()) return false;
+                idx[v] = mesh.addVertex(key.x, key.y, key.z);
+                welded.emplace(key, idx[v]);
+            }
+        }
+        mesh.addTriangle(idx[0], idx[1], idx[2]);
+    }
+
+    return !mesh.empty();
+}
+
+} // namespace
+
+StlReader::StlReader(std::istream& in) : in(in) {
+    unsigned char header[kBinaryHeaderSize];
+    in.read(reinterpret_cast<char*>(header), kBinaryHeaderSize);
+    size_t got = static_cast<size_t>(in.gcount());
+
+    // 전체 크기로 바이너리 여부를 먼저 판단 ("solid" 로 시작하는 바이너리 파일도 있다)
+    in.clear();
+    in.seekg(0, std::ios::end);
+    std::streamoff total = in.tellg();
+
+    if (got == kBinaryHeaderSize && total >= 0) {
+        uint32_t count = readUint32LE(header + 80);
+        if (static_cast<uint64_t>(total) == kBinaryHeaderSize + uint64_t(count) * kBinaryRecordSize) {
+            binary = true;
+            declaredCount = count;
+        }
+    }
+
+    if (binary) {
+        in.seekg(kBinaryHeaderSize, std::ios::beg);
+        valid = true;
+        return;
+    }
+
+    if (got >= 5 && std::memcmp(header, "solid", 5) == 0) {
+        in.seekg(0, std::ios::beg);
+        valid = true;
+        return;
+    }
+
+    // 선언한 레코드가 모두 있고 뒤에 바이트가 더 붙은 바이너리: 선언한 수만큼 읽는다.
+    // 레코드가 모자란 파일 (잘린 파일, OBJ/PLY 등 STL 이 아닌 파일) 은 읽지 않는다.
+    if (got == kBinaryHeaderSize && total >= 0) {
+        uint32_t count = readUint32LE(header + 80);
+        if (count > 0 && static_cast<uint64_t>(total) > kBinaryHeaderSize + uint64_t(count) * kBinaryRecordSize) {
+            binary = true;
+            declaredCount = count;
+            in.seekg(kBinaryHeaderSize, std::ios::beg);
+            valid = true;
+        }
+    }
+}
+
+bool StlReader::next(double out[9]) {
+    if (!valid) return false;
+    return binary ? nextBinary(out) : nextAscii(out);
+}
+
+bool StlReader::nextBinary(double out[9]) {
+    if (readCount >= declaredCount) return false;
+
+    unsigned char record[kBinaryRecordSize];
+    in.read(reinterpret_cast<char*>(record), kBinaryRecordSize);
+    if (static_cast<size_t>(in.gcount()) != kBinaryRecordSize) return false;
+
+    // 법선(12바이트)은 건너뛰고 세 정점만 읽는다
+    for (int i = 0; i < 9; i++) {
+        out[i] = readFloatLE(record + 12 + i * 4);
+    }
+    readCount++;
+    return true;
+}
+
+bool StlReader::nextAscii(double out[9]) {
+    std::string word;
+    int vertices = 0;
+    while (in >> word) {
+        if (word == "vertex") {
+            double* v = out + vertices * 3;
+            if (!(in >> v[0] >> v[1] >> v[2])) return false;
+            if (++vertices == 3) {
+                readCount++;
+                return true;
+            }
+        } else if (word == "endsolid") {
+            // 여러 solid 가 이어진 파일은 계속 읽는다
+            continue;
+        }
+    }
+    return false;
+}
+
+bool loadSTL(std::istream& in, Mesh& mesh) {
+    StlReader reader(in);
+    if (!reader.isValid()) return false;
+    return buildWeldedMesh(mesh, reader.declaredTriangleCount(),
+                           [&reader](double* tri) { return reader.next(tri); });
+}
+
+bool loadSTL(const unsigned char* data, size_t size, Mesh& mesh) {
+    if (!data) return false;
+
+    // 판별 순서는 StlReader 와 같다: 크기가 맞는 바이너리 > "solid" ASCII > 뒤에 바이트가 더 붙은 바이너리
+    uint64_t count = size >= kBinaryHeaderSize ? readUint32LE(data + 80) : 0;
+    uint64_t expected = kBinaryHeaderSize + count * kBinaryRecordSize;
+    bool binary = size >= kBinaryHeaderSize && size == expected;
+
+    if (!binary && size >= 5 && std::memcmp(data, "solid", 5) == 0) {
+        // ASCII 는 토큰 파싱이라 메모리 스트림으로 기존 경로를 탄다 (복사 없음)
+        MemoryStreamBuf buffer(data, size);
+        std::istream in(&buffer);
+        return loadSTL(in, mesh);
+    }
+    // 선언한 레코드가 다 없으면 (잘린 파일, STL 이 아닌 파일) 거부
+    if (size < kBinaryHeaderSize || count == 0 || size < expected) return false;
+
+    // 바이너리 레코드는 버퍼에서 바로 디코딩한다
+    const unsigned char* record = data + kBinaryHeaderSize;
+    uint64_t read = 0;
+    return buildWeldedMesh(mesh, count, [&](double* tri) {
+        if (read >= count) return false;
+        for (int i = 0; i < 9; i++) {
+            tri[i] = readFloatLE(record + 12 + i * 4);
+        }
+        record += kBinaryRecordSize;
+        read++;
+        return true;
+    });
+}
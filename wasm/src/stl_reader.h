@@ -0,0 +1,40 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+
+// STL 삼각형 순차 읽기 (바이너리 / ASCII 자동 판별)
+// 전체 파일을 메모리에 올리지 않고 한 삼각형씩 읽는다. 입력 스트림은 탐색(seek) 가능해야 한다.
+class StlReader {
+public:
+    explicit StlReader(std::istream& in);
+
+    bool isValid() const { return valid; }
+    bool isBinary() const { return binary; }
+
+    // 바이너리 헤더에 적힌 삼각형 수 (ASCII 는 0)
+    uint64_t declaredTriangleCount() const { return declaredCount; }
+
+    // 다음 삼각형 좌표 [x1 y1 z1 x2 y2 z2 x3 y3 z3], 끝이면 false
+    bool next(double out[9]);
+
+private:
+    bool nextBinary(double out[9]);
+    bool nextAscii(double out[9]);
+
+    std::istream& in;
+    bool valid = false;
+    bool binary = false;
+    uint64_t declaredCount = 0;
+    uint64_t readCount = 0;
+};
+
+// STL 을 읽어 정점을 병합한 인덱스 메시로 변환
+// 삼각형 순서는 파일 순서를 유지한다. 읽은 삼각형이 없으면 false.
+bool loadSTL(std::istream& in, Mesh& mesh);
+
+// 메모리에 있는 STL 을 복사 없이 읽는다 (mmap 한 파일, JS 에서 넘어온 바이트 배열)
+bool loadSTL(const unsigned char* data, size_t size, Mesh& mesh);
@@ -0,0 +1,229 @@
+#include "streaming_slicer.h"
+
+#include "gcode_writer.h"
+#include "layer_store.h"
+#include "mesh.h"
+#include "slice_kernels.h"
+#include "stl_reader.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 런 파일에 그대로 기록되는 삼각형 레코드
+// 좌표는 메모리 내 경로와 같은 저장 타입(MeshScalar)으로 반올림해 결과를 일치시킨다.
+struct BandTriangle {
+    MeshScalar v[9];
+    uint64_t index;   // 원본 파일에서의 순서
+
+    double minZ() const {
+        return std::min(static_cast<double>(v[2]), std::min<double>(v[5], v[8]));
+    }
+    double maxZ() const {
+        return std::max(static_cast<double>(v[2]), std::max<double>(v[5], v[8]));
+    }
+    Triangle toTriangle() const {
+        return Triangle(Vector3(v[0], v[1], v[2]), Vector3(v[3], v[4], v[5]), Vector3(v[6], v[7], v[8]));
+    }
+};
+
+bool lessByMinZ(const BandTriangle& a, const BandTriangle& b) {
+    double za = a.minZ(), zb = b.minZ();
+    if (za != zb) return za < zb;
+    return a.index < b.index;
+}
+
+bool lessByIndex(const BandTriangle& a, const BandTriangle& b) {
+    return a.index < b.index;
+}
+
+struct FileCloser {
+    void operator()(FILE* file) const { if (file) std::fclose(file); }
+};
+using TempFile = std::unique_ptr<FILE, FileCloser>;
+
+// 정렬된 런 파일을 버퍼 단위로 읽는다
+class RunReader {
+public:
+    explicit RunReader(FILE* file) : file(file), buffer(kBufferRecords) {}
+
+    bool fill() {
+        pos = 0;
+        count = std::fread(buffer.data(), sizeof(BandTriangle), buffer.size(), file);
+        return count > 0;
+    }
+    const BandTriangle& peek() const { return buffer[pos]; }
+    bool advance() {
+        if (++pos < count) return true;
+        return fill();
+    }
+
+private:
+    static const size_t kBufferRecords = 4096;
+
+    FILE* file;
+    std::vector<BandTriangle> buffer;
+    size_t pos = 0;
+    size_t count = 0;
+};
+
+} // namespace
+
+bool StreamingSlicer::sliceFile(const std::string& stlPath, std::ostream& gcode) {
+    std::ifstream in(stlPath, std::ios::binary);
+    if (!in) {
+        lastError = "cannot open " + stlPath;
+        return false;
+    }
+    return slice(in, gcode);
+}
+
+bool StreamingSlicer::slice(std::istream& stl, std::ostream& gcode) {
+    SLICER_TRACE_SCOPE("stream_slice");
+    sliceStats = StreamingSliceStats();
+    lastError.clear();
+    auto fail = [this](const std::string& message) {
+        lastError = message;
+        return false;
+    };
+
+    StlReader reader(stl);
+    if (!reader.isValid()) return fail("not a valid STL file");
+
+    // 1단계: 읽으면서 바운딩 박스를 구하고 min-z 로 정렬된 런 파일을 만든다
+    std::vector<TempFile> runs;
+    std::vector<BandTriangle> chunk;
+    chunk.reserve(std::min<size_t>(options.runTriangles, 1 << 16));
+
+    auto flushRun = [&]() -> bool {
+        if (chunk.empty()) return true;
+        SLICER_TRACE_SCOPE_ARG("stream_write_run", "triangles", chunk.size());
+        std::sort(chunk.begin(), chunk.end(), lessByMinZ);
+        TempFile file(std::tmpfile());
+        if (!file) return fail("cannot create a temporary run file");
+        if (std::fwrite(chunk.data(), sizeof(BandTriangle), chunk.size(), file.get()) != chunk.size()) {
+            return fail("cannot write a temporary run file");
+        }
+        std::rewind(file.get());
+        runs.push_back(std::move(file));
+        chunk.clear();
+        return true;
+    };
+
+    MeshScalar minB[3] = {0, 0, 0}, maxB[3] = {0, 0, 0};
+    double tri[9];
+    uint64_t count = 0;
+    while (reader.next(tri)) {
+        BandTriangle record;
+        for (int i = 0; i < 9; i++) {
+            record.v[i] = static_cast<MeshScalar>(tri[i]);
+            if (!std::isfinite(record.v[i])) return fail("mesh has non-finite coordinates");
+        }
+        record.index = count;
+
+        for (int v = 0; v < 3; v++) {
+            for (int axis = 0; axis < 3; axis++) {
+                MeshScalar c = record.v[v * 3 + axis];
+                if (count == 0 && v == 0) {
+                    minB[axis] = maxB[axis] = c;
+                } else {
+                    minB[axis] = std::min(minB[axis], c);
+                    maxB[axis] = std::max(maxB[axis], c);
+                }
+            }
+        }
+
+        chunk.push_back(record);
+        count++;
+        if (chunk.size() >= options.runTriangles && !flushRun()) return false;
+    }
+    if (!flushRun()) return false;
+    std::vector<BandTriangle>().swap(chunk);
+
+    sliceStats.triangles = count;
+    sliceStats.runs = runs.size();
+    if (count == 0) return fail("no triangles read");
+
+    std::vector<double> bbox = {
+        static_cast<double>(minB[0]), static_cast<double>(minB[1]), static_cast<double>(minB[2]),
+        static_cast<double>(maxB[0]), static_cast<double>(maxB[1]), static_cast<double>(maxB[2])};
+    std::string rangeError;
+    if (!checkSliceRange(bbox, options.layerHeight, options.infillDensity, &rangeError)) return fail(rangeError);
+
+    // 2단계: 런 병합 + 레이어 스윕
+    std::vector<std::unique_ptr<RunReader>> readers;
+    auto heapLess = [](const RunReader* a, const RunReader* b) {
+        return lessByMinZ(b->peek(), a->peek());
+    };
+    std::priority_queue<RunReader*, std::vector<RunReader*>, decltype(heapLess)> heap(heapLess);
+    for (auto& run : runs) {
+        readers.emplace_back(new RunReader(run.get()));
+        if (readers.back()->fill()) heap.push(readers.back().get());
+    }
+
+    std::vector<BandTriangle> active;
+    std::vector<BandTriangle> arrivals;
+    std::vector<Vector3> intersections;
+    LayerStore layerStore;
+
+    GCodeWriter writer(gcode, options.layerHeight, options.infillDensity);
+    writer.begin();
+
+    double minZ = bbox[2];
+    double maxZ = bbox[5];
+    size_t layerIndex = 0;
+
+    // 메모리 내 경로와 같은 방식으로 z 를 누적해 레이어 높이를 맞춘다
+    for (double z = minZ; z <= maxZ; z += options.layerHeight) {
+        SLICER_TRACE_SCOPE_ARG("stream_layer", "index", layerIndex);
+        // 이번 레이어까지 시작한 삼각형을 band 에 추가 (band 는 원본 순서로 유지)
+        arrivals.clear();
+        while (!heap.empty() && heap.top()->peek().minZ() <= z) {
+            RunReader* run = heap.top();
+            heap.pop();
+            arrivals.push_back(run->peek());
+            if (run->advance()) heap.push(run);
+        }
+        if (!arrivals.empty()) {
+            std::sort(arrivals.begin(), arrivals.end(), lessByIndex);
+            size_t middle = active.size();
+            active.insert(active.end(), arrivals.begin(), arrivals.end());
+            std::inplace_merge(active.begin(), active.begin() + middle, active.end(), lessByIndex);
+        }
+
+        // 이미 지나간 삼각형 제거
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [z](const BandTriangle& t) { return t.maxZ() < z; }),
+                     active.end());
+        sliceStats.peakBandTriangles = std::max<uint64_t>(sliceStats.peakBandTriangles, active.size());
+
+        layerStore.clear();
+        layerStore.beginLayer(z);
+
+        intersections.clear();
+        for (const auto& t : active) {
+            if (triangleSpansZ(t.v[2], t.v[5], t.v[8], z)) {
+                intersections.push_back(calculateIntersection(t.toTriangle(), z));
+            }
+        }
+
+        if (!intersections.empty()) {
+            buildContours(intersections, layerStore.contours());
+            generateInfill(layerStore.infill(), bbox, options.infillDensity);
+        }
+
+        writer.writeLayer(layerIndex++, layerStore.layer(0));
+    }
+
+    writer.end();
+    sliceStats.layers = layerIndex;
+    return static_cast<bool>(gcode);
+}
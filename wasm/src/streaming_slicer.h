@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+// 메모리보다 큰 메시를 위한 외부 정렬 기반 슬라이서 (네이티브 전용)
+//
+// 1단계: STL 을 순차로 읽어 삼각형을 min-z 기준으로 정렬한 런(run) 파일에 나눠 쓴다.
+// 2단계: 런들을 병합하며 레이어를 아래에서 위로 훑고, 현재 레이어에 걸친 삼각형(band)만 메모리에 둔다.
+// 출력 G-code 는 SimpleSlicer 의 메모리 내 경로와 동일하다.
+struct StreamingSliceOptions {
+    double layerHeight = 0.2;
+    double infillDensity = 20.0;
+    size_t runTriangles = 1 << 20;   // 런 하나에 담을 삼각형 수 (1단계 메모리 상한)
+};
+
+struct StreamingSliceStats {
+    uint64_t triangles = 0;
+    uint64_t runs = 0;
+    uint64_t layers = 0;
+    uint64_t peakBandTriangles = 0;  // 동시에 메모리에 있던 최대 삼각형 수
+};
+
+class StreamingSlicer {
+public:
+    explicit StreamingSlicer(const StreamingSliceOptions& options) : options(options) {}
+
+    // STL 스트림을 슬라이스해 G-code 를 쓴다. 삼각형이 없거나, 좌표가 유한하지 않거나,
+    // 레이어 수가 상한을 넘거나, 임시 파일을 만들 수 없으면 false 이고 error() 에 이유.
+    bool slice(std::istream& stl, std::ostream& gcode);
+    bool sliceFile(const std::string& stlPath, std::ostream& gcode);
+
+    const StreamingSliceStats& stats() const { return sliceStats; }
+    const std::string& error() const { return lastError; }
+
+private:
+    StreamingSliceOptions options;
+    StreamingSliceStats sliceStats;
+    std::string lastError;
+};
@@ -0,0 +1,111 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace {
+
+// 작업자 스레드 안에서의 중첩 호출을 막는다 (같은 풀을 기다리면 교착)
+thread_local bool insideWorker = false;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+size_t ThreadPool::defaultThreadCount() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 1;
+#else
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+#endif
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    if (workers.empty() || count == 1 || insideWorker) {
+        for (size_t i = 0; i < count; i++) body(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch(dispatchMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobCount = count;
+        nextIndex = 0;
+        activeWorkers = workers.size();
+        error = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+
+    insideWorker = true;
+    runTasks();
+    insideWorker = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    job = nullptr;
+    if (error) {
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+// 남은 인덱스를 하나씩 가져가 실행 (작업 크기가 고르지 않아도 스레드가 쉬지 않도록)
+void ThreadPool::runTasks() {
+    for (;;) {
+        size_t index;
+        const std::function<void(size_t)>* body;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (nextIndex >= jobCount || error) return;
+            index = nextIndex++;
+            body = job;
+        }
+        try {
+            (*body)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    insideWorker = true;
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        done.notify_one();
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 고정 크기 작업자 풀 (parallelFor 전용)
+// 호출한 스레드도 작업을 나눠 받으며, 작업자 안에서 다시 부르면 그 자리에서 순차 실행한다.
+// 스레드가 하나뿐이거나 pthread 가 없는 wasm 빌드에서는 작업자를 만들지 않는다.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = defaultThreadCount());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 호출 스레드를 포함한 동시 실행 수
+    size_t size() const { return workers.size() + 1; }
+
+    // body(0) ~ body(count - 1) 을 나눠 실행하고 모두 끝날 때까지 기다린다.
+    // 예외는 첫 번째 것만 호출 스레드에서 다시 던진다.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // 프로세스 공용 풀
+    static ThreadPool& shared();
+    static size_t defaultThreadCount();
+
+private:
+    void workerLoop();
+    void runTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex dispatchMutex;  // parallelFor 호출을 하나씩만 받는다
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(size_t)>* job = nullptr;
+    size_t jobCount = 0;
+    size_t nextIndex = 0;
+    size_t activeWorkers = 0;
+    uint64_t generation = 0;
+    std::exception_ptr error;
+    bool stopping = false;
+};
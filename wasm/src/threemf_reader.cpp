@@ -0,0 +1,519 @@
+#include "threemf_reader.h"
+
+#include "thread_pool.h"
+#include "trace.h"
+#include "xml_pull_parser.h"
+#include "zip_reader.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// 빌드 항목/컴포넌트 변환 (3MF 행 벡터 규약: p' = p * M, 마지막 행이 이동)
+struct Transform3MF {
+    double m[12] = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+
+    bool isIdentity() const {
+        static const double identity[12] = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+        return std::memcmp(m, identity, sizeof(m)) == 0;
+    }
+
+    void apply(double x, double y, double z, double& ox, double& oy, double& oz) const {
+        ox = x * m[0] + y * m[3] + z * m[6] + m[9];
+        oy = x * m[1] + y * m[4] + z * m[7] + m[10];
+        oz = x * m[2] + y * m[5] + z * m[8] + m[11];
+    }
+
+    void scale(double factor) {
+        for (double& v : m) v *= factor;
+    }
+
+    // this 를 먼저, 그다음 outer 를 적용하는 변환 (컴포넌트 변환 → 부모 변환)
+    Transform3MF then(const Transform3MF& outer) const {
+        if (outer.isIdentity()) return *this;
+        if (isIdentity()) return outer;
+        Transform3MF result;
+        for (int row = 0; row < 4; row++) {
+            for (int col = 0; col < 3; col++) {
+                double v = m[row * 3] * outer.m[col] + m[row * 3 + 1] * outer.m[3 + col] +
+                           m[row * 3 + 2] * outer.m[6 + col];
+                result.m[row * 3 + col] = row == 3 ? v + outer.m[9 + col] : v;
+            }
+        }
+        return result;
+    }
+};
+
+// 메시 버퍼 안의 객체 범위
+struct ObjectRange {
+    size_t firstVertex = 0, vertexCount = 0;
+    size_t firstTriangle = 0, triangleCount = 0;
+};
+
+// 다른 객체 참조 (Production Extension 의 p:path 가 있으면 다른 모델 파트의 객체)
+struct Component {
+    std::string path;  // 비어 있으면 같은 파트
+    std::string id;
+    Transform3MF transform;
+};
+
+struct ObjectDef {
+    ObjectRange range;
+    std::vector<Component> components;
+};
+
+struct BuildItem {
+    std::string path;
+    std::string id;
+    Transform3MF transform;
+};
+
+// 모델 파트 하나 (루트 3dmodel.model 또는 3D/Objects/*.model) 의 파싱 결과
+struct ModelPart {
+    Mesh mesh;
+    std::unordered_map<std::string, ObjectDef> objects;
+    std::vector<std::string> objectOrder;
+    std::vector<BuildItem> items;
+    double scale = 1.0;
+    std::string error;
+};
+
+// 평탄화한 메시 인스턴스: 파트의 객체 메시 하나 + 누적 변환
+struct MeshInstance {
+    const ModelPart* part;
+    const ObjectRange* range;
+    Transform3MF transform;
+};
+
+const double kPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// 10진 실수 파싱. 유효 숫자 15자리 이하, 지수 22 이하이면 곱셈/나눗셈 한 번으로 정확하게
+// (strtod 와 같은 값) 구하고, 그 밖의 경우만 strtod 로 넘긴다.
+bool parseNumber(std::string_view text, double& out) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    if (p == end) return false;
+
+    const char* start = p;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+        }
+        p++;
+        any = true;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+            p++;
+            any = true;
+        }
+    }
+    if (!any) return false;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExp = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) p++;
+        int value = 0;
+        bool expDigits = false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (value < 100000) value = value * 10 + (*p - '0');
+            p++;
+            expDigits = true;
+        }
+        if (!expDigits) return false;
+        exponent += negativeExp ? -value : value;
+    }
+
+    if (digits <= 15 && exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / kPowersOf10[-exponent] : value * kPowersOf10[exponent];
+        out = negative ? -value : value;
+        return true;
+    }
+
+    std::string copy(start, static_cast<size_t>(p - start));
+    out = std::strtod(copy.c_str(), nullptr);
+    return true;
+}
+
+bool parseIndex(std::string_view text, uint64_t& out) {
+    if (text.empty()) return false;
+    uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    out = value;
+    return true;
+}
+
+bool parseTransform(std::string_view text, Transform3MF& transform) {
+    size_t pos = 0;
+    for (int i = 0; i < 12; i++) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) pos++;
+        size_t next = pos;
+        while (next < text.size() && text[next] != ' ' && text[next] != '\t' && text[next] != '\n' && text[next] != '\r') next++;
+        if (!parseNumber(text.substr(pos, next - pos), transform.m[i])) return false;
+        pos = next;
+    }
+    return true;
+}
+
+// <model unit="..."> → 밀리미터 배율
+double unitScale(std::string_view unit) {
+    if (unit == "micron") return 0.001;
+    if (unit == "centimeter") return 10.0;
+    if (unit == "inch") return 25.4;
+    if (unit == "foot") return 304.8;
+    if (unit == "meter") return 1000.0;
+    return 1.0;
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// 파트 이름 비교용 키 (OPC 파트 이름은 대소문자 구분 없음, 앞의 '/' 무시)
+std::string partKey(std::string_view name) {
+    while (!name.empty() && name.front() == '/') name.remove_prefix(1);
+    std::string key(name);
+    for (char& c : key) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return key;
+}
+
+// p:path 처럼 접두사가 붙는 속성을 지역 이름으로 찾기 (접두사는 파일마다 다를 수 있다)
+bool localAttribute(const XmlPullParser& xml, std::string_view localName, std::string_view& value) {
+    size_t cursor = 0;
+    std::string_view name;
+    while (xml.nextAttribute(cursor, name, value)) {
+        size_t colon = name.find(':');
+        if ((colon == std::string_view::npos ? name : name.substr(colon + 1)) == localName) return true;
+    }
+    return false;
+}
+
+// _rels/.rels 에서 3D 모델 관계의 대상 파트 찾기
+std::string findRootModelPart(const ZipArchive& zip) {
+    const char* fallback = "3D/3dmodel.model";
+    const ZipEntry* rels = zip.find("_rels/.rels");
+    ZipEntryData data;
+    if (!rels || !zip.read(*rels, data)) return fallback;
+
+    XmlPullParser xml(data.chars(), data.size());
+    for (XmlPullParser::Event event = xml.next(); event == XmlPullParser::Event::StartElement ||
+                                                  event == XmlPullParser::Event::EndElement;
+         event = xml.next()) {
+        if (event != XmlPullParser::Event::StartElement || xml.localName() != "Relationship") continue;
+        std::string_view type, target;
+        if (xml.attribute("Type", type) && xml.attribute("Target", target) &&
+            type.size() >= 8 && type.substr(type.size() - 8) == "/3dmodel") {
+            return std::string(target);
+        }
+    }
+    return fallback;
+}
+
+// 모델 파트를 읽어 객체별 메시를 part.mesh 뒤에 이어 붙이고, 컴포넌트와 빌드 항목을 모은다
+bool parseModel(const char* text, size_t size, ModelPart& part, std::string* error) {
+    Mesh& mesh = part.mesh;
+    XmlPullParser xml(text, size);
+    std::string objectId;
+    ObjectDef current;
+    bool inObject = false, inVertices = false, inTriangles = false;
+
+    for (;;) {
+        XmlPullParser::Event event = xml.next();
+        if (event == XmlPullParser::Event::End) break;
+        if (event == XmlPullParser::Event::Error) return fail(error, "malformed 3MF model XML");
+
+        std::string_view name = xml.localName();
+        if (event == XmlPullParser::Event::EndElement) {
+            if (name == "vertices") {
+                inVertices = false;
+            } else if (name == "triangles") {
+                inTriangles = false;
+            } else if (name == "object" && inObject) {
+                current.range.vertexCount = mesh.vertexCount() - current.range.firstVertex;
+                current.range.triangleCount = mesh.triangleCount() - current.range.firstTriangle;
+                if ((current.range.triangleCount > 0 || !current.components.empty()) &&
+                    part.objects.emplace(objectId, std::move(current)).second) {
+                    part.objectOrder.push_back(objectId);
+                }
+                inObject = false;
+            }
+            continue;
+        }
+
+        // 가장 많은 요소부터 검사
+        if (inVertices && name == "vertex") {
+            double xyz[3] = {0, 0, 0};
+            size_t cursor = 0;
+            std::string_view attr, value;
+            int found = 0;
+            while (xml.nextAttribute(cursor, attr, value)) {
+                if (attr.size() != 1 || attr[0] < 'x' || attr[0] > 'z') continue;
+                if (!parseNumber(value, xyz[attr[0] - 'x'])) return fail(error, "bad 3MF vertex coordinate");
+                found++;
+            }
+            if (found < 3) return fail(error, "3MF vertex is missing a coordinate");
+            if (mesh.vertexCount() >= Mesh::maxVertices()) return fail(error, "too many vertices for this build");
+            mesh.addVertex(xyz[0], xyz[1], xyz[2]);
+        } else if (inTriangles && name == "triangle") {
+            uint64_t v[3] = {0, 0, 0};
+            size_t cursor = 0;
+            std::string_view attr, value;
+            int found = 0;
+            while (xml.nextAttribute(cursor, attr, value)) {
+                if (attr.size() != 2 || attr[0] != 'v' || attr[1] < '1' || attr[1] > '3') continue;
+                if (!parseIndex(value, v[attr[1] - '1'])) return fail(error, "bad 3MF triangle index");
+                found++;
+            }
+            size_t objectVertices = mesh.vertexCount() - current.range.firstVertex;
+            if (found < 3 || v[0] >= objectVertices || v[1] >= objectVertices || v[2] >= objectVertices) {
+                return fail(error, "3MF triangle index out of range");
+            }
+            mesh.addTriangle(static_cast<MeshIndex>(current.range.firstVertex + v[0]),
+                             static_cast<MeshIndex>(current.range.firstVertex + v[1]),
+                             static_cast<MeshIndex>(current.range.firstVertex + v[2]));
+        } else if (name == "vertices") {
+            inVertices = inObject;
+        } else if (name == "triangles") {
+            inTriangles = inObject;
+        } else if (name == "object") {
+            std::string_view id;
+            xml.attribute("id", id);
+            objectId.assign(id.data(), id.size());
+            current = ObjectDef();
+            current.range.firstVertex = mesh.vertexCount();
+            current.range.firstTriangle = mesh.triangleCount();
+            inObject = true;
+        } else if (inObject && name == "component") {
+            Component component;
+            std::string_view id, path, transform;
+            if (!xml.attribute("objectid", id)) return fail(error, "3MF component without objectid");
+            component.id.assign(id.data(), id.size());
+            if (localAttribute(xml, "path", path)) component.path = partKey(path);
+            if (xml.attribute("transform", transform) && !parseTransform(transform, component.transform)) {
+                return fail(error, "bad 3MF component transform");
+            }
+            current.components.push_back(std::move(component));
+        } else if (name == "item") {
+            BuildItem item;
+            std::string_view id, path, transform;
+            if (!xml.attribute("objectid", id)) return fail(error, "3MF build item without objectid");
+            item.id.assign(id.data(), id.size());
+            if (localAttribute(xml, "path", path)) item.path = partKey(path);
+            if (xml.attribute("transform", transform) && !parseTransform(transform, item.transform)) {
+                return fail(error, "bad 3MF build item transform");
+            }
+            part.items.push_back(std::move(item));
+        } else if (name == "model") {
+            std::string_view unit;
+            if (xml.attribute("unit", unit)) part.scale = unitScale(unit);
+        }
+    }
+    return true;
+}
+
+// 컴포넌트 펼치기 상한. 두 컴포넌트가 같은 객체를 가리키는 객체를 몇 단만 쌓아도 인스턴스가
+// 2^깊이 로 늘어나므로 (수백 바이트짜리 파일로 힙 고갈), 펼치는 동안 수를 세어 넘으면 실패한다.
+const int kMaxComponentDepth = 32;             // 재귀 깊이 (스택 보호)
+const size_t kMaxComponentVisits = 1 << 16;    // 방문하는 객체 수 (빈 객체 포함)
+const size_t kMaxExpandedTriangles = 1 << 28;  // 펼친 삼각형 수
+
+// 펼치는 동안의 누적 수와 진행 중인 객체 (순환 참조 검출)
+struct Expansion {
+    std::vector<MeshInstance> instances;
+    std::unordered_set<const ObjectDef*> inProgress;
+    size_t visits = 0;
+    size_t vertices = 0;
+    size_t triangles = 0;
+};
+
+// 객체 하나를 메시 인스턴스로 펼친다 (컴포넌트는 변환을 누적하며 재귀)
+bool expandObject(const std::unordered_map<std::string, const ModelPart*>& parts, const ModelPart& part,
+                  const std::string& path, const std::string& id, const Transform3MF& transform, int depth,
+                  Expansion& expansion, std::string* error) {
+    const ModelPart* owner = &part;
+    if (!path.empty()) {
+        auto found = parts.find(path);
+        if (found == parts.end()) return fail(error, "3MF reference to unknown model part " + path);
+        owner = found->second;
+    }
+    auto object = owner->objects.find(id);
+    if (object == owner->objects.end()) return fail(error, "3MF reference to unknown object " + id);
+    const ObjectDef& def = object->second;
+    if (expansion.inProgress.count(&def)) return fail(error, "3MF component cycle through object " + id);
+    if (depth > kMaxComponentDepth) return fail(error, "3MF components are nested too deeply");
+    if (++expansion.visits > kMaxComponentVisits) return fail(error, "3MF expands to too many component instances");
+
+    if (def.range.triangleCount > 0) {
+        expansion.vertices += def.range.vertexCount;
+        expansion.triangles += def.range.triangleCount;
+        if (expansion.vertices > Mesh::maxVertices()) return fail(error, "too many vertices for this build");
+        if (expansion.triangles > kMaxExpandedTriangles) return fail(error, "3MF expands to too many triangles");
+        expansion.instances.push_back({owner, &def.range, transform});
+    }
+    expansion.inProgress.insert(&def);
+    for (const Component& component : def.components) {
+        if (!expandObject(parts, *owner, component.path, component.id, component.transform.then(transform), depth + 1,
+                          expansion, error)) {
+            return false;
+        }
+    }
+    expansion.inProgress.erase(&def);
+    return true;
+}
+
+} // namespace
+
+bool isZipArchive(const unsigned char* data, size_t size) {
+    return size >= 4 && data[0] == 'P' && data[1] == 'K' && data[2] == 3 && data[3] == 4;
+}
+
+bool load3MF(const unsigned char* data, size_t size, Mesh& mesh, std::string* error, ThreadPool* pool) {
+    mesh.clear();
+
+    ZipArchive zip;
+    if (!zip.open(data, size, error)) return false;
+
+    std::string rootPart = findRootModelPart(zip);
+    const ZipEntry* model = zip.find(rootPart);
+    if (!model) return fail(error, "3MF model part not found: " + rootPart);
+
+    ZipEntryData modelData;
+    if (!zip.read(*model, modelData, error)) return false;
+
+    // 객체 메시는 파일 순서대로 파트 메시에 바로 쓴다
+    ModelPart root;
+    if (!parseModel(modelData.chars(), modelData.size(), root, error)) return false;
+
+    // Production Extension: 루트가 p:path 로 참조하는 모델 파트 (3D/Objects/*.model) 를 모아
+    // 풀 스레드에서 동시에 풀고 파싱한다. 파트마다 메시와 오류를 따로 가지므로 잠금이 없다.
+    std::string rootKey = partKey(rootPart);
+    std::vector<std::string> subPartNames;
+    std::unordered_map<std::string, size_t> subPartIndex;
+    auto reference = [&](const std::string& path) {
+        if (!path.empty() && path != rootKey && subPartIndex.emplace(path, subPartNames.size()).second) {
+            subPartNames.push_back(path);
+        }
+    };
+    for (const BuildItem& item : root.items) reference(item.path);
+    for (const std::string& id : root.objectOrder) {
+        for (const Component& component : root.objects[id].components) reference(component.path);
+    }
+
+    std::vector<ModelPart> subParts(subPartNames.size());
+    auto parsePart = [&](size_t i) {
+        ModelPart& part = subParts[i];
+        const ZipEntry* entry = zip.find(subPartNames[i]);
+        if (!entry) {
+            part.error = "3MF model part not found: " + subPartNames[i];
+            return;
+        }
+        SLICER_TRACE_SCOPE_ARG("parse_3mf_part", "bytes", entry->uncompressedSize);
+        ZipEntryData partData;
+        if (zip.read(*entry, partData, &part.error)) parseModel(partData.chars(), partData.size(), part, &part.error);
+    };
+    if (pool && subParts.size() > 1) {
+        pool->parallelFor(subParts.size(), parsePart);
+    } else {
+        for (size_t i = 0; i < subParts.size(); i++) parsePart(i);
+    }
+    for (const ModelPart& part : subParts) {
+        if (!part.error.empty()) return fail(error, part.error);
+    }
+
+    std::unordered_map<std::string, const ModelPart*> parts;
+    parts[rootKey] = &root;
+    for (size_t i = 0; i < subParts.size(); i++) parts[subPartNames[i]] = &subParts[i];
+
+    // 빌드 항목이 없으면 루트의 모든 객체를 그대로 쓴다
+    if (root.items.empty()) {
+        for (const std::string& id : root.objectOrder) root.items.push_back({std::string(), id, Transform3MF()});
+    }
+
+    // 빌드 항목 → 메시 인스턴스 (항목 변환과 단위는 컴포넌트 변환 바깥에 적용)
+    Expansion expansion;
+    for (BuildItem& item : root.items) {
+        item.transform.scale(root.scale);
+        if (!expandObject(parts, root, item.path, item.id, item.transform, 0, expansion, error)) return false;
+    }
+    const std::vector<MeshInstance>& instances = expansion.instances;
+
+    // 파트가 하나이고 모든 객체 메시가 정확히 한 번씩만 쓰이면 (가장 흔한 경우) 제자리에서 변환만 적용
+    bool inPlace = subParts.empty();
+    if (inPlace) {
+        size_t meshObjects = 0;
+        for (const auto& object : root.objects) meshObjects += object.second.range.triangleCount > 0 ? 1 : 0;
+        std::unordered_set<const ObjectRange*> used;
+        for (const MeshInstance& instance : instances) inPlace = inPlace && used.insert(instance.range).second;
+        inPlace = inPlace && used.size() == meshObjects;
+    }
+
+    if (inPlace) {
+        for (const MeshInstance& instance : instances) {
+            if (instance.transform.isIdentity()) continue;
+            const ObjectRange& range = *instance.range;
+            for (size_t v = range.firstVertex; v < range.firstVertex + range.vertexCount; v++) {
+                Vector3 p = root.mesh.vertex(v);
+                double x, y, z;
+                instance.transform.apply(p.x, p.y, p.z, x, y, z);
+                root.mesh.setVertex(v, x, y, z);
+            }
+        }
+        mesh = std::move(root.mesh);
+    } else {
+        // 같은 객체를 여러 번 배치했거나, 쓰지 않는 객체나 다른 파트의 객체가 있으면 인스턴스 순서대로 다시 조립
+        // 정점/삼각형 수는 펼치면서 상한 안으로 확인했다
+        mesh.reserve(expansion.vertices, expansion.triangles);
+        for (const MeshInstance& instance : instances) {
+            const ObjectRange& range = *instance.range;
+            const Mesh& source = instance.part->mesh;
+            const MeshIndex* indices = source.indexData();
+            size_t base = mesh.vertexCount();
+            for (size_t v = range.firstVertex; v < range.firstVertex + range.vertexCount; v++) {
+                Vector3 p = source.vertex(v);
+                double x, y, z;
+                instance.transform.apply(p.x, p.y, p.z, x, y, z);
+                mesh.addVertex(x, y, z);
+            }
+            for (size_t t = range.firstTriangle; t < range.firstTriangle + range.triangleCount; t++) {
+                const MeshIndex* tri = indices + t * 3;
+                mesh.addTriangle(static_cast<MeshIndex>(base + tri[0] - range.firstVertex),
+                                 static_cast<MeshIndex>(base + tri[1] - range.firstVertex),
+                                 static_cast<MeshIndex>(base + tri[2] - range.firstVertex));
+            }
+        }
+    }
+
+    if (mesh.empty()) return fail(error, "3MF contains no triangles");
+    return true;
+}
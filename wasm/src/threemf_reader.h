@@ -0,0 +1,21 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <cstddef>
+#include <string>
+
+class ThreadPool;
+
+// zip 로컬 헤더 서명("PK\3\4") 으로 시작하는지 (3MF 와 STL 구분)
+bool isZipArchive(const unsigned char* data, size_t size);
+
+// 3MF 패키지의 빌드 항목을 하나의 인덱스 메시로 읽는다
+// 루트 모델 파트(_rels/.rels 의 3dmodel 관계, 없으면 3D/3dmodel.model) 의 <vertex>/<triangle> 을
+// 복사 없는 풀 파서로 읽어 메시 버퍼에 바로 쓰고, 빌드 항목의 변환 행렬과 단위(unit) 를 적용한다.
+// Production Extension 파일(Bambu/Orca 프로젝트) 은 루트의 컴포넌트가 p:path 로 가리키는 모델 파트
+// (3D/Objects/*.model) 를 pool 에서 동시에 풀고 파싱한 뒤, 컴포넌트 변환을 누적해 인스턴스마다 펼친다.
+// pool 이 nullptr 이면 순차 실행. 출력은 스레드 수와 관계없이 같다.
+// 버퍼는 읽는 동안만 유효하면 된다. 삼각형이 하나도 없거나 형식이 잘못되면 false.
+bool load3MF(const unsigned char* data, size_t size, Mesh& mesh, std::string* error = nullptr,
+             ThreadPool* pool = nullptr);
@@ -0,0 +1,74 @@
+#include "trace.h"
+
+#include <atomic>
+#include <cstdio>
+
+TraceRecorder& TraceRecorder::global() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+uint32_t TraceRecorder::threadId() {
+    static std::atomic<uint32_t> next{1};
+    thread_local uint32_t id = next.fetch_add(1);
+    return id;
+}
+
+void TraceRecorder::record(const char* name, double start, double end, const char* argName, double argValue) {
+    uint32_t thread = threadId();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (events.size() >= kMaxEvents) {
+        dropped++;
+        return;
+    }
+    events.push_back({name, argName, argValue, start, end - start, thread});
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    dropped = 0;
+}
+
+size_t TraceRecorder::eventCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+size_t TraceRecorder::droppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+std::string TraceRecorder::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::string json;
+    json.reserve(64 + events.size() * 112);
+    json += "{\"traceEvents\":[";
+
+    char buffer[96];
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& e = events[i];
+        if (i > 0) json += ',';
+        // 이름은 코드 안의 정적 식별자라 이스케이프가 필요 없다
+        json += "\n{\"name\":\"";
+        json += e.name;
+        json += "\",\"cat\":\"slicer\",\"ph\":\"X\",\"pid\":1,";
+        std::snprintf(buffer, sizeof(buffer), "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                      e.thread, e.start, e.duration);
+        json += buffer;
+        if (e.argName) {
+            json += ",\"args\":{\"";
+            json += e.argName;
+            std::snprintf(buffer, sizeof(buffer), "\":%.17g}", e.argValue);
+            json += buffer;
+        }
+        json += '}';
+    }
+
+    json += "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":";
+    json += std::to_string(dropped);
+    json += "}}";
+    return json;
+}
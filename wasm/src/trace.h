@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Chrome Trace Event 형식의 단계별 타이밍 기록 (Perfetto / chrome://tracing 에서 열기)
+//
+// SLICER_TRACE 로 빌드할 때만 SLICER_TRACE_SCOPE 가 코드를 만든다. 끄면 매크로가 비어
+// 측정 비용이 전혀 없고, 기록기는 빈 트레이스만 돌려준다.
+//
+//   SLICER_TRACE_SCOPE("slice");
+//   SLICER_TRACE_SCOPE_ARG("layer", "index", i);
+
+struct TraceEvent {
+    const char* name;      // 정적 문자열만 (복사하지 않는다)
+    const char* argName;   // 없으면 nullptr
+    double argValue;
+    double start;          // 기록 시작 기준 마이크로초
+    double duration;
+    uint32_t thread;
+};
+
+class TraceRecorder {
+public:
+    // 이 이상은 버리고 dropped 로만 센다 (브라우저에서 오래 켜 둬도 메모리가 늘지 않게)
+    static const size_t kMaxEvents = 1 << 20;
+
+    static TraceRecorder& global();
+
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    double now() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    void record(const char* name, double start, double end, const char* argName = nullptr, double argValue = 0);
+    void clear();
+
+    size_t eventCount() const;
+    size_t droppedCount() const;
+
+    // {"traceEvents": [...]} JSON
+    std::string toJson() const;
+
+    // 현재 스레드의 작은 정수 id (트레이스 tid)
+    static uint32_t threadId();
+
+private:
+    TraceRecorder() : epoch(std::chrono::steady_clock::now()) {}
+
+    std::chrono::steady_clock::time_point epoch;
+    bool enabled = true;
+    mutable std::mutex mutex;
+    std::vector<TraceEvent> events;
+    size_t dropped = 0;
+};
+
+// 생성~소멸 구간을 완료 이벤트("ph": "X") 하나로 기록
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* argName = nullptr, double argValue = 0)
+        : name(name), argName(argName), argValue(argValue) {
+        TraceRecorder& recorder = TraceRecorder::global();
+        active = recorder.isEnabled();
+        if (active) start = recorder.now();
+    }
+
+    ~TraceScope() {
+        if (!active) return;
+        TraceRecorder& recorder = TraceRecorder::global();
+        recorder.record(name, start, recorder.now(), argName, argValue);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* argName;
+    double argValue;
+    double start = 0;
+    bool active = false;
+};
+
+#define SLICER_TRACE_CONCAT_INNER(a, b) a##b
+#define SLICER_TRACE_CONCAT(a, b) SLICER_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SLICER_TRACE
+#define SLICER_TRACE_SCOPE(name) TraceScope SLICER_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define SLICER_TRACE_SCOPE_ARG(name, argName, argValue) \
+    TraceScope SLICER_TRACE_CONCAT(traceScope_, __LINE__)(name, argName, static_cast<double>(argValue))
+#else
+#define SLICER_TRACE_SCOPE(name) ((void)0)
+#define SLICER_TRACE_SCOPE_ARG(name, argName, argValue) ((void)0)
+#endif
@@ -0,0 +1,152 @@
+#include "xml_pull_parser.h"
+
+#include <cstring>
+
+namespace {
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+inline bool isNameEnd(char c) { return isSpace(c) || c == '>' || c == '/' || c == '='; }
+
+// [p, end) 에서 needle 을 찾아 그 시작 위치, 없으면 end
+const char* findSequence(const char* p, const char* end, const char* needle) {
+    size_t length = std::strlen(needle);
+    while (end - p >= static_cast<ptrdiff_t>(length)) {
+        const char* hit = static_cast<const char*>(std::memchr(p, needle[0], end - p - length + 1));
+        if (!hit) return end;
+        if (std::memcmp(hit, needle, length) == 0) return hit;
+        p = hit + 1;
+    }
+    return end;
+}
+
+} // namespace
+
+std::string_view XmlPullParser::localName() const {
+    size_t colon = elementName.find(':');
+    return colon == std::string_view::npos ? elementName : elementName.substr(colon + 1);
+}
+
+// '<' 위치에서 주석/처리 명령/CDATA/DOCTYPE 을 건너뛰었으면 true
+bool XmlPullParser::skipSpecial() {
+    const char* close = nullptr;
+    if (end - pos >= 4 && std::memcmp(pos, "<!--", 4) == 0) {
+        close = findSequence(pos + 4, end, "-->");
+        pos = close == end ? end : close + 3;
+    } else if (end - pos >= 2 && pos[1] == '?') {
+        close = findSequence(pos + 2, end, "?>");
+        pos = close == end ? end : close + 2;
+    } else if (end - pos >= 9 && std::memcmp(pos, "<![CDATA[", 9) == 0) {
+        close = findSequence(pos + 9, end, "]]>");
+        pos = close == end ? end : close + 3;
+    } else if (end - pos >= 2 && pos[1] == '!') {
+        // DOCTYPE: 내부 서브셋의 [...] 안의 '>' 는 건너뛴다
+        int depth = 0;
+        const char* p = pos + 2;
+        for (; p < end; p++) {
+            if (*p == '[') depth++;
+            else if (*p == ']') depth--;
+            else if (*p == '>' && depth <= 0) break;
+        }
+        pos = p == end ? end : p + 1;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+XmlPullParser::Event XmlPullParser::next() {
+    if (failed) return Event::Error;
+    if (pendingEnd) {
+        pendingEnd = false;
+        emptyElement = false;
+        attributesBegin = attributesEnd = nullptr;
+        return Event::EndElement;
+    }
+
+    for (;;) {
+        // 텍스트는 건너뛴다
+        const char* open = static_cast<const char*>(std::memchr(pos, '<', end - pos));
+        if (!open) {
+            pos = end;
+            return Event::End;
+        }
+        pos = open;
+        if (skipSpecial()) continue;
+        break;
+    }
+
+    bool closing = end - pos >= 2 && pos[1] == '/';
+    const char* nameBegin = pos + (closing ? 2 : 1);
+    const char* p = nameBegin;
+    while (p < end && !isNameEnd(*p)) p++;
+    if (p == nameBegin || p == end) {
+        failed = true;
+        return Event::Error;
+    }
+    elementName = std::string_view(nameBegin, static_cast<size_t>(p - nameBegin));
+
+    // 태그 끝 '>' 찾기 (따옴표 안의 '>' 는 무시)
+    const char* attrs = p;
+    char quote = 0;
+    for (; p < end; p++) {
+        char c = *p;
+        if (quote) {
+            if (c == quote) quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            break;
+        }
+    }
+    if (p == end) {
+        failed = true;
+        return Event::Error;
+    }
+    pos = p + 1;
+
+    if (closing) {
+        emptyElement = false;
+        attributesBegin = attributesEnd = nullptr;
+        return Event::EndElement;
+    }
+
+    emptyElement = p > attrs && p[-1] == '/';
+    attributesBegin = attrs;
+    attributesEnd = emptyElement ? p - 1 : p;
+    pendingEnd = emptyElement;
+    return Event::StartElement;
+}
+
+bool XmlPullParser::nextAttribute(size_t& cursor, std::string_view& attributeName, std::string_view& value) const {
+    if (!attributesBegin) return false;
+    const char* p = attributesBegin + cursor;
+    while (p < attributesEnd && isSpace(*p)) p++;
+    if (p >= attributesEnd) return false;
+
+    const char* nameBegin = p;
+    while (p < attributesEnd && !isNameEnd(*p)) p++;
+    attributeName = std::string_view(nameBegin, static_cast<size_t>(p - nameBegin));
+    while (p < attributesEnd && isSpace(*p)) p++;
+    if (p >= attributesEnd || *p != '=') return false;
+    p++;
+    while (p < attributesEnd && isSpace(*p)) p++;
+    if (p >= attributesEnd || (*p != '"' && *p != '\'')) return false;
+
+    char quote = *p++;
+    const char* valueBegin = p;
+    const char* valueEnd = static_cast<const char*>(std::memchr(p, quote, attributesEnd - p));
+    if (!valueEnd) return false;
+    value = std::string_view(valueBegin, static_cast<size_t>(valueEnd - valueBegin));
+    cursor = static_cast<size_t>(valueEnd + 1 - attributesBegin);
+    return true;
+}
+
+bool XmlPullParser::attribute(std::string_view attributeName, std::string_view& value) const {
+    size_t cursor = 0;
+    std::string_view candidate;
+    while (nextAttribute(cursor, candidate, value)) {
+        if (candidate == attributeName) return true;
+    }
+    return false;
+}
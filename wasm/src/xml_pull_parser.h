@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// 복사 없는 XML 풀 파서 (3MF 모델 파일용)
+// 입력 버퍼 위의 string_view 만 돌려주므로 버퍼가 파서보다 오래 살아 있어야 한다.
+// 요소 시작/끝만 보고하며 텍스트, 주석, 처리 명령, CDATA, DOCTYPE 은 건너뛴다.
+// 속성 값의 엔티티(&amp; 등)는 풀지 않는다 (3MF 의 숫자/ID 속성에는 필요 없음).
+class XmlPullParser {
+public:
+    enum class Event {
+        StartElement,
+        EndElement,
+        End,    // 입력 끝
+        Error   // 형식 오류 (이후 호출도 Error)
+    };
+
+    XmlPullParser(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    Event next();
+
+    // 현재 요소 이름 (접두사 포함, 예: "p:component")
+    std::string_view name() const { return elementName; }
+
+    // 접두사를 뺀 이름
+    std::string_view localName() const;
+
+    // 빈 요소(<a/>) 면 StartElement 다음 next() 가 같은 이름의 EndElement 를 돌려준다
+    bool isEmptyElement() const { return emptyElement; }
+
+    // 현재 시작 요소의 속성 (이름은 접두사 포함으로 비교). 없으면 false.
+    bool attribute(std::string_view attributeName, std::string_view& value) const;
+
+    // 속성을 순서대로 훑기: 처음에는 cursor = 0, 끝나면 false
+    bool nextAttribute(size_t& cursor, std::string_view& attributeName, std::string_view& value) const;
+
+    // 입력에서 현재 위치 (진행률 보고용)
+    const char* position() const { return pos; }
+
+private:
+    bool skipSpecial();
+
+    const char* pos;
+    const char* end;
+    std::string_view elementName;
+    const char* attributesBegin = nullptr;
+    const char* attributesEnd = nullptr;
+    bool emptyElement = false;
+    bool pendingEnd = false;
+    bool failed = false;
+};
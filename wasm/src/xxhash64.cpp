@@ -0,0 +1,130 @@
+#include "xxhash64.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// 리틀 엔디언 읽기 (wasm, x86, ARM 모두 리틀 엔디언)
+inline uint64_t read64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t xxRound(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    acc = rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t lane) {
+    acc ^= xxRound(0, lane);
+    return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+XXHash64::XXHash64(uint64_t seed) : seed(seed) {
+    lanes[0] = seed + kPrime1 + kPrime2;
+    lanes[1] = seed + kPrime2;
+    lanes[2] = seed;
+    lanes[3] = seed - kPrime1;
+}
+
+void XXHash64::update(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    totalSize += size;
+
+    // 이전 호출에서 남은 32바이트 블록 채우기
+    if (buffered > 0) {
+        size_t take = std::min(size, sizeof(buffer) - buffered);
+        std::memcpy(buffer + buffered, p, take);
+        buffered += take;
+        p += take;
+        if (buffered < sizeof(buffer)) return;
+        for (int i = 0; i < 4; i++) lanes[i] = xxRound(lanes[i], read64(buffer + i * 8));
+        buffered = 0;
+    }
+
+    // 본체: 32바이트씩 4개 레인
+    while (end - p >= 32) {
+        lanes[0] = xxRound(lanes[0], read64(p));
+        lanes[1] = xxRound(lanes[1], read64(p + 8));
+        lanes[2] = xxRound(lanes[2], read64(p + 16));
+        lanes[3] = xxRound(lanes[3], read64(p + 24));
+        p += 32;
+    }
+
+    if (p < end) {
+        buffered = static_cast<size_t>(end - p);
+        std::memcpy(buffer, p, buffered);
+    }
+}
+
+uint64_t XXHash64::digest() const {
+    uint64_t h;
+    if (totalSize >= 32) {
+        h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        for (int i = 0; i < 4; i++) h = mergeRound(h, lanes[i]);
+    } else {
+        h = seed + kPrime5;
+    }
+    h += totalSize;
+
+    const unsigned char* p = buffer;
+    const unsigned char* end = buffer + buffered;
+    while (end - p >= 8) {
+        h ^= xxRound(0, read64(p));
+        h = rotl(h, 27) * kPrime1 + kPrime4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+        h = rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= static_cast<uint64_t>(*p) * kPrime5;
+        h = rotl(h, 11) * kPrime1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t xxHash64(const void* data, size_t size, uint64_t seed) {
+    XXHash64 hash(seed);
+    hash.update(data, size);
+    return hash.digest();
+}
+
+std::string toHex64(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        hex[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return hex;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// xxHash64 (XXH64 과 같은 값). 메시/설정 해시, 슬라이스 캐시 키용 (암호학적 해시 아님)
+class XXHash64 {
+public:
+    explicit XXHash64(uint64_t seed = 0);
+
+    void update(const void* data, size_t size);
+    uint64_t digest() const;
+
+private:
+    uint64_t seed;
+    uint64_t lanes[4];
+    unsigned char buffer[32];
+    size_t buffered = 0;
+    uint64_t totalSize = 0;
+};
+
+uint64_t xxHash64(const void* data, size_t size, uint64_t seed = 0);
+
+// 16자리 소문자 16진수
+std::string toHex64(uint64_t value);
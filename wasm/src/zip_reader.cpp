@@ -0,0 +1,179 @@
+#include "zip_reader.h"
+
+#include "deflate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace {
+
+const uint32_t kLocalHeaderSignature = 0x04034b50;
+const uint32_t kCentralHeaderSignature = 0x02014b50;
+const uint32_t kEndOfCentralDirSignature = 0x06054b50;
+const uint32_t kZip64EndSignature = 0x06064b50;
+const uint32_t kZip64LocatorSignature = 0x07064b50;
+
+const size_t kLocalHeaderSize = 30;
+const size_t kCentralHeaderSize = 46;
+const size_t kEndOfCentralDirSize = 22;
+
+uint16_t readUint16LE(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readUint32LE(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readUint64LE(const unsigned char* p) {
+    return static_cast<uint64_t>(readUint32LE(p)) | (static_cast<uint64_t>(readUint32LE(p + 4)) << 32);
+}
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+// OPC 파트 이름 비교 (대소문자 무시, 앞의 '/' 무시)
+std::string normalizePartName(const std::string& name) {
+    size_t start = 0;
+    while (start < name.size() && name[start] == '/') start++;
+    std::string normalized = name.substr(start);
+    for (char& c : normalized) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return normalized;
+}
+
+} // namespace
+
+bool ZipArchive::open(const unsigned char* data, size_t size, std::string* error) {
+    archive = data;
+    archiveSize = size;
+    entryList.clear();
+
+    if (size < kEndOfCentralDirSize) return fail(error, "not a zip archive");
+
+    // 끝에서부터 EOCD 찾기 (주석은 최대 64KB)
+    size_t searchEnd = size >= kEndOfCentralDirSize + 0xFFFF ? size - kEndOfCentralDirSize - 0xFFFF : 0;
+    size_t eocd = std::numeric_limits<size_t>::max();
+    for (size_t pos = size - kEndOfCentralDirSize + 1; pos-- > searchEnd;) {
+        if (readUint32LE(data + pos) == kEndOfCentralDirSignature) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (eocd == std::numeric_limits<size_t>::max()) return fail(error, "zip end of central directory not found");
+
+    uint64_t entryCount = readUint16LE(data + eocd + 10);
+    uint64_t directorySize = readUint32LE(data + eocd + 12);
+    uint64_t directoryOffset = readUint32LE(data + eocd + 16);
+
+    // ZIP64: EOCD 바로 앞의 로케이터가 ZIP64 EOCD 를 가리킨다
+    if (eocd >= 20 && readUint32LE(data + eocd - 20) == kZip64LocatorSignature) {
+        uint64_t zip64Offset = readUint64LE(data + eocd - 20 + 8);
+        if (zip64Offset + 56 > size || readUint32LE(data + zip64Offset) != kZip64EndSignature) {
+            return fail(error, "bad zip64 end of central directory");
+        }
+        entryCount = readUint64LE(data + zip64Offset + 32);
+        directorySize = readUint64LE(data + zip64Offset + 40);
+        directoryOffset = readUint64LE(data + zip64Offset + 48);
+    }
+    if (directoryOffset > size || directorySize > size - directoryOffset) {
+        return fail(error, "zip central directory out of range");
+    }
+
+    entryList.reserve(static_cast<size_t>(std::min<uint64_t>(entryCount, directorySize / kCentralHeaderSize)));
+    const unsigned char* p = data + directoryOffset;
+    const unsigned char* end = p + directorySize;
+    while (p + kCentralHeaderSize <= end && readUint32LE(p) == kCentralHeaderSignature) {
+        uint16_t nameLength = readUint16LE(p + 28);
+        uint16_t extraLength = readUint16LE(p + 30);
+        uint16_t commentLength = readUint16LE(p + 32);
+        if (p + kCentralHeaderSize + nameLength + extraLength + commentLength > end) break;
+
+        ZipEntry entry;
+        entry.method = readUint16LE(p + 10);
+        entry.crc32 = readUint32LE(p + 16);
+        entry.compressedSize = readUint32LE(p + 20);
+        entry.uncompressedSize = readUint32LE(p + 24);
+        entry.localHeaderOffset = readUint32LE(p + 42);
+        entry.name.assign(reinterpret_cast<const char*>(p + kCentralHeaderSize), nameLength);
+
+        // ZIP64 확장 필드: 0xFFFFFFFF 인 값만 순서대로 들어 있다
+        const unsigned char* extra = p + kCentralHeaderSize + nameLength;
+        const unsigned char* extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            uint16_t id = readUint16LE(extra);
+            uint16_t length = readUint16LE(extra + 2);
+            const unsigned char* field = extra + 4;
+            const unsigned char* fieldEnd = std::min(field + length, extraEnd);
+            if (id == 0x0001) {
+                auto take = [&](uint64_t& value) {
+                    if (value == 0xFFFFFFFFu && field + 8 <= fieldEnd) {
+                        value = readUint64LE(field);
+                        field += 8;
+                    }
+                };
+                take(entry.uncompressedSize);
+                take(entry.compressedSize);
+                take(entry.localHeaderOffset);
+            }
+            extra += 4 + length;
+        }
+
+        entryList.push_back(std::move(entry));
+        p += kCentralHeaderSize + nameLength + extraLength + commentLength;
+    }
+
+    if (entryList.empty() && entryCount > 0) return fail(error, "bad zip central directory");
+    return true;
+}
+
+const ZipEntry* ZipArchive::find(const std::string& name) const {
+    std::string wanted = normalizePartName(name);
+    for (const ZipEntry& entry : entryList) {
+        if (normalizePartName(entry.name) == wanted) return &entry;
+    }
+    return nullptr;
+}
+
+bool ZipArchive::read(const ZipEntry& entry, ZipEntryData& out, std::string* error) const {
+    out.owned.clear();
+    out.bytes = nullptr;
+    out.length = 0;
+
+    // 로컬 헤더의 이름/확장 필드 길이는 중앙 디렉터리와 다를 수 있다
+    uint64_t offset = entry.localHeaderOffset;
+    if (offset > archiveSize || archiveSize - offset < kLocalHeaderSize ||
+        readUint32LE(archive + offset) != kLocalHeaderSignature) {
+        return fail(error, "bad zip local header");
+    }
+    uint64_t dataOffset = offset + kLocalHeaderSize + readUint16LE(archive + offset + 26) +
+                          readUint16LE(archive + offset + 28);
+    if (dataOffset > archiveSize || entry.compressedSize > archiveSize - dataOffset) {
+        return fail(error, "zip entry out of range");
+    }
+    const unsigned char* compressed = archive + dataOffset;
+
+    if (entry.method == 0) {
+        if (entry.compressedSize != entry.uncompressedSize) return fail(error, "bad stored zip entry");
+        out.bytes = compressed;
+        out.length = static_cast<size_t>(entry.uncompressedSize);
+    } else if (entry.method == 8) {
+        if (entry.uncompressedSize > std::numeric_limits<size_t>::max()) return fail(error, "zip entry too large");
+        out.owned.resize(static_cast<size_t>(entry.uncompressedSize));
+        if (!inflateRaw(compressed, static_cast<size_t>(entry.compressedSize), out.owned.data(), out.owned.size())) {
+            return fail(error, "corrupt deflate stream");
+        }
+        out.bytes = out.owned.data();
+        out.length = out.owned.size();
+    } else {
+        return fail(error, "unsupported zip compression method");
+    }
+
+    if (computeCrc32(out.bytes, out.length) != entry.crc32) return fail(error, "zip entry CRC mismatch");
+    return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// zip 엔트리 (중앙 디렉터리 기준)
+struct ZipEntry {
+    std::string name;
+    uint16_t method = 0;            // 0 = 저장, 8 = deflate
+    uint32_t crc32 = 0;
+    uint64_t compressedSize = 0;
+    uint64_t uncompressedSize = 0;
+    uint64_t localHeaderOffset = 0;
+};
+
+// 엔트리 내용
+// 저장(무압축) 엔트리는 아카이브 버퍼를 그대로 가리키고, deflate 엔트리는 크기를 미리 알고 있으므로
+// 정확한 크기의 버퍼 하나에 바로 풀어 둔다 (재할당/복사 없음).
+class ZipEntryData {
+public:
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    const char* chars() const { return reinterpret_cast<const char*>(bytes); }
+
+private:
+    friend class ZipArchive;
+
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    std::vector<unsigned char> owned;
+};
+
+// 메모리에 있는 zip 아카이브 읽기 (mmap 한 파일, JS 에서 넘어온 바이트)
+// ZIP64 (4GB 초과 엔트리/아카이브) 을 지원한다. 버퍼는 ZipArchive 를 쓰는 동안 유효해야 한다.
+class ZipArchive {
+public:
+    bool open(const unsigned char* data, size_t size, std::string* error = nullptr);
+
+    const std::vector<ZipEntry>& entries() const { return entryList; }
+
+    // 이름으로 찾기 (OPC 파트 이름처럼 대소문자 구분 없음, 앞의 '/' 무시). 없으면 nullptr.
+    const ZipEntry* find(const std::string& name) const;
+
+    // 엔트리 내용을 읽는다 (deflate 는 풀고 CRC 를 검사). 여러 스레드에서 동시에 불러도 된다.
+    bool read(const ZipEntry& entry, ZipEntryData& out, std::string* error = nullptr) const;
+
+private:
+    const unsigned char* archive = nullptr;
+    size_t archiveSize = 0;
+    std::vector<ZipEntry> entryList;
+};
+
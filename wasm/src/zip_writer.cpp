@@ -0,0 +1,224 @@
+#include "zip_writer.h"
+
+#include "deflate.h"
+
+namespace {
+
+const uint32_t kLocalHeaderSignature = 0x04034b50;
+const uint32_t kDataDescriptorSignature = 0x08074b50;
+const uint32_t kCentralHeaderSignature = 0x02014b50;
+const uint32_t kEndOfCentralDirSignature = 0x06054b50;
+const uint32_t kZip64EndSignature = 0x06064b50;
+const uint32_t kZip64LocatorSignature = 0x07064b50;
+
+const uint16_t kFlagDataDescriptor = 0x0008;
+const uint16_t kFlagUtf8 = 0x0800;
+const uint16_t kVersionDefault = 20;
+const uint16_t kVersionZip64 = 45;
+const uint16_t kDosDate1980 = (0 << 9) | (1 << 5) | 1;  // 1980-01-01
+
+const uint32_t kMax32 = 0xFFFFFFFFu;
+
+void putUint16LE(std::vector<unsigned char>& out, uint16_t value) {
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void putUint32LE(std::vector<unsigned char>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+}
+
+void putUint64LE(std::vector<unsigned char>& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+}
+
+uint32_t clamp32(uint64_t value) {
+    return value >= kMax32 ? kMax32 : static_cast<uint32_t>(value);
+}
+
+} // namespace
+
+ZipWriter::ZipWriter(std::ostream& out, ThreadPool* pool) : out(out), pool(pool) {}
+
+ZipWriter::~ZipWriter() = default;
+
+bool ZipWriter::fail(const std::string& message) {
+    if (lastError.empty()) lastError = message;
+    return false;
+}
+
+bool ZipWriter::emit(const void* data, size_t size) {
+    if (size == 0) return true;
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) return fail("zip output write failed");
+    offset += size;
+    return true;
+}
+
+bool ZipWriter::writeLocalHeader(const Record& record) {
+    // 데이터 디스크립터를 쓰는 엔트리는 CRC/크기 자리를 0 으로 둔다
+    bool deferred = (record.flags & kFlagDataDescriptor) != 0;
+    std::vector<unsigned char> header;
+    header.reserve(30 + record.name.size());
+    putUint32LE(header, kLocalHeaderSignature);
+    putUint16LE(header, kVersionDefault);
+    putUint16LE(header, record.flags);
+    putUint16LE(header, record.method);
+    putUint16LE(header, 0);  // 시각
+    putUint16LE(header, kDosDate1980);
+    putUint32LE(header, deferred ? 0 : record.crc32);
+    putUint32LE(header, deferred ? 0 : static_cast<uint32_t>(record.compressedSize));
+    putUint32LE(header, deferred ? 0 : static_cast<uint32_t>(record.uncompressedSize));
+    putUint16LE(header, static_cast<uint16_t>(record.name.size()));
+    putUint16LE(header, 0);  // 확장 필드
+    header.insert(header.end(), record.name.begin(), record.name.end());
+    return emit(header.data(), header.size());
+}
+
+bool ZipWriter::addEntry(const std::string& name, const void* data, size_t size, int level) {
+    if (level > 0) {
+        return beginEntry(name, level) && write(data, size) && endEntry();
+    }
+
+    // 저장 엔트리는 CRC 와 크기를 미리 알 수 있으므로 로컬 헤더에 바로 쓴다
+    if (finished || entryOpen) return fail("zip writer is not accepting entries");
+    if (size >= kMax32) return addEntry(name, data, size, 1);
+    Record record;
+    record.name = name;
+    record.flags = kFlagUtf8;
+    record.crc32 = computeCrc32(static_cast<const unsigned char*>(data), size);
+    record.compressedSize = record.uncompressedSize = size;
+    record.localHeaderOffset = offset;
+    if (!writeLocalHeader(record) || !emit(data, size)) return false;
+    records.push_back(std::move(record));
+    return true;
+}
+
+bool ZipWriter::beginEntry(const std::string& name, int level) {
+    if (finished || entryOpen) return fail("zip writer is not accepting entries");
+    if (name.size() > 0xFFFF) return fail("zip entry name too long");
+
+    current = Record();
+    current.name = name;
+    current.method = 8;
+    current.flags = kFlagUtf8 | kFlagDataDescriptor;
+    current.localHeaderOffset = offset;
+
+    // 압축된 바이트는 청크가 끝날 때마다 바로 내보낸다
+    stream.reset(new DeflateStream(
+        [this](const unsigned char* data, size_t size) {
+            current.compressedSize += size;
+            return emit(data, size);
+        },
+        level < 1 ? 1 : (level > 9 ? 9 : level), pool));
+    entryOpen = true;
+    return writeLocalHeader(current);
+}
+
+bool ZipWriter::write(const void* data, size_t size) {
+    if (!entryOpen) return fail("no open zip entry");
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    current.crc32 = computeCrc32(p, size, current.crc32);
+    current.uncompressedSize += size;
+    return stream->write(p, size) || fail("deflate failed");
+}
+
+bool ZipWriter::endEntry() {
+    if (!entryOpen) return fail("no open zip entry");
+    entryOpen = false;
+    if (!stream->finish()) return fail("deflate failed");
+
+    // 4GB 를 넘으면 64비트 크기의 디스크립터 (중앙 디렉터리에도 ZIP64 로 기록)
+    bool zip64 = current.compressedSize >= kMax32 || current.uncompressedSize >= kMax32;
+    std::vector<unsigned char> descriptor;
+    putUint32LE(descriptor, kDataDescriptorSignature);
+    putUint32LE(descriptor, current.crc32);
+    if (zip64) {
+        putUint64LE(descriptor, current.compressedSize);
+        putUint64LE(descriptor, current.uncompressedSize);
+    } else {
+        putUint32LE(descriptor, static_cast<uint32_t>(current.compressedSize));
+        putUint32LE(descriptor, static_cast<uint32_t>(current.uncompressedSize));
+    }
+    if (!emit(descriptor.data(), descriptor.size())) return false;
+    records.push_back(std::move(current));
+    return true;
+}
+
+bool ZipWriter::finish() {
+    if (entryOpen && !endEntry()) return false;
+    if (finished) return fail("zip writer already finished");
+    finished = true;
+
+    uint64_t directoryOffset = offset;
+    std::vector<unsigned char> header;
+    for (const Record& record : records) {
+        bool zip64 = record.compressedSize >= kMax32 || record.uncompressedSize >= kMax32 ||
+                     record.localHeaderOffset >= kMax32;
+        std::vector<unsigned char> extra;
+        if (zip64) {
+            // 32비트 자리가 0xFFFFFFFF 인 값만 순서대로 넣는다 (여기서는 셋 다 넣고 셋 다 표시)
+            putUint16LE(extra, 0x0001);
+            putUint16LE(extra, 24);
+            putUint64LE(extra, record.uncompressedSize);
+            putUint64LE(extra, record.compressedSize);
+            putUint64LE(extra, record.localHeaderOffset);
+        }
+
+        header.clear();
+        putUint32LE(header, kCentralHeaderSignature);
+        putUint16LE(header, zip64 ? kVersionZip64 : kVersionDefault);  // 만든 버전 (MS-DOS)
+        putUint16LE(header, zip64 ? kVersionZip64 : kVersionDefault);
+        putUint16LE(header, record.flags);
+        putUint16LE(header, record.method);
+        putUint16LE(header, 0);
+        putUint16LE(header, kDosDate1980);
+        putUint32LE(header, record.crc32);
+        putUint32LE(header, zip64 ? kMax32 : static_cast<uint32_t>(record.compressedSize));
+        putUint32LE(header, zip64 ? kMax32 : static_cast<uint32_t>(record.uncompressedSize));
+        putUint16LE(header, static_cast<uint16_t>(record.name.size()));
+        putUint16LE(header, static_cast<uint16_t>(extra.size()));
+        putUint16LE(header, 0);  // 주석
+        putUint16LE(header, 0);  // 디스크 번호
+        putUint16LE(header, 0);  // 내부 속성
+        putUint32LE(header, 0);  // 외부 속성
+        putUint32LE(header, zip64 ? kMax32 : static_cast<uint32_t>(record.localHeaderOffset));
+        header.insert(header.end(), record.name.begin(), record.name.end());
+        header.insert(header.end(), extra.begin(), extra.end());
+        if (!emit(header.data(), header.size())) return false;
+    }
+    uint64_t directorySize = offset - directoryOffset;
+
+    header.clear();
+    bool zip64 = records.size() >= 0xFFFF || directoryOffset >= kMax32 || directorySize >= kMax32;
+    if (zip64) {
+        uint64_t zip64EndOffset = offset;
+        putUint32LE(header, kZip64EndSignature);
+        putUint64LE(header, 44);  // 이 레코드의 남은 크기
+        putUint16LE(header, kVersionZip64);
+        putUint16LE(header, kVersionZip64);
+        putUint32LE(header, 0);
+        putUint32LE(header, 0);
+        putUint64LE(header, records.size());
+        putUint64LE(header, records.size());
+        putUint64LE(header, directorySize);
+        putUint64LE(header, directoryOffset);
+
+        putUint32LE(header, kZip64LocatorSignature);
+        putUint32LE(header, 0);
+        putUint64LE(header, zip64EndOffset);
+        putUint32LE(header, 1);
+    }
+    uint16_t entryCount = records.size() >= 0xFFFF ? 0xFFFF : static_cast<uint16_t>(records.size());
+    putUint32LE(header, kEndOfCentralDirSignature);
+    putUint16LE(header, 0);
+    putUint16LE(header, 0);
+    putUint16LE(header, entryCount);
+    putUint16LE(header, entryCount);
+    putUint32LE(header, clamp32(directorySize));
+    putUint32LE(header, clamp32(directoryOffset));
+    putUint16LE(header, 0);
+    if (!emit(header.data(), header.size())) return false;
+    out.flush();
+    return static_cast<bool>(out) || fail("zip output write failed");
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class DeflateStream;
+class ThreadPool;
+
+// 순차 출력 스트림에 쓰는 zip 아카이브 (탐색 불가능한 출력도 됨: 파이프, JS 청크 콜백)
+// 엔트리는 크기와 CRC 를 미리 몰라도 되도록 데이터 디스크립터(플래그 비트 3) 로 쓰고,
+// 중앙 디렉터리만 메모리에 모아 finish() 에서 쓴다. 엔트리 내용 전체를 들고 있지 않으므로
+// 메모리는 엔트리 수와 deflate 입력 배치 크기에만 비례한다. 4GB 를 넘는 엔트리/오프셋은 ZIP64 로 기록한다.
+// 수정 시각은 항상 1980-01-01 로 써서 같은 입력이면 같은 바이트가 나온다.
+// pool 을 주면 큰 엔트리는 128KB 청크 단위로 병렬 압축한다 (출력은 스레드 수와 관계없이 같다).
+class ZipWriter {
+public:
+    explicit ZipWriter(std::ostream& out, ThreadPool* pool = nullptr);
+    ~ZipWriter();
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    // 내용을 한 번에 알고 있는 엔트리. level 0 = 저장 (PNG 처럼 이미 압축된 데이터), 1~9 = deflate
+    bool addEntry(const std::string& name, const void* data, size_t size, int level = 6);
+
+    // 스트리밍 엔트리: beginEntry() → write() 여러 번 → endEntry()
+    bool beginEntry(const std::string& name, int level = 6);
+    bool write(const void* data, size_t size);
+    bool endEntry();
+
+    // 중앙 디렉터리와 끝 레코드를 쓴다. 이후에는 엔트리를 추가할 수 없다.
+    bool finish();
+
+    const std::string& error() const { return lastError; }
+
+    // 지금까지 출력한 아카이브 바이트
+    uint64_t bytesWritten() const { return offset; }
+
+private:
+    struct Record {
+        std::string name;
+        uint16_t method = 0;
+        uint16_t flags = 0;
+        uint32_t crc32 = 0;
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+        uint64_t localHeaderOffset = 0;
+    };
+
+    bool writeLocalHeader(const Record& record);
+    bool emit(const void* data, size_t size);
+    bool fail(const std::string& message);
+
+    std::ostream& out;
+    ThreadPool* pool;
+    uint64_t offset = 0;
+    std::vector<Record> records;
+    std::string lastError;
+    bool finished = false;
+
+    // 열려 있는 스트리밍 엔트리
+    bool entryOpen = false;
+    Record current;
+    std::unique_ptr<DeflateStream> stream;
+};
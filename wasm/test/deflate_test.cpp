@@ -0,0 +1,167 @@
+// 자체 deflate/inflate 와 zlib 상호 검증 (.gcode.3mf, .bgcode 가 이 코덱에 의존한다)
+//
+//  - 자체 압축 -> zlib inflate, zlib 압축 (수준 0/1/6/9, 고정 허프만, RLE) -> 자체 inflate
+//  - 입력: 생성 메시를 자른 G-code, 빈 입력, 1바이트, 64KB 를 넘는 stored 블록 (무작위 바이트),
+//    같은 바이트 반복, 청크/배치 경계 (128KB +- 1, 512KB), DeflateStream 에 불규칙한 크기로 나눠 쓰기
+//  - CRC-32 는 zlib crc32 와 비교
+
+#include "deflate.h"
+#include "simple_slicer.h"
+#include "thread_pool.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Bytes = std::vector<unsigned char>;
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+        failures++;
+    }
+}
+
+Bytes zlibDeflate(const Bytes& input, int level, int strategy) {
+    z_stream stream = {};
+    deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, strategy);
+    Bytes out(deflateBound(&stream, static_cast<uLong>(input.size())) + 16);
+    stream.next_in = const_cast<Bytef*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    int status = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    check(status == Z_STREAM_END, "zlib deflate did not finish");
+    return out;
+}
+
+// 스트림 끝까지 정확히 풀렸는지 (남는 입력이나 출력이 없어야 한다)
+bool zlibInflate(const Bytes& compressed, const Bytes& expected) {
+    z_stream stream = {};
+    inflateInit2(&stream, -MAX_WBITS);
+    Bytes out(expected.size() + 1);
+    stream.next_in = const_cast<Bytef*>(compressed.data());
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    int status = inflate(&stream, Z_FINISH);
+    bool ok = status == Z_STREAM_END && stream.avail_in == 0 && stream.total_out == expected.size();
+    inflateEnd(&stream);
+    out.resize(expected.size());
+    return ok && out == expected;
+}
+
+bool ourInflate(const Bytes& compressed, const Bytes& expected) {
+    Bytes out(expected.size());
+    return inflateRaw(compressed.data(), compressed.size(), out.data(), out.size()) && out == expected;
+}
+
+// DeflateStream 에 1, 7, 4093, 65536, ... 바이트씩 나눠 쓴다
+Bytes streamDeflate(const Bytes& input, int level, ThreadPool* pool) {
+    Bytes out;
+    DeflateStream stream([&out](const unsigned char* data, size_t size) {
+        out.insert(out.end(), data, data + size);
+        return true;
+    }, level, pool);
+    const size_t pieces[] = {1, 7, 4093, 65536, 200000};
+    size_t pos = 0;
+    for (size_t i = 0; pos < input.size(); i++) {
+        size_t size = std::min(pieces[i % 5], input.size() - pos);
+        check(stream.write(input.data() + pos, size), "DeflateStream::write failed");
+        pos += size;
+    }
+    check(stream.finish(), "DeflateStream::finish failed");
+    check(stream.bytesIn() == input.size() && stream.bytesOut() == out.size(), "DeflateStream byte counters");
+    return out;
+}
+
+void roundTrip(const std::string& name, const Bytes& input, ThreadPool& pool) {
+    for (int level : {1, 6, 9}) {
+        std::string tag = name + " level " + std::to_string(level);
+        Bytes ours = deflateRaw(input.data(), input.size(), level);
+        check(zlibInflate(ours, input), tag + ": ours -> zlib inflate");
+        check(ourInflate(ours, input), tag + ": ours -> our inflate");
+
+        // 청크 병렬 압축은 스레드 수와 관계없이 같은 바이트
+        check(deflateRaw(input.data(), input.size(), level, &pool) == ours, tag + ": parallel output differs");
+        check(streamDeflate(input, level, &pool) == ours, tag + ": DeflateStream output differs");
+    }
+
+    const int strategies[][2] = {
+        {0, Z_DEFAULT_STRATEGY}, {1, Z_DEFAULT_STRATEGY}, {6, Z_DEFAULT_STRATEGY},
+        {9, Z_DEFAULT_STRATEGY}, {6, Z_FIXED},            {6, Z_RLE},
+    };
+    for (const auto& s : strategies) {
+        Bytes theirs = zlibDeflate(input, s[0], s[1]);
+        check(ourInflate(theirs, input),
+              name + ": zlib level " + std::to_string(s[0]) + " strategy " + std::to_string(s[1]) + " -> our inflate");
+    }
+
+    uLong zlibCrc = crc32(0L, input.data(), static_cast<uInt>(input.size()));
+    check(computeCrc32(input.data(), input.size()) == zlibCrc, name + ": crc32 differs from zlib");
+}
+
+Bytes generatedGCode() {
+    SimpleSlicer slicer;
+    slicer.loadTestMesh("gyroid", 50000, 1, 1.0, 3.0);
+    std::ostringstream gcode;
+    slicer.writeGCode(gcode);
+    std::string text = gcode.str();
+    return Bytes(text.begin(), text.end());
+}
+
+Bytes randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    Bytes out(size);
+    for (unsigned char& b : out) b = static_cast<unsigned char>(rng());
+    return out;
+}
+
+} // namespace
+
+int main() {
+    ThreadPool pool(4);
+
+    Bytes gcode = generatedGCode();
+    check(gcode.size() > 4 * kDeflateChunkSize, "generated G-code is too small to span several chunks");
+
+    roundTrip("gcode", gcode, pool);
+    roundTrip("empty", Bytes(), pool);
+    roundTrip("one byte", Bytes(1, 'G'), pool);
+    roundTrip("random 300KB (stored blocks > 64KB)", randomBytes(300000, 1), pool);
+    roundTrip("repeated byte 200KB", Bytes(200000, 'x'), pool);
+    // 청크 경계와 풀 배치 (4 청크) 경계에서 끝나는 입력
+    for (size_t size : {kDeflateChunkSize - 1, kDeflateChunkSize, kDeflateChunkSize + 1, 4 * kDeflateChunkSize}) {
+        Bytes input(gcode.begin(), gcode.begin() + size);
+        roundTrip("gcode " + std::to_string(size) + " bytes", input, pool);
+    }
+
+    // 압축할 수 없는 입력은 stored 블록으로: 블록 (심볼 16383 개) 과 청크 경계마다 5바이트 헤더만큼만 커진다
+    Bytes random = randomBytes(300000, 2);
+    Bytes stored = deflateRaw(random.data(), random.size());
+    size_t headers = random.size() / 16383 + 1 + random.size() / kDeflateChunkSize + 1;
+    check(stored.size() <= random.size() + headers * 5, "incompressible input grew more than stored block headers");
+
+    // 잘리거나 크기가 맞지 않는 스트림은 거부
+    Bytes compressed = deflateRaw(gcode.data(), gcode.size());
+    Bytes out(gcode.size());
+    check(!inflateRaw(compressed.data(), compressed.size() / 2, out.data(), out.size()), "truncated stream accepted");
+    check(!inflateRaw(compressed.data(), compressed.size(), out.data(), out.size() - 1), "short output accepted");
+    out.resize(gcode.size() + 1);
+    check(!inflateRaw(compressed.data(), compressed.size(), out.data(), out.size()), "long output accepted");
+
+    if (failures > 0) return 1;
+    std::printf("deflate round trips passed (gcode %zu bytes -> %zu)\n", gcode.size(), compressed.size());
+    return 0;
+}
@@ -0,0 +1,75 @@
+// 대용량 메시 끝까지 슬라이스 (절차적 구 메시 -> slice -> G-code)
+//
+//   large_mesh_test [삼각형 수]     (기본 20M)
+//
+// Emscripten 빌드에서는 slicer-large 와 같은 4GB 힙으로 만들어 Node 에서 실행한다 (ctest).
+// 브라우저의 sliceTestMesh 와 같은 경로 (SimpleSlicer::loadTestMesh) 를 탄다.
+
+#include "simple_slicer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace {
+
+// 출력 바이트 수만 센다 (G-code 전체를 힙에 두지 않는다)
+class CountingStreamBuf : public std::streambuf {
+public:
+    size_t count = 0;
+
+protected:
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof()) count++;
+        return c;
+    }
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        count += static_cast<size_t>(n);
+        return n;
+    }
+};
+
+int fail(const char* message) {
+    std::fprintf(stderr, "FAIL: %s\n", message);
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double triangles = argc > 1 ? std::atof(argv[1]) : 20e6;
+
+    SimpleSlicer slicer;
+    slicer.setLayerHeight(0.2);
+    slicer.setInfillDensity(20.0);
+    if (!slicer.loadTestMesh("sphere", triangles, 1, 1.0, 1.0)) return fail("loadTestMesh failed");
+
+    const Mesh& mesh = slicer.getMesh();
+    if (static_cast<double>(mesh.triangleCount()) < triangles * 0.9) return fail("mesh is smaller than requested");
+
+    CountingStreamBuf counter;
+    std::ostream out(&counter);
+    slicer.writeGCode(out);
+    if (!slicer.sliceError().empty()) return fail(slicer.sliceError().c_str());
+
+    // 지름 40mm 구: 0.2mm 레이어로 201 장, 위아래 끝을 뺀 모든 레이어에 윤곽선이 있어야 한다
+    const LayerStore& layers = slicer.getLayers();
+    std::vector<double> bbox = slicer.getBoundingBox();
+    size_t expectedLayers = static_cast<size_t>(std::floor((bbox[5] - bbox[2]) / 0.2 + 1e-9)) + 1;
+    if (layers.layerCount() + 1 < expectedLayers || layers.layerCount() > expectedLayers + 1) {
+        return fail("unexpected layer count");
+    }
+    for (size_t i = 1; i + 1 < layers.layerCount(); i++) {
+        if (layers.layer(i).contourCount() == 0) return fail("empty layer inside the mesh");
+    }
+    if (counter.count == 0) return fail("no G-code written");
+
+    SlicerStats stats = slicer.getStats();
+    std::printf("triangles=%zu vertices=%zu meshBytes=%.0f layers=%zu gcodeBytes=%zu heapPeak=%.0f\n",
+                mesh.triangleCount(), mesh.vertexCount(), stats.meshBytes, layers.layerCount(), counter.count,
+                stats.heapPeakBytes);
+    return 0;
+}
@@ -0,0 +1,72 @@
+// 자동 방향 찾기: 면으로 설 수 있는 모델은 면이 바닥에 닿는 자세가 먼저 와야 한다
+//
+//  - 정육면체, 넓은 판: 1순위가 축 방향 (면이 바닥) 이고, 판은 넓은 면이 바닥
+//  - 멩거 스펀지: 모서리로 선 자세 (접촉 0) 가 아니라 면이 바닥인 자세가 상위 후보에 있다
+
+#include "orient.h"
+#include "simple_slicer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+        failures++;
+    }
+}
+
+// 축에 맞춘 상자 (바깥 법선 방향으로 감은 삼각형 12 개)
+Mesh box(double sx, double sy, double sz) {
+    Mesh mesh;
+    for (int i = 0; i < 8; i++) mesh.addVertex(i & 1 ? sx : 0, i & 2 ? sy : 0, i & 4 ? sz : 0);
+    const MeshIndex faces[12][3] = {{0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6}, {0, 1, 4}, {1, 5, 4},
+                                    {2, 6, 3}, {3, 6, 7}, {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}};
+    for (const auto& f : faces) mesh.addTriangle(f[0], f[1], f[2]);
+    return mesh;
+}
+
+bool faceDown(const OrientCandidate& c) {
+    return std::fabs(c.downX) > 0.999 || std::fabs(c.downY) > 0.999 || std::fabs(c.downZ) > 0.999;
+}
+
+std::string describe(const OrientCandidate& c) {
+    char text[128];
+    std::snprintf(text, sizeof(text), "down=(%.2f %.2f %.2f) contact=%.1f", c.downX, c.downY, c.downZ,
+                  c.contactArea);
+    return text;
+}
+
+} // namespace
+
+int main() {
+    OrientOptions options;
+
+    std::vector<OrientCandidate> cube = findOrientations(box(20, 20, 20), options);
+    check(!cube.empty() && faceDown(cube[0]) && cube[0].contactArea > 0,
+          "cube: best pose must stand on a face, got " + (cube.empty() ? std::string("none") : describe(cube[0])));
+
+    std::vector<OrientCandidate> plate = findOrientations(box(60, 40, 3), options);
+    check(!plate.empty() && std::fabs(plate[0].downZ) > 0.999,
+          "plate: best pose must lie on its large face, got " +
+              (plate.empty() ? std::string("none") : describe(plate[0])));
+
+    SimpleSlicer slicer;
+    slicer.loadTestMesh("menger", 50000, 1, 1.0, 1.0);
+    std::vector<OrientCandidate> menger = findOrientations(slicer.getMesh(), options);
+    bool anyFace = false;
+    for (const OrientCandidate& c : menger) {
+        anyFace = anyFace || faceDown(c);
+        check(c.contactArea >= options.minContactArea, "menger: candidate without floor contact " + describe(c));
+    }
+    check(anyFace, "menger: top candidates must include a face-down pose");
+
+    if (failures > 0) return 1;
+    std::printf("orient passed (menger best %s)\n", describe(menger[0]).c_str());
+    return 0;
+}
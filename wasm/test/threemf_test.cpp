@@ -0,0 +1,94 @@
+// 3MF 컴포넌트 펼치기: 정상 파일, 공유 컴포넌트 (다이아몬드), 순환 참조, 인스턴스 폭탄
+//
+// 폭탄은 객체 31 개가 각각 바로 앞 객체를 컴포넌트 두 개로 가리키는 파일 (2^30 인스턴스).
+// load3MF 가 중단(bad_alloc) 없이 false 와 오류를 돌려줘야 한다.
+
+#include "threemf_reader.h"
+#include "zip_writer.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+        failures++;
+    }
+}
+
+// 삼각형 하나짜리 객체 1 + resources 뒤에 붙일 객체들 + build 항목
+std::vector<unsigned char> package(const std::string& objects, const std::string& items) {
+    std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<model unit=\"millimeter\" xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+                      " <resources>\n"
+                      "  <object id=\"1\" type=\"model\"><mesh><vertices>"
+                      "<vertex x=\"0\" y=\"0\" z=\"0\"/><vertex x=\"1\" y=\"0\" z=\"0\"/><vertex x=\"0\" y=\"1\" z=\"1\"/>"
+                      "</vertices><triangles><triangle v1=\"0\" v2=\"1\" v3=\"2\"/></triangles></mesh></object>\n" +
+                      objects + " </resources>\n <build>" + items + "</build>\n</model>\n";
+    std::ostringstream out;
+    ZipWriter zip(out);
+    zip.addEntry("3D/3dmodel.model", xml.data(), xml.size());
+    zip.finish();
+    std::string bytes = out.str();
+    return std::vector<unsigned char>(bytes.begin(), bytes.end());
+}
+
+std::string object(int id, const std::vector<int>& components) {
+    std::string xml = "  <object id=\"" + std::to_string(id) + "\" type=\"model\"><components>";
+    for (int component : components) {
+        xml += "<component objectid=\"" + std::to_string(component) + "\" transform=\"1 0 0 0 1 0 0 0 1 " +
+               std::to_string(component) + " 0 0\"/>";
+    }
+    return xml + "</components></object>\n";
+}
+
+std::string item(int id) { return "<item objectid=\"" + std::to_string(id) + "\"/>"; }
+
+// 읽어서 삼각형 수 확인
+void expectTriangles(const std::vector<unsigned char>& bytes, size_t triangles, const std::string& what) {
+    Mesh mesh;
+    std::string error;
+    bool ok = load3MF(bytes.data(), bytes.size(), mesh, &error);
+    check(ok && mesh.triangleCount() == triangles, what + ": " + error);
+}
+
+// 중단 없이 false 와, needle 을 포함하는 오류를 돌려줘야 한다
+std::string expectFailure(const std::vector<unsigned char>& bytes, const std::string& needle, const std::string& what) {
+    Mesh mesh;
+    std::string error;
+    bool ok = load3MF(bytes.data(), bytes.size(), mesh, &error);
+    check(!ok && error.find(needle) != std::string::npos, what + " must fail with \"" + needle + "\", got: " + error);
+    check(mesh.empty(), what + " must leave the mesh empty");
+    return error;
+}
+
+} // namespace
+
+int main() {
+    // 객체 2 가 객체 1 을 두 번 배치
+    expectTriangles(package(object(2, {1, 1}), item(2)), 2, "two components of one mesh");
+
+    // 다이아몬드: 4 -> {2, 3}, 2 -> 1, 3 -> 1 (같은 객체를 두 경로로 쓰는 것은 순환이 아니다)
+    expectTriangles(package(object(2, {1}) + object(3, {1}) + object(4, {2, 3}), item(4)), 2,
+                    "shared component (diamond)");
+
+    // 순환 참조: 2 -> 3 -> 2, 자기 자신 참조
+    expectFailure(package(object(2, {3}) + object(3, {2}), item(2)), "cycle", "component cycle");
+    expectFailure(package(object(2, {1, 2}), item(2)), "cycle", "self reference");
+
+    // 인스턴스 폭탄: 객체 k 가 객체 k-1 을 두 번 (깊이 30, 2^30 인스턴스)
+    std::string bomb;
+    for (int id = 2; id <= 31; id++) bomb += object(id, {id - 1, id - 1});
+    std::vector<unsigned char> bombFile = package(bomb, item(31));
+    std::string error = expectFailure(bombFile, "too many", "component bomb");
+
+    if (failures > 0) return 1;
+    std::printf("3MF component expansion passed (bomb %zu bytes: %s)\n", bombFile.size(), error.c_str());
+    return 0;
+}